@@ -16,8 +16,20 @@
 ****************************************************************************/
 /*============================ INCLUDES ======================================*/
 #include "platform/platform.h"
+#include "platform/frame_trace.h"
+#include "platform/pfb_tuner.h"
+#include "platform/asset_stream.h"
+#include "platform/glyph_cache.h"
+#include "platform/scene_arena.h"
+#include "platform/scratch_workspace.h"
+#include "platform/slab_pool.h"
+#include "platform/mem_watermark.h"
+#include "platform/idle_sleep.h"
+#include "platform/timer_wheel.h"
+#include "platform/playlist.h"
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include "arm_2d.h"
 #include "arm_2d_helper.h"
@@ -41,163 +53,240 @@ void SysTick_Handler(void)
 
 void scene_progress_status_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(false);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_progress_status_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_progress_status_init(&DISP0_ADAPTER));
 }
 
 void scene_rickrolling_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(false);
-    epd_screen_set_dither_mode(true);
-
-    arm_2d_scene_rickrolling_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_rickrolling_init(&DISP0_ADAPTER));
 }
 
 void scene_qrcode_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(false);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_qrcode_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_qrcode_init(&DISP0_ADAPTER));
 }
 
 void scene_text_reader_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(false);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_text_reader_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_text_reader_init(&DISP0_ADAPTER));
 }
 
 void scene_mono_loading_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(true);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_mono_loading_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_mono_loading_init(&DISP0_ADAPTER));
 }
 
 void scene_mono_histogram_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(true);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_mono_histogram_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_mono_histogram_init(&DISP0_ADAPTER));
 }
 
 void scene_mono_clock_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(true);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_mono_clock_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_mono_clock_init(&DISP0_ADAPTER));
 }
 
 void scene_mono_list_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(true);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_mono_list_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_mono_list_init(&DISP0_ADAPTER));
 }
 
 void scene_mono_tracking_list_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(true);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_mono_tracking_list_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_mono_tracking_list_init(&DISP0_ADAPTER));
 }
 
 void scene_mono_icon_menu_loader(void) 
 {
-    epd_screen_set_invert_colour_mode(true);
-    epd_screen_set_dither_mode(false);
-
-    arm_2d_scene_mono_icon_menu_init(&DISP0_ADAPTER);
+    frame_trace_hook_scene(arm_2d_scene_mono_icon_menu_init(&DISP0_ADAPTER));
 }
 
-typedef struct demo_scene_t {
-    int32_t nLastInMS;
-    void (*fnLoader)(void);
-} demo_scene_t;
+/* indexed by playlist_scene_id_t */
+static void (*const c_fnSceneLoaders[__PLAYLIST_SCENE_COUNT])(void) = {
+    [PLAYLIST_SCENE_MONO_LOADING]       = &scene_mono_loading_loader,
+    [PLAYLIST_SCENE_QRCODE]             = &scene_qrcode_loader,
+    [PLAYLIST_SCENE_MONO_CLOCK]         = &scene_mono_clock_loader,
+    [PLAYLIST_SCENE_MONO_HISTOGRAM]     = &scene_mono_histogram_loader,
+    [PLAYLIST_SCENE_PROGRESS_STATUS]    = &scene_progress_status_loader,
+    [PLAYLIST_SCENE_MONO_LIST]          = &scene_mono_list_loader,
+    [PLAYLIST_SCENE_MONO_TRACKING_LIST] = &scene_mono_tracking_list_loader,
+    [PLAYLIST_SCENE_MONO_ICON_MENU]     = &scene_mono_icon_menu_loader,
+    [PLAYLIST_SCENE_TEXT_READER]        = &scene_text_reader_loader,
+    [PLAYLIST_SCENE_RICKROLLING]        = &scene_rickrolling_loader,
+};
 
-static demo_scene_t const c_SceneLoaders[] = {
+/* used when there is no valid playlist blob in the flash */
+static playlist_entry_t const c_tBuiltinPlaylist[] = {
 
 #if 1
     {
-        15000,
-        scene_mono_loading_loader,
+        .nLastInMS = 15000,
+        .chSceneID = PLAYLIST_SCENE_MONO_LOADING,
+        .bInvertColour = true,
     },
     {
-        5000,
-        scene_qrcode_loader,
+        .nLastInMS = 5000,
+        .chSceneID = PLAYLIST_SCENE_QRCODE,
     },
     {
-        10000,
-        scene_mono_clock_loader,
+        .nLastInMS = 10000,
+        .chSceneID = PLAYLIST_SCENE_MONO_CLOCK,
+        .bInvertColour = true,
     },
     {
-        10000,
-        scene_mono_histogram_loader,
+        .nLastInMS = 10000,
+        .chSceneID = PLAYLIST_SCENE_MONO_HISTOGRAM,
+        .bInvertColour = true,
     },
     {
-        8000,
-        scene_progress_status_loader,
+        .nLastInMS = 8000,
+        .chSceneID = PLAYLIST_SCENE_PROGRESS_STATUS,
     },
     {
-        15000,
-        scene_mono_list_loader,
+        .nLastInMS = 15000,
+        .chSceneID = PLAYLIST_SCENE_MONO_LIST,
+        .bInvertColour = true,
     },
     {
-        15000,
-        scene_mono_tracking_list_loader,
+        .nLastInMS = 15000,
+        .chSceneID = PLAYLIST_SCENE_MONO_TRACKING_LIST,
+        .bInvertColour = true,
     },
     {
-        15000,
-        scene_mono_icon_menu_loader,
+        .nLastInMS = 15000,
+        .chSceneID = PLAYLIST_SCENE_MONO_ICON_MENU,
+        .bInvertColour = true,
     },
     {
-        30000,
-        scene_text_reader_loader,
+        .nLastInMS = 30000,
+        .chSceneID = PLAYLIST_SCENE_TEXT_READER,
     },
     {
-        20000,
-        scene_rickrolling_loader,
+        .nLastInMS = 20000,
+        .chSceneID = PLAYLIST_SCENE_RICKROLLING,
+        .bDither = true,
     },
     
 
 #else
     {
-        .fnLoader = 
-        scene_rickrolling_loader,
-        //scene_qrcode_loader,
-        //scene_mono_clock_loader
+        .chSceneID = 
+        PLAYLIST_SCENE_RICKROLLING,
+        //PLAYLIST_SCENE_QRCODE,
+        //PLAYLIST_SCENE_MONO_CLOCK,
+        .bDither = true,
     },
 #endif
 
 };
 
+static playlist_t s_tPlaylist = {
+    .ptEntries = c_tBuiltinPlaylist,
+    .hwCount = dimof(c_tBuiltinPlaylist),
+};
+
 static
 struct {
     int8_t chIndex;
-    bool bIsTimeout;
-    int32_t nDelay;
-    int64_t lTimeStamp;
-    
+    int8_t chPreloaded;
+    bool bPreloadRequested;
+    timer_wheel_timer_t tTimeout;
+    timer_wheel_timer_t tPreload;
 } s_tDemoCTRL = {
     .chIndex = -1,
-    .bIsTimeout = true,
+    .chPreloaded = -1,
 };
 
+static void __on_scene_timeout(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    ARM_2D_UNUSED(pTarget);
+    ARM_2D_UNUSED(ptTimer);
+
+    arm_2d_scene_player_switch_to_next_scene(&DISP0_ADAPTER);
+}
+
+/* pass the parameter of an entry to the scene and call the loader */
+static void __load_scene(const playlist_entry_t *ptEntry)
+{
+    switch (ptEntry->chSceneID) {
+        case PLAYLIST_SCENE_QRCODE:
+            arm_2d_scene_qrcode_set_payload((const char *)ptEntry->pParam,
+                                            ptEntry->hwParamSize);
+            break;
+        case PLAYLIST_SCENE_TEXT_READER:
+            arm_2d_scene_text_reader_set_text(  (const char *)ptEntry->pParam,
+                                                ptEntry->hwParamSize);
+            break;
+        default:
+            break;
+    }
+
+    c_fnSceneLoaders[ptEntry->chSceneID]();
+}
+
+#if __PLATFORM_CFG_USE_SCENE_PRELOAD__
+static void __on_scene_preload(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    ARM_2D_UNUSED(pTarget);
+    ARM_2D_UNUSED(ptTimer);
+
+    /* the loader is called by the main loop after the current frame */
+    s_tDemoCTRL.bPreloadRequested = true;
+}
+
+/* construct the next scene and append it to the scene player */
+static void __preload_next_scene(void)
+{
+    s_tDemoCTRL.bPreloadRequested = false;
+
+    if (s_tDemoCTRL.chPreloaded >= 0) {
+        return ;
+    }
+
+    int8_t chNext = (s_tDemoCTRL.chIndex + 1) % s_tPlaylist.hwCount;
+
+    /* two instances of a scene share the static data of the scene, e.g. the
+     * dirty regions and the films, so the next one is loaded after the switch
+     */
+    if (    s_tPlaylist.ptEntries[chNext].chSceneID 
+        ==  s_tPlaylist.ptEntries[s_tDemoCTRL.chIndex].chSceneID) {
+        return ;
+    }
+
+    /* the scratch memory of the next scene comes from the other arena, the
+     * current scene keeps its own until the switching
+     */
+    scene_arena_open_next();
+    __load_scene(&s_tPlaylist.ptEntries[chNext]);
+    scene_arena_close_next();
+
+    s_tDemoCTRL.chPreloaded = chNext;
+}
+#endif
+
 /* load scene one by one */
 void before_scene_switching_handler(void *pTarget,
                                     arm_2d_scene_player_t *ptPlayer,
                                     arm_2d_scene_t *ptScene)
 {
 
+    if (s_tDemoCTRL.chIndex >= 0) {
+        /* report where the time of the previous scene went */
+        frame_probe_dump_scene(s_tPlaylist.ptEntries[s_tDemoCTRL.chIndex].chSceneID);
+        asset_stream_dump_info();
+        glyph_cache_dump_info();
+        scene_arena_dump_info(SCENE_ARENA_CURRENT);
+        scratch_workspace_dump_info();
+        scratch_workspace_trim();
+        slab_pool_dump_info();
+        mem_watermark_dump_scene();
+        idle_sleep_dump_info();
+
+    #if __PLATFORM_CFG_FRAME_TRACE_DUMP_ON_SWITCH__
+        frame_trace_dump();
+    #endif
+    }
+
     switch (arm_2d_scene_player_get_switching_status(&DISP0_ADAPTER)) {
         case ARM_2D_SCENE_SWITCH_STATUS_MANUAL_CANCEL:
             s_tDemoCTRL.chIndex--;
@@ -207,44 +296,112 @@ void before_scene_switching_handler(void *pTarget,
             break;
     }
 
-    if (s_tDemoCTRL.chIndex >= dimof(c_SceneLoaders)) {
+    if (s_tDemoCTRL.chIndex >= s_tPlaylist.hwCount) {
         s_tDemoCTRL.chIndex = 0;
     } else if (s_tDemoCTRL.chIndex < 0) {
-        s_tDemoCTRL.chIndex += dimof(c_SceneLoaders);
+        s_tDemoCTRL.chIndex += s_tPlaylist.hwCount;
     }
 
-    /* call loader */
-    arm_with(const demo_scene_t, &c_SceneLoaders[s_tDemoCTRL.chIndex]) {
+    /* the profiles follow the scene, not its position in the playlist */
+    frame_probe_set_scene(s_tPlaylist.ptEntries[s_tDemoCTRL.chIndex].chSceneID);
+    pfb_tuner_set_scene(s_tPlaylist.ptEntries[s_tDemoCTRL.chIndex].chSceneID);
+
+    int64_t lSwitchStart = get_system_ticks();
+    bool bPreloaded = (s_tDemoCTRL.chPreloaded == s_tDemoCTRL.chIndex);
+
+    /* a preloaded scene is already in the scene player, i.e. the scene
+     * player only swaps the scenes. The preloading assumes the playlist moves
+     * forward, there is no manual cancelling in this demo.
+     */
+    assert(bPreloaded || s_tDemoCTRL.chPreloaded < 0);
+    s_tDemoCTRL.chPreloaded = -1;
+    s_tDemoCTRL.bPreloadRequested = false;
+
+    arm_with(const playlist_entry_t, &s_tPlaylist.ptEntries[s_tDemoCTRL.chIndex]) {
+        epd_screen_set_invert_colour_mode(_->bInvertColour);
+        epd_screen_set_dither_mode(_->bDither);
+
+        if (!bPreloaded) {
+            /* the scratch memory of the new scene comes from the other arena */
+            scene_arena_open_next();
+
+            /* call loader */
+            __load_scene(_);
+
+            scene_arena_close_next();
+        }
+
+        /* the new scene owns its arena from now on */
+        scene_arena_switch_to_next();
+
         if (_->nLastInMS > 0) {
-            s_tDemoCTRL.bIsTimeout = false;
-            s_tDemoCTRL.lTimeStamp = 0;
-            s_tDemoCTRL.nDelay = _->nLastInMS;
+            system_timer_start( &s_tDemoCTRL.tTimeout, 
+                                _->nLastInMS, 
+                                0, 
+                                &__on_scene_timeout, 
+                                NULL);
+        #if __PLATFORM_CFG_USE_SCENE_PRELOAD__
+            system_timer_start( &s_tDemoCTRL.tPreload, 
+                                MAX(_->nLastInMS - __PLATFORM_CFG_SCENE_PRELOAD_LEAD__, 0), 
+                                0, 
+                                &__on_scene_preload, 
+                                NULL);
+        #endif
+        } else {
+            system_timer_stop(&s_tDemoCTRL.tTimeout);
+            system_timer_stop(&s_tDemoCTRL.tPreload);
         }
-        _->fnLoader();
     }
+
+    printf( "[playlist] scene %d switched in %"PRIu32"us%s\r\n",
+            (int)s_tDemoCTRL.chIndex,
+            (uint32_t)perfc_convert_ticks_to_us(get_system_ticks() - lSwitchStart),
+            bPreloaded ? " (preloaded)" : "");
 }
 
 
+void __disp_adapter0_user_on_frame_complete(void *ptTarget, 
+                                            bool bIsFrameSkipped)
+{
+    ARM_2D_UNUSED(ptTarget);
+
+    if (bIsFrameSkipped) {
+        return ;
+    }
+
+    /* the time spent outside the low level rendering is the scene drawing */
+    arm_with(arm_2d_helper_pfb_t, &DISP0_ADAPTER.use_as__arm_2d_helper_pfb_t) {
+        frame_probe_on_frame_complete(  _->Statistics.nTotalCycle 
+                                    -   _->Statistics.nRenderingCycle);
+        pfb_tuner_on_frame_complete(_->Statistics.nTotalCycle);
+    }
+
+    mem_watermark_on_frame_complete();
+}
+
 static bool __lcd_sync_handler(void *pTarget)
 {
+    /* a page rendered offscreen does not touch the panel */
+    if (epd_offscreen_is_active()) {
+        return true;
+    }
+
+    /* sleep instead of polling while the panel is refreshing */
+    idle_sleep_wait_for_busy();
+
     return !epd_screen_is_busy();
 }
 
 
-static void system_init(void)
+/* the settings of the PFB helper, they are applied again when the PFB tuner
+ * initialises the helper with another PFB size
+ */
+static void __pfb_helper_setup(void)
 {
-    platform_init();
-
-    arm_2d_init();
-    disp_adapter0_init();
-    
     arm_2d_helper_full_frame_refresh_mode(
                                     &DISP0_ADAPTER.use_as__arm_2d_helper_pfb_t, 
                                     true);
 
-    arm_2d_scene_player_register_before_switching_event_handler(
-            &DISP0_ADAPTER,
-            before_scene_switching_handler);
     /* register a low level sync-up handler to wait LCD finish rendering the previous frame */
     do {
         arm_2d_helper_pfb_dependency_t tDependency = {
@@ -256,7 +413,24 @@ static void system_init(void)
                                             ARM_2D_PFB_DEPEND_ON_LOW_LEVEL_SYNC_UP,
                                             &tDependency);
     } while(0);
+}
+
+static void system_init(void)
+{
+    platform_init();
+
+    /* use the playlist blob in the flash if there is a valid one */
+    playlist_load_from_flash(&s_tPlaylist);
 
+    arm_2d_init();
+    disp_adapter0_init();
+    pfb_tuner_init();
+    
+    __pfb_helper_setup();
+
+    arm_2d_scene_player_register_before_switching_event_handler(
+            &DISP0_ADAPTER,
+            before_scene_switching_handler);
 }
 
 
@@ -278,19 +452,29 @@ int main(void)
     while (true) {
 
         arm_fsm_rt_t tResult = disp_adapter0_task(0);
-        if (arm_fsm_rt_cpl == tResult) {
-            epd_flush();
-        }
 
-        if (!s_tDemoCTRL.bIsTimeout) {
+        /* expire the timers, e.g. the timeout of the current scene */
+        int64_t lNextDeadline = system_timer_task();
 
-            if (arm_2d_helper_is_time_out(s_tDemoCTRL.nDelay, &s_tDemoCTRL.lTimeStamp)) {
-                s_tDemoCTRL.bIsTimeout = true;
+        if (arm_fsm_rt_cpl == tResult) {
+            epd_flush_if_changed();
 
-                arm_2d_scene_player_switch_to_next_scene(&DISP0_ADAPTER);
+            /* a new PFB size is applied between two frames */
+            if (pfb_tuner_task()) {
+                __pfb_helper_setup();
             }
-        }
 
+        #if __PLATFORM_CFG_USE_SCENE_PRELOAD__
+            /* the panel is refreshing, construct the next scene meanwhile */
+            if (s_tDemoCTRL.bPreloadRequested) {
+                __preload_next_scene();
+            }
+        #endif
+
+            /* wake up in time for the next timer */
+            idle_sleep_set_deadline(lNextDeadline);
+            idle_sleep_wait();
+        }
     }
     //return 0;
 }
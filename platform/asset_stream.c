@@ -0,0 +1,360 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./asset_stream.h"
+#include "./dma_2dcopy.h"
+
+#if __PLATFORM_CFG_USE_ASSET_STREAM__
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "hardware/regs/addressmap.h"
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+#define ASSET_STREAM_BLOCK_SIZE     __PLATFORM_CFG_ASSET_STREAM_BLOCK_SIZE__
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if __PLATFORM_CFG_USE_DMA_2D_COPY__
+#   define __asset_stream_fill_start(__DES, __SRC, __SIZE)                      \
+            dma_2dcopy_start((__DES), (__SIZE), (__SRC), (__SIZE), (__SIZE), 1)
+#   define __asset_stream_fill_is_busy()     dma_2dcopy_is_busy()
+#else
+#   define __asset_stream_fill_start(__DES, __SRC, __SIZE)                      \
+            memcpy((__DES), (__SRC), (__SIZE))
+#   define __asset_stream_fill_is_busy()     false
+#endif
+
+/*============================ TYPES =========================================*/
+
+typedef struct __asset_stream_t {
+    const uint8_t *pchSource;                   //!< NULL means a free stream
+    size_t tSize;
+    size_t tPosition;
+
+    struct {
+        size_t tOffset;
+        size_t tLength;                         //!< 0 means an empty block
+    } tBlocks[2];
+
+    uint8_t chCurrent;
+    bool bReadAhead;                            //!< the other block is being filled
+
+    uint8_t chBuffer[2][ASSET_STREAM_BLOCK_SIZE] __ALIGNED(4);
+} __asset_stream_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+PLATFORM_IN_DMA_BANK
+static
+struct {
+    asset_stream_info_t tInfo;
+
+    __asset_stream_t tStreams[__PLATFORM_CFG_ASSET_STREAM_COUNT__];
+} s_tAssetStream;
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+/*!
+ * \brief redirect XIP addresses to the alias which neither checks nor 
+ *        allocates the XIP cache
+ */
+static const uint8_t *__asset_stream_get_source(const uint8_t *pchSource)
+{
+    uintptr_t wAddress = (uintptr_t)pchSource;
+
+    if ((wAddress & 0xFF000000) == XIP_BASE) {
+        wAddress = (wAddress - XIP_BASE) + XIP_NOCACHE_NOALLOC_BASE;
+    }
+
+    return (const uint8_t *)wAddress;
+}
+
+static void __asset_stream_wait(void)
+{
+    int64_t lStart = get_system_ticks();
+
+    while(__asset_stream_fill_is_busy()) {
+        __NOP();
+    }
+
+    s_tAssetStream.tInfo.lStallCycles += get_system_ticks() - lStart;
+}
+
+static void __asset_stream_fill_block(  __asset_stream_t *ptThis, 
+                                        uint_fast8_t chBlock, 
+                                        size_t tOffset)
+{
+    size_t tLength = MIN(ASSET_STREAM_BLOCK_SIZE, ptThis->tSize - tOffset);
+
+    ptThis->tBlocks[chBlock].tOffset = tOffset;
+    ptThis->tBlocks[chBlock].tLength = tLength;
+
+    __asset_stream_fill_start(  ptThis->chBuffer[chBlock], 
+                                ptThis->pchSource + tOffset, 
+                                tLength);
+}
+
+static void __asset_stream_read_ahead(__asset_stream_t *ptThis)
+{
+    uint_fast8_t chCurrent = ptThis->chCurrent;
+    size_t tNext = ptThis->tBlocks[chCurrent].tOffset + ASSET_STREAM_BLOCK_SIZE;
+
+    if (ptThis->bReadAhead || tNext >= ptThis->tSize) {
+        return ;
+    }
+
+    uint_fast8_t chOther = chCurrent ^ 1;
+    if (    ptThis->tBlocks[chOther].tLength > 0
+        &&  ptThis->tBlocks[chOther].tOffset == tNext) {
+        /* already there */
+        return ;
+    }
+
+    /* the engine might be shared with others, never queue behind them */
+    if (__asset_stream_fill_is_busy()) {
+        return ;
+    }
+
+    __asset_stream_fill_block(ptThis, chOther, tNext);
+    ptThis->bReadAhead = true;
+}
+
+/*!
+ * \brief find the block holding the current position, fill it on demand
+ * \return the index of the block
+ */
+static uint_fast8_t __asset_stream_get_block(__asset_stream_t *ptThis)
+{
+    size_t tPosition = ptThis->tPosition;
+
+    for (uint_fast8_t n = 0; n < 2; n++) {
+        uint_fast8_t chBlock = ptThis->chCurrent ^ n;
+
+        if (    tPosition < ptThis->tBlocks[chBlock].tOffset
+            ||  tPosition >= (  ptThis->tBlocks[chBlock].tOffset 
+                            +   ptThis->tBlocks[chBlock].tLength)) {
+            continue;
+        }
+
+        if (chBlock != ptThis->chCurrent && ptThis->bReadAhead) {
+            if (__asset_stream_fill_is_busy()) {
+                s_tAssetStream.tInfo.wStalls++;
+                __asset_stream_wait();
+            } else {
+                s_tAssetStream.tInfo.wHits++;
+            }
+            ptThis->bReadAhead = false;
+        } else {
+            s_tAssetStream.tInfo.wHits++;
+        }
+
+        return chBlock;
+    }
+
+    /* random access: fill the current block synchronously */
+    s_tAssetStream.tInfo.wMisses++;
+    if (ptThis->bReadAhead) {
+        __asset_stream_wait();
+        ptThis->bReadAhead = false;
+    }
+
+    uint_fast8_t chBlock = ptThis->chCurrent;
+    __asset_stream_fill_block(  ptThis, 
+                                chBlock, 
+                                (tPosition / ASSET_STREAM_BLOCK_SIZE) 
+                            *   ASSET_STREAM_BLOCK_SIZE);
+    __asset_stream_wait();
+
+    return chBlock;
+}
+
+void *asset_stream_open(const void *pSource, size_t tSize)
+{
+    assert(NULL != pSource);
+
+    __asset_stream_t *ptThis = NULL;
+
+    arm_foreach(__asset_stream_t, s_tAssetStream.tStreams, ptItem) {
+        if (NULL == ptItem->pchSource) {
+            ptThis = ptItem;
+            break;
+        }
+    }
+
+    if (NULL == ptThis) {
+        return NULL;
+    }
+
+    memset(ptThis, 0, offsetof(__asset_stream_t, chBuffer));
+    ptThis->pchSource = __asset_stream_get_source((const uint8_t *)pSource);
+    ptThis->tSize = tSize;
+
+    return ptThis;
+}
+
+void asset_stream_close(void *ptStream)
+{
+    __asset_stream_t *ptThis = (__asset_stream_t *)ptStream;
+    if (NULL == ptThis) {
+        return ;
+    }
+
+    if (ptThis->bReadAhead) {
+        __asset_stream_wait();
+    }
+    ptThis->pchSource = NULL;
+}
+
+bool asset_stream_seek(void *ptStream, int32_t nOffset, int32_t nWhence)
+{
+    __asset_stream_t *ptThis = (__asset_stream_t *)ptStream;
+    assert(NULL != ptThis);
+
+    int64_t lPosition = nOffset;
+    switch (nWhence) {
+        case SEEK_CUR:
+            lPosition += ptThis->tPosition;
+            break;
+        case SEEK_END:
+            lPosition += ptThis->tSize;
+            break;
+        case SEEK_SET:
+        default:
+            break;
+    }
+
+    if (lPosition < 0 || lPosition > (int64_t)ptThis->tSize) {
+        return false;
+    }
+
+    ptThis->tPosition = (size_t)lPosition;
+    return true;
+}
+
+size_t asset_stream_read(void *ptStream, uint8_t *pchBuffer, size_t tSize)
+{
+    __asset_stream_t *ptThis = (__asset_stream_t *)ptStream;
+    assert(NULL != ptThis);
+
+    tSize = MIN(tSize, ptThis->tSize - ptThis->tPosition);
+    size_t tRead = 0;
+
+    while(tRead < tSize) {
+        uint_fast8_t chBlock = __asset_stream_get_block(ptThis);
+        ptThis->chCurrent = chBlock;
+
+        size_t tIndex = ptThis->tPosition - ptThis->tBlocks[chBlock].tOffset;
+        size_t tLength = MIN(   tSize - tRead, 
+                                ptThis->tBlocks[chBlock].tLength - tIndex);
+
+        /* TJpgDec skips data by reading into a NULL buffer */
+        if (NULL != pchBuffer) {
+            memcpy(pchBuffer + tRead, &ptThis->chBuffer[chBlock][tIndex], tLength);
+        }
+
+        tRead += tLength;
+        ptThis->tPosition += tLength;
+
+        __asset_stream_read_ahead(ptThis);
+    }
+
+    return tRead;
+}
+
+void asset_stream_get_info(asset_stream_info_t *ptInfo)
+{
+    assert(NULL != ptInfo);
+    *ptInfo = s_tAssetStream.tInfo;
+}
+
+void asset_stream_dump_info(void)
+{
+    asset_stream_info_t *ptInfo = &s_tAssetStream.tInfo;
+
+    if (0 == (ptInfo->wHits + ptInfo->wStalls + ptInfo->wMisses)) {
+        return ;
+    }
+
+    printf( "Asset Stream: hit %"PRIu32" stall %"PRIu32" miss %"PRIu32
+            " wait %"PRIu32"us\r\n",
+            ptInfo->wHits,
+            ptInfo->wStalls,
+            ptInfo->wMisses,
+            (uint32_t)perfc_convert_ticks_to_us(ptInfo->lStallCycles));
+
+    memset(ptInfo, 0, sizeof(asset_stream_info_t));
+}
+
+/*----------------------------------------------------------------------------*
+ * TJpgDec Loader IO                                                          *
+ *----------------------------------------------------------------------------*/
+
+#if defined(RTE_Acceleration_Arm_2D_Extra_TJpgDec_Loader)
+
+static bool __asset_stream_tjpgd_open(uintptr_t pTarget, arm_tjpgd_loader_t *ptLoader)
+{
+    ARM_2D_UNUSED(ptLoader);
+
+    return asset_stream_seek((void *)pTarget, 0, SEEK_SET);
+}
+
+static void __asset_stream_tjpgd_close(uintptr_t pTarget, arm_tjpgd_loader_t *ptLoader)
+{
+    ARM_2D_UNUSED(pTarget);
+    ARM_2D_UNUSED(ptLoader);
+
+    /* the stream is owned by the scene */
+}
+
+static bool __asset_stream_tjpgd_seek(  uintptr_t pTarget, 
+                                        arm_tjpgd_loader_t *ptLoader, 
+                                        int32_t offset, 
+                                        int32_t whence)
+{
+    ARM_2D_UNUSED(ptLoader);
+
+    return asset_stream_seek((void *)pTarget, offset, whence);
+}
+
+static size_t __asset_stream_tjpgd_read(uintptr_t pTarget, 
+                                        arm_tjpgd_loader_t *ptLoader, 
+                                        uint8_t *pchBuffer, 
+                                        size_t tSize)
+{
+    ARM_2D_UNUSED(ptLoader);
+
+    return asset_stream_read((void *)pTarget, pchBuffer, tSize);
+}
+
+const arm_tjpgd_loader_io_t ASSET_STREAM_TJPGD_IO = {
+    .fnOpen =   &__asset_stream_tjpgd_open,
+    .fnClose =  &__asset_stream_tjpgd_close,
+    .fnSeek =   &__asset_stream_tjpgd_seek,
+    .fnRead =   &__asset_stream_tjpgd_read,
+};
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_ASSET_STREAM_H__
+#define __BADGER_RP2040_ASSET_STREAM_H__
+
+/*============================ INCLUDES ======================================*/
+
+#if defined(_RTE_)
+#   include "RTE_Components.h"
+#endif
+
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(RTE_Acceleration_Arm_2D_Extra_TJpgDec_Loader)
+#   include "arm_2d_example_loaders.h"
+#endif
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_ASSET_STREAM__
+#   define asset_stream_dump_info()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the statistics of all asset streams
+ */
+typedef struct asset_stream_info_t {
+    uint32_t wHits;             //!< reads served from a ready block
+    uint32_t wStalls;           //!< reads waiting for an on-going read-ahead
+    uint32_t wMisses;           //!< reads waiting for a synchronous block fill
+    int64_t lStallCycles;       //!< the cycles spent on waiting
+} asset_stream_info_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+
+#if __PLATFORM_CFG_USE_ASSET_STREAM__                                           \
+ && defined(RTE_Acceleration_Arm_2D_Extra_TJpgDec_Loader)
+/*!
+ * \brief the TJpgDec loader IO for asset streams, the pTarget is the handle 
+ *        returned by asset_stream_open()
+ */
+extern const arm_tjpgd_loader_io_t ASSET_STREAM_TJPGD_IO;
+#endif
+
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_ASSET_STREAM__
+
+/*!
+ * \brief open a stream for an asset in memory, e.g. in the XIP flash
+ * \param[in] pSource the address of the asset
+ * \param[in] tSize the size of the asset in bytes
+ * \return void* the stream handle, NULL means no free stream is available
+ */
+extern
+void *asset_stream_open(const void *pSource, size_t tSize);
+
+/*!
+ * \brief close a stream
+ * \param[in] ptStream the stream handle
+ */
+extern
+void asset_stream_close(void *ptStream);
+
+/*!
+ * \brief move the read position of a stream
+ * \param[in] ptStream the stream handle
+ * \param[in] nOffset the offset
+ * \param[in] nWhence SEEK_SET, SEEK_CUR or SEEK_END
+ * \retval true the read position is updated
+ * \retval false the new position is out of range
+ */
+extern
+bool asset_stream_seek(void *ptStream, int32_t nOffset, int32_t nWhence);
+
+/*!
+ * \brief read data from a stream
+ * \param[in] ptStream the stream handle
+ * \param[in] pchBuffer the target buffer
+ * \param[in] tSize the number of bytes to read
+ * \return size_t the number of bytes read
+ */
+extern
+size_t asset_stream_read(void *ptStream, uint8_t *pchBuffer, size_t tSize);
+
+/*!
+ * \brief get the statistics of all asset streams
+ * \param[out] ptInfo the statistics
+ */
+extern
+void asset_stream_get_info(asset_stream_info_t *ptInfo);
+
+/*!
+ * \brief print the statistics over stdio and clear them
+ */
+extern
+void asset_stream_dump_info(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
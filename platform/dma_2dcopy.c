@@ -0,0 +1,331 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./dma_2dcopy.h"
+
+#if __PLATFORM_CFG_USE_DMA_2D_COPY__
+
+#include <string.h>
+
+#if !__PLATFORM_CFG_DMA_2D_COPY_USE_MEMCPY__
+#   include "hardware/dma.h"
+#endif
+
+#include "arm_2d.h"
+#include "arm_2d_helper.h"
+#include "arm_2d_disp_adapters.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief a control block written to the alias 1 registers of the data channel, 
+ *        i.e. CTRL, READ_ADDR, WRITE_ADDR and TRANS_COUNT_TRIG
+ */
+typedef struct __dma_2dcopy_block_t {
+    uint32_t wCtrl;
+    const void *pSrc;
+    void *pDes;
+    uint32_t wCount;
+} __dma_2dcopy_block_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+#if !__PLATFORM_CFG_DMA_2D_COPY_USE_MEMCPY__
+PLATFORM_IN_DMA_BANK
+static
+struct {
+    bool bInitialized;
+    int8_t chData;
+    int8_t chControl;
+
+    /* one extra null block to stop the chain */
+    __dma_2dcopy_block_t tBlocks[__PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__ + 1] 
+        __ALIGNED(16);
+} s_tDMA2DCopy;
+#endif
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_DMA_2D_COPY_USE_MEMCPY__
+
+void dma_2dcopy_init(void)
+{
+}
+
+void dma_2dcopy_start(  void *pDes, 
+                        int32_t nDesStride,
+                        const void *pSrc,
+                        int32_t nSrcStride,
+                        uint32_t wBytesPerRow,
+                        uint16_t hwRows)
+{
+    uint8_t *pchDes = (uint8_t *)pDes;
+    const uint8_t *pchSrc = (const uint8_t *)pSrc;
+
+    if (nDesStride == (int32_t)wBytesPerRow && nSrcStride == (int32_t)wBytesPerRow) {
+        memcpy(pchDes, pchSrc, wBytesPerRow * hwRows);
+        return ;
+    }
+
+    while(hwRows--) {
+        memcpy(pchDes, pchSrc, wBytesPerRow);
+        pchDes += nDesStride;
+        pchSrc += nSrcStride;
+    }
+}
+
+bool dma_2dcopy_is_busy(void)
+{
+    return false;
+}
+
+void dma_2dcopy_wait(void)
+{
+}
+
+#else
+
+void dma_2dcopy_init(void)
+{
+    s_tDMA2DCopy.chData = (int8_t)dma_claim_unused_channel(true);
+    s_tDMA2DCopy.chControl = (int8_t)dma_claim_unused_channel(true);
+    s_tDMA2DCopy.bInitialized = true;
+
+    /* the control channel writes one control block into the alias 1 
+     * registers of the data channel, the last write triggers the data channel
+     */
+    dma_channel_config tConfig 
+        = dma_channel_get_default_config(s_tDMA2DCopy.chControl);
+    channel_config_set_transfer_data_size(&tConfig, DMA_SIZE_32);
+    channel_config_set_read_increment(&tConfig, true);
+    channel_config_set_write_increment(&tConfig, true);
+    channel_config_set_ring(&tConfig, true, 4);     /* 16 bytes write ring */
+
+    dma_channel_configure(  s_tDMA2DCopy.chControl,
+                            &tConfig,
+                            &dma_hw->ch[s_tDMA2DCopy.chData].al1_ctrl,
+                            s_tDMA2DCopy.tBlocks,
+                            4,
+                            false);
+}
+
+bool dma_2dcopy_is_busy(void)
+{
+    return dma_channel_is_busy(s_tDMA2DCopy.chControl)
+        || dma_channel_is_busy(s_tDMA2DCopy.chData);
+}
+
+void dma_2dcopy_wait(void)
+{
+    while(dma_2dcopy_is_busy()) {
+        __NOP();
+    }
+}
+
+static uint32_t __dma_2dcopy_get_ctrl(enum dma_channel_transfer_size tSize)
+{
+    dma_channel_config tConfig = dma_channel_get_default_config(s_tDMA2DCopy.chData);
+    channel_config_set_transfer_data_size(&tConfig, tSize);
+    channel_config_set_read_increment(&tConfig, true);
+    channel_config_set_write_increment(&tConfig, true);
+    /* hand over to the control channel for the next block */
+    channel_config_set_chain_to(&tConfig, s_tDMA2DCopy.chControl);
+
+    return channel_config_get_ctrl_value(&tConfig);
+}
+
+void dma_2dcopy_start(  void *pDes, 
+                        int32_t nDesStride,
+                        const void *pSrc,
+                        int32_t nSrcStride,
+                        uint32_t wBytesPerRow,
+                        uint16_t hwRows)
+{
+    assert(s_tDMA2DCopy.bInitialized);
+
+    if (0 == wBytesPerRow || 0 == hwRows) {
+        return ;
+    }
+
+    dma_2dcopy_wait();
+
+    uint8_t *pchDes = (uint8_t *)pDes;
+    const uint8_t *pchSrc = (const uint8_t *)pSrc;
+
+    /* use word transfers whenever the alignment allows */
+    enum dma_channel_transfer_size tSize = DMA_SIZE_8;
+    if (0 == ((  (uintptr_t)pchDes | (uintptr_t)pchSrc | wBytesPerRow 
+            |   (uint32_t)nDesStride | (uint32_t)nSrcStride) & 0x03)) {
+        tSize = DMA_SIZE_32;
+    }
+    uint32_t wCtrl = __dma_2dcopy_get_ctrl(tSize);
+
+    if (nDesStride == (int32_t)wBytesPerRow && nSrcStride == (int32_t)wBytesPerRow) {
+        /* contiguous region: a single transfer is enough */
+        s_tDMA2DCopy.tBlocks[0] = (__dma_2dcopy_block_t) {
+            .wCtrl = wCtrl,
+            .pSrc = pchSrc,
+            .pDes = pchDes,
+            .wCount = (wBytesPerRow * hwRows) >> tSize,
+        };
+        hwRows = 1;
+    } else {
+        while (hwRows > __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__) {
+            /* copy the extra rows first in a blocking way */
+            dma_2dcopy( pchDes, 
+                        nDesStride, 
+                        pchSrc, 
+                        nSrcStride, 
+                        wBytesPerRow, 
+                        __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__);
+
+            pchDes += nDesStride * __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__;
+            pchSrc += nSrcStride * __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__;
+            hwRows -= __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__;
+        }
+
+        for (uint_fast16_t n = 0; n < hwRows; n++) {
+            s_tDMA2DCopy.tBlocks[n] = (__dma_2dcopy_block_t) {
+                .wCtrl = wCtrl,
+                .pSrc = pchSrc,
+                .pDes = pchDes,
+                .wCount = wBytesPerRow >> tSize,
+            };
+            pchDes += nDesStride;
+            pchSrc += nSrcStride;
+        }
+    }
+
+    /* a null trigger stops the chain */
+    memset(&s_tDMA2DCopy.tBlocks[hwRows], 0, sizeof(__dma_2dcopy_block_t));
+
+    dma_channel_set_read_addr(s_tDMA2DCopy.chControl, s_tDMA2DCopy.tBlocks, true);
+}
+
+#endif
+
+void dma_2dcopy(void *pDes, 
+                int32_t nDesStride,
+                const void *pSrc,
+                int32_t nSrcStride,
+                uint32_t wBytesPerRow,
+                uint16_t hwRows)
+{
+    dma_2dcopy_start(pDes, nDesStride, pSrc, nSrcStride, wBytesPerRow, hwRows);
+    dma_2dcopy_wait();
+}
+
+/*----------------------------------------------------------------------------*
+ * Virtual Resource Helper                                                    *
+ *----------------------------------------------------------------------------*/
+
+#if __DISP0_CFG_VIRTUAL_RESOURCE_HELPER__
+
+#if __PLATFORM_CFG_DMA_2D_COPY_PREFETCH_SIZE__ > 0
+PLATFORM_IN_DMA_BANK
+static
+struct {
+    const uint8_t *pchSrc;
+    int32_t nSrcStride;
+    uint32_t wBytesPerRow;
+    uint16_t hwRows;
+
+    uint8_t chBuffer[__PLATFORM_CFG_DMA_2D_COPY_PREFETCH_SIZE__] __ALIGNED(4);
+} s_tVRESPrefetch;
+#endif
+
+/*!
+ * \brief copy an asset region with the DMA. The assets are expected to be 
+ *        memory mapped, e.g. in the XIP flash.
+ * \note it overrides the weak implementation in the display adapter
+ */
+void __disp_adapter0_vres_asset_2dcopy( uintptr_t pObj,
+                                        arm_2d_vres_t *ptVRES,
+                                        arm_2d_region_t *ptRegion,
+                                        uintptr_t pSrc,
+                                        uintptr_t pDes,
+                                        int16_t iTargetStride,
+                                        int16_t iSourceStride,
+                                        int16_t iPixelSize)
+{
+    ARM_2D_UNUSED(pObj);
+    assert(NULL != ptRegion);
+    assert(NULL != ptVRES);
+
+    const uint8_t *pchSrc = (const uint8_t *)pSrc 
+                          + (   ptRegion->tLocation.iY * iSourceStride 
+                            +   ptRegion->tLocation.iX) * iPixelSize;
+    int32_t nSrcStride = iSourceStride * iPixelSize;
+    int32_t nDesStride = iTargetStride * iPixelSize;
+    uint32_t wBytesPerRow = ptRegion->tSize.iWidth * iPixelSize;
+    uint16_t hwRows = ptRegion->tSize.iHeight;
+
+#if __PLATFORM_CFG_DMA_2D_COPY_PREFETCH_SIZE__ > 0
+    if (    s_tVRESPrefetch.pchSrc == pchSrc
+        &&  s_tVRESPrefetch.nSrcStride == nSrcStride
+        &&  s_tVRESPrefetch.wBytesPerRow == wBytesPerRow
+        &&  s_tVRESPrefetch.hwRows == hwRows) {
+
+        /* the region has been prefetched while the previous band was drawn */
+        dma_2dcopy_wait();
+        dma_2dcopy( (void *)pDes, 
+                    nDesStride, 
+                    s_tVRESPrefetch.chBuffer, 
+                    wBytesPerRow, 
+                    wBytesPerRow, 
+                    hwRows);
+    } else {
+        dma_2dcopy((void *)pDes, nDesStride, pchSrc, nSrcStride, wBytesPerRow, hwRows);
+    }
+
+    s_tVRESPrefetch.pchSrc = NULL;
+
+    /* prefetch the same columns for the next band */
+    do {
+        int16_t iNextY = ptRegion->tLocation.iY + ptRegion->tSize.iHeight;
+        int16_t iRows = MIN(ptRegion->tSize.iHeight, 
+                            ptVRES->tTile.tRegion.tSize.iHeight - iNextY);
+
+        if (    iRows <= 0
+            ||  wBytesPerRow * iRows > sizeof(s_tVRESPrefetch.chBuffer)) {
+            break;
+        }
+
+        s_tVRESPrefetch.pchSrc = pchSrc + nSrcStride * ptRegion->tSize.iHeight;
+        s_tVRESPrefetch.nSrcStride = nSrcStride;
+        s_tVRESPrefetch.wBytesPerRow = wBytesPerRow;
+        s_tVRESPrefetch.hwRows = iRows;
+
+        dma_2dcopy_start(   s_tVRESPrefetch.chBuffer,
+                            wBytesPerRow,
+                            s_tVRESPrefetch.pchSrc,
+                            nSrcStride,
+                            wBytesPerRow,
+                            iRows);
+    } while(0);
+#else
+    dma_2dcopy((void *)pDes, nDesStride, pchSrc, nSrcStride, wBytesPerRow, hwRows);
+#endif
+}
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_DMA_2DCOPY_H__
+#define __BADGER_RP2040_DMA_2DCOPY_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_DMA_2D_COPY__
+#   define dma_2dcopy_init()
+#endif
+
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_DMA_2D_COPY__
+
+/*!
+ * \brief claim the DMA channels used by the 2D copy engine
+ */
+extern
+void dma_2dcopy_init(void);
+
+/*!
+ * \brief start copying a 2D region in the background
+ * \note when the number of rows exceeds __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__,
+ *       the extra rows are copied before this function returns
+ * \param[in] pDes the target address
+ * \param[in] nDesStride the distance between two target rows in bytes
+ * \param[in] pSrc the source address
+ * \param[in] nSrcStride the distance between two source rows in bytes
+ * \param[in] wBytesPerRow the number of bytes to copy in each row
+ * \param[in] hwRows the number of rows
+ */
+extern
+void dma_2dcopy_start(  void *pDes, 
+                        int32_t nDesStride,
+                        const void *pSrc,
+                        int32_t nSrcStride,
+                        uint32_t wBytesPerRow,
+                        uint16_t hwRows);
+
+/*!
+ * \brief check whether a background copy is still on-going
+ */
+extern
+bool dma_2dcopy_is_busy(void);
+
+/*!
+ * \brief wait until the background copy completes
+ */
+extern
+void dma_2dcopy_wait(void);
+
+/*!
+ * \brief copy a 2D region and wait for the completion
+ */
+extern
+void dma_2dcopy(void *pDes, 
+                int32_t nDesStride,
+                const void *pSrc,
+                int32_t nSrcStride,
+                uint32_t wBytesPerRow,
+                uint16_t hwRows);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
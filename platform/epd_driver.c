@@ -16,9 +16,13 @@
 ****************************************************************************/
 /*============================ INCLUDES ======================================*/
 #include "./platform.h"
+#include "./frame_trace.h"
+#include "./idle_sleep.h"
 
 #include "hardware/spi.h"
 
+#include <string.h>
+
 #include "arm_2d.h"
 #include "arm_2d_helper.h"
 #include "arm_2d_disp_adapters.h"
@@ -39,6 +43,17 @@
 #ifndef SPI_PORT
 #   define SPI_PORT    spi0
 #endif
+
+/* the size of a whole screen in 1bpp, i.e. an offscreen page */
+#define EPD_PAGE_BYTES_PER_ROW      (EPD_SCREEN_WIDTH >> 3)
+#define EPD_PAGE_SIZE               (EPD_PAGE_BYTES_PER_ROW * EPD_SCREEN_HEIGHT)
+
+/* the size of the buffer used to pack a PFB into 1bpp before the SPI burst */
+#ifndef EPD_BAND_BUFFER_SIZE
+#   define EPD_BAND_BUFFER_SIZE                                                 \
+            (   __DISP0_CFG_PFB_BLOCK_WIDTH__                                   \
+            *   ((__DISP0_CFG_PFB_BLOCK_HEIGHT__ + 7) >> 3))
+#endif
 /*============================ MACROFIED FUNCTIONS ===========================*/
 
 #define SEND_LUT(__CMD, __LUT)                                                  \
@@ -121,11 +136,55 @@ enum {
 
 };
 
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+typedef struct __epd_band_hash_t {
+    int16_t iX;
+    int16_t iY;
+    int16_t iWidth;
+    int16_t iHeight;
+    uint32_t wHash;
+} __epd_band_hash_t;
+
+typedef struct __epd_band_table_t {
+    uint8_t chNext;
+    __epd_band_hash_t tBands[__PLATFORM_CFG_RENDER_SKIP_BAND_COUNT__];
+} __epd_band_table_t;
+#endif
+
 /*============================ GLOBAL VARIABLES ==============================*/
 /*============================ LOCAL VARIABLES ===============================*/
 static volatile bool s_bInvertColor = false;
 static volatile bool s_bEnableDither = true;
 
+PLATFORM_IN_DMA_BANK
+static uint8_t s_chBandBuffer[EPD_BAND_BUFFER_SIZE] __ALIGNED(4);
+
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+static
+struct {
+    bool bFrameChanged;
+    uint32_t wSkippedBands;
+    uint32_t wSkippedFrames;
+
+    __epd_band_table_t tTable;                  //!< what the panel shows
+} s_tRenderSkip;
+#endif
+
+#if __PLATFORM_CFG_USE_EPD_OFFSCREEN__
+static
+struct {
+    uint8_t *pchPage;                           //!< NULL means inactive
+    uint32_t wCoveredPixels;                    //!< the pixels rendered into the page
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    __epd_band_table_t tTable;                  //!< what the page contains
+#endif
+} s_tOffscreen;
+#endif
+
+#if __PLATFORM_CFG_USE_FRAME_PROBE__ || __PLATFORM_CFG_USE_FRAME_TRACE__
+static volatile int64_t s_lRefreshStart = 0;
+#endif
+
 static const uint8_t c_chDitherTable[16][4][4] = {
     [0] = {0},
     [1] = { {0, 0, 0, 0},
@@ -277,10 +336,31 @@ void epd_read_busy(void)
     } while(!(gpio_get(EPD_BUSY_PIN) & 0x01));
 }
 
+#if __PLATFORM_CFG_USE_IDLE_SLEEP__
+static void __epd_on_busy_released(uint nGPIO, uint32_t wEvents)
+{
+    ARM_2D_UNUSED(nGPIO);
+    ARM_2D_UNUSED(wEvents);
+
+    idle_sleep_notify_busy_released();
+}
+#endif
+
 bool epd_screen_is_busy(void)
 {
     epd_send_cmd(GET_STATUS);
-    return !(gpio_get(EPD_BUSY_PIN) & 0x01);
+    bool bIsBusy = !(gpio_get(EPD_BUSY_PIN) & 0x01);
+
+#if __PLATFORM_CFG_USE_FRAME_PROBE__ || __PLATFORM_CFG_USE_FRAME_TRACE__
+    if (!bIsBusy && 0 != s_lRefreshStart) {
+        frame_probe_report( FRAME_PROBE_STAGE_BUSY, 
+                            get_system_ticks() - s_lRefreshStart);
+        frame_trace_end(FRAME_TRACE_EVT_PANEL_BUSY, 0);
+        s_lRefreshStart = 0;
+    }
+#endif
+
+    return bIsBusy;
 }
 
 void epd_screen_init(void)
@@ -306,6 +386,14 @@ void epd_screen_init(void)
         gpio_init(EPD_BUSY_PIN);
         gpio_set_dir(EPD_BUSY_PIN, GPIO_IN);
 
+    #if __PLATFORM_CFG_USE_IDLE_SLEEP__
+        /* the release of BUSY wakes up the main loop */
+        gpio_set_irq_enabled_with_callback( EPD_BUSY_PIN, 
+                                            GPIO_IRQ_EDGE_RISE, 
+                                            true,
+                                            &__epd_on_busy_released);
+    #endif
+
         spi_init((spi_inst_t *)SPI_PORT, EPD_SPI_FREQ);
         gpio_set_function(EPD_CLK_PIN, GPIO_FUNC_SPI);
         gpio_set_function(EPD_MOSI_PIN, GPIO_FUNC_SPI);
@@ -476,6 +564,11 @@ void epd_sceen_clear(void)
         }
     }
 
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    /* the panel content is no longer what the hashes describe */
+    memset(&s_tRenderSkip.tTable, 0, sizeof(s_tRenderSkip.tTable));
+#endif
+
     epd_set_full_refresh_mode();
     epd_flush();
     while(epd_screen_is_busy()) __NOP();
@@ -484,20 +577,25 @@ void epd_sceen_clear(void)
 static
 void epd_screen_set_window(int16_t iX, int16_t iY, int16_t iWidth, int16_t iHeight)
 {
-    epd_set_partial_refresh_mode();
-    epd_send_cmd(PARTIAL_IN);                   //This command makes the display enter partial mode
-    
-    int16_t iYEnd = iY + iHeight - 1;
-
-    epd_send_cmd_with_data(PARTIAL_WINDOW, {
-        iX,
-        iX + iWidth - 1,
-        iY >> 8,
-        iY & 0xFF,
-        iYEnd,
-        iYEnd & 0xFF,
-        0x28,
-    });
+    frame_probe_stage(FRAME_PROBE_STAGE_LUT) {
+        epd_set_partial_refresh_mode();
+    }
+
+    frame_probe_stage(FRAME_PROBE_STAGE_WINDOW) {
+        epd_send_cmd(PARTIAL_IN);               //This command makes the display enter partial mode
+        
+        int16_t iYEnd = iY + iHeight - 1;
+
+        epd_send_cmd_with_data(PARTIAL_WINDOW, {
+            iX,
+            iX + iWidth - 1,
+            iY >> 8,
+            iY & 0xFF,
+            iYEnd,
+            iYEnd & 0xFF,
+            0x28,
+        });
+    }
 
 }
 
@@ -510,18 +608,323 @@ uint8_t __epd_dither(uint8_t chGray8, int16_t iX, int16_t iY)
     return c_chDitherTable[chGray8 >> 4][iY][iX];
 }
 
-void EPD_DrawBitmap(int16_t iX, int16_t iY, int16_t iWidth, int16_t iHeight, const uint8_t *pchBuffer)
+static
+void __platform_time_critical_func(__epd_pack_rows_with_dither)(
+                                    uint8_t *pchOutput,
+                                    const uint8_t *pchBuffer,
+                                    int16_t iWidth,
+                                    int16_t iRowStart,
+                                    int16_t iRowCount,
+                                    int16_t iRotatedWidth,
+                                    uint8_t chInvertMask)
+{
+    for (int16_t i = iRowStart; i < iRowStart + iRowCount; i++) {
+
+        for (int16_t j = 0; j < iRotatedWidth;) {
+            uint8_t chData = 0;
+
+            const uint8_t *pchBlock = &pchBuffer[iWidth - i - 1 + j * iWidth];
+
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= __epd_dither(*pchBlock, j++, i);
+            pchBlock += iWidth;
+
+            *pchOutput++ = chData ^ chInvertMask;
+        }
+    }
+}
+
+static
+void __platform_time_critical_func(__epd_pack_rows)(
+                        uint8_t *pchOutput,
+                        const uint8_t *pchBuffer,
+                        int16_t iWidth,
+                        int16_t iRowStart,
+                        int16_t iRowCount,
+                        int16_t iRotatedWidth,
+                        uint8_t chInvertMask)
+{
+    for (int16_t i = iRowStart; i < iRowStart + iRowCount; i++) {
+
+        for (int16_t j = 0; j < iRotatedWidth; j+= 8) {
+            uint8_t chData = 0;
+
+            const uint8_t *pchBlock = &pchBuffer[iWidth - i - 1 + j * iWidth];
+
+            chData |=  *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+            chData <<= 1;
+            
+            chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
+            pchBlock += iWidth;
+
+            *pchOutput++ = chData ^ chInvertMask;
+        }
+    }
+}
+
+static
+void __epd_pack_band(   const uint8_t *pchBuffer,
+                        int16_t iWidth,
+                        int16_t iRowStart,
+                        int16_t iRowCount,
+                        int16_t iRotatedWidth,
+                        uint8_t chInvertMask,
+                        bool bEnableDither)
+{
+    frame_probe_stage(FRAME_PROBE_STAGE_PACK) {
+        if (bEnableDither) {
+            __epd_pack_rows_with_dither(s_chBandBuffer,
+                                        pchBuffer,
+                                        iWidth,
+                                        iRowStart,
+                                        iRowCount,
+                                        iRotatedWidth,
+                                        chInvertMask);
+        } else {
+            __epd_pack_rows(s_chBandBuffer,
+                            pchBuffer,
+                            iWidth,
+                            iRowStart,
+                            iRowCount,
+                            iRotatedWidth,
+                            chInvertMask);
+        }
+    }
+}
+
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+/*!
+ * \brief FNV-1a over the packed band, one word at a time
+ */
+static 
+uint32_t __platform_time_critical_func(__epd_band_hash)(const uint8_t *pchBuffer, 
+                                                        size_t tSize)
+{
+    uint32_t wHash = 2166136261ul;
+    const uint32_t *pwWord = (const uint32_t *)pchBuffer;
+
+    for (size_t n = tSize >> 2; n > 0; n--) {
+        wHash = (wHash ^ *pwWord++) * 16777619ul;
+    }
+
+    pchBuffer = (const uint8_t *)pwWord;
+    for (size_t n = tSize & 0x03; n > 0; n--) {
+        wHash = (wHash ^ *pchBuffer++) * 16777619ul;
+    }
+
+    return wHash;
+}
+
+/*!
+ * \brief forget the hashes of all bands overlapping the given region
+ */
+static void __epd_band_forget(  __epd_band_table_t *ptTable,
+                                int16_t iX,
+                                int16_t iY,
+                                int16_t iWidth,
+                                int16_t iHeight)
+{
+    arm_foreach(__epd_band_hash_t, ptTable->tBands, ptBand) {
+        if (    iX < ptBand->iX + ptBand->iWidth
+            &&  ptBand->iX < iX + iWidth
+            &&  iY < ptBand->iY + ptBand->iHeight
+            &&  ptBand->iY < iY + iHeight) {
+            ptBand->iWidth = 0;
+        }
+    }
+}
+
+/*!
+ * \brief check whether the panel already shows the packed band at the given
+ *        location, and remember the new content otherwise
+ * \return true the band is unchanged and can be skipped
+ */
+static bool __epd_band_is_unchanged(__epd_band_table_t *ptTable,
+                                    int16_t iX,
+                                    int16_t iY,
+                                    int16_t iWidth,
+                                    int16_t iHeight,
+                                    uint32_t wHash)
+{
+    arm_foreach(__epd_band_hash_t, ptTable->tBands, ptBand) {
+        if (    ptBand->iX == iX 
+            &&  ptBand->iY == iY 
+            &&  ptBand->iWidth == iWidth 
+            &&  ptBand->iHeight == iHeight) {
+
+            if (ptBand->wHash == wHash) {
+                return true;
+            }
+            break;
+        }
+    }
+
+    /* the band and everything it overlaps is going to be overwritten */
+    __epd_band_forget(ptTable, iX, iY, iWidth, iHeight);
+
+    ptTable->tBands[ptTable->chNext++] = (__epd_band_hash_t) {
+        .iX = iX,
+        .iY = iY,
+        .iWidth = iWidth,
+        .iHeight = iHeight,
+        .wHash = wHash,
+    };
+    if (ptTable->chNext >= dimof(ptTable->tBands)) {
+        ptTable->chNext = 0;
+    }
+
+    return false;
+}
+#endif
+
+void __platform_time_critical_func(EPD_DrawBitmap)(  int16_t iX, 
+                                                    int16_t iY, 
+                                                    int16_t iWidth, 
+                                                    int16_t iHeight, 
+                                                    const uint8_t *pchBuffer)
 {
     assert((iX & 0x7) == 0);
     assert((iWidth & 0x7) == 0);
 
-    iX += iWidth - 1;
-
     int16_t iRotatedX = iY;
-    int16_t iRotatedY = EPD_SCREEN_HEIGHT - iX - 1;
+    int16_t iRotatedY = EPD_SCREEN_HEIGHT - (iX + iWidth - 1) - 1;
     int16_t iRotatedWidth = iHeight;
     int16_t iRotatedHeight = iWidth;
 
+    /* pack rows into the band buffer first, then send them in one SPI burst */
+    int16_t iBytesPerRow = (iRotatedWidth + 7) >> 3;
+    int16_t iRowsPerBurst = sizeof(s_chBandBuffer) / iBytesPerRow;
+    uint8_t chInvertMask = s_bInvertColor ? 0xFF : 0x00;
+    bool bEnableDither = s_bEnableDither;
+    int16_t iPackedRows = 0;
+
+    assert(iRowsPerBurst > 0);
+
+#if __PLATFORM_CFG_USE_EPD_OFFSCREEN__
+    if (NULL != s_tOffscreen.pchPage) {
+        /* render into the page instead of the panel. Nothing is skipped here,
+         * the page starts blank.
+         */
+        assert((iRotatedX & 0x7) == 0);
+
+        s_tOffscreen.wCoveredPixels += (uint32_t)iWidth * (uint32_t)iHeight;
+
+        for (int16_t i = 0; i < iRotatedHeight; i += iRowsPerBurst) {
+            int16_t iRowCount = MIN(iRowsPerBurst, iRotatedHeight - i);
+
+            __epd_pack_band(pchBuffer,
+                            iWidth,
+                            i,
+                            iRowCount,
+                            iRotatedWidth,
+                            chInvertMask,
+                            bEnableDither);
+
+        #if __PLATFORM_CFG_USE_RENDER_SKIP__
+            if (iRowsPerBurst >= iRotatedHeight) {
+                /* remember the band, so the panel knows it after the flip */
+                __epd_band_is_unchanged(&s_tOffscreen.tTable,
+                                        iX, iY, iWidth, iHeight,
+                                        __epd_band_hash(s_chBandBuffer,
+                                                        iRowCount * iBytesPerRow));
+            } else {
+                __epd_band_forget(&s_tOffscreen.tTable, iX, iY, iWidth, iHeight);
+            }
+        #endif
+
+            uint8_t *pchRow = s_tOffscreen.pchPage
+                            + (iRotatedY + i) * EPD_PAGE_BYTES_PER_ROW
+                            + (iRotatedX >> 3);
+            for (int16_t n = 0; n < iRowCount; n++) {
+                memcpy(pchRow, &s_chBandBuffer[n * iBytesPerRow], iBytesPerRow);
+                pchRow += EPD_PAGE_BYTES_PER_ROW;
+            }
+        }
+        return ;
+    }
+#endif
+
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    if (iRowsPerBurst >= iRotatedHeight) {
+        /* the whole band fits into the band buffer: pack it before touching 
+         * the panel, so an unchanged band costs neither window setup nor SPI
+         */
+        __epd_pack_band(pchBuffer,
+                        iWidth,
+                        0,
+                        iRotatedHeight,
+                        iRotatedWidth,
+                        chInvertMask,
+                        bEnableDither);
+        iPackedRows = iRotatedHeight;
+
+        uint32_t wHash = __epd_band_hash(   s_chBandBuffer, 
+                                            iRotatedHeight * iBytesPerRow);
+        if (__epd_band_is_unchanged(&s_tRenderSkip.tTable, 
+                                    iX, iY, iWidth, iHeight, wHash)) {
+            s_tRenderSkip.wSkippedBands++;
+            return ;
+        }
+    } else {
+        /* the band is too big to be hashed, forget whatever it covers */
+        __epd_band_forget(&s_tRenderSkip.tTable, iX, iY, iWidth, iHeight);
+    }
+
+    s_tRenderSkip.bFrameChanged = true;
+#endif
+
     epd_screen_set_window(iRotatedX, iRotatedY, iRotatedWidth, iRotatedHeight);
 
     epd_send_cmd(DATA_START_TRANSMISSION_2);
@@ -529,98 +932,23 @@ void EPD_DrawBitmap(int16_t iX, int16_t iY, int16_t iWidth, int16_t iHeight, con
     gpio_put(EPD_DC_PIN, 1);
     gpio_put(EPD_CS_PIN, 0);
 
-    if (s_bEnableDither) {
-        for (int16_t i = 0; i < iRotatedHeight; i++) {
-
-            for (int16_t j = 0; j < iRotatedWidth;) {
-                uint8_t chData = 0;
-
-                const uint8_t *pchBlock = &pchBuffer[iWidth - i - 1 + j * iWidth];
-
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= __epd_dither(*pchBlock, j++, i);
-                pchBlock += iWidth;
-
-                if (s_bInvertColor) { 
-                    chData = ~chData; 
-                }
-                epd_spi_write_byte(chData);
-            
-            }
+    for (int16_t i = 0; i < iRotatedHeight; i += iRowsPerBurst) {
+        int16_t iRowCount = MIN(iRowsPerBurst, iRotatedHeight - i);
+
+        if (0 == iPackedRows) {
+            __epd_pack_band(pchBuffer,
+                            iWidth,
+                            i,
+                            iRowCount,
+                            iRotatedWidth,
+                            chInvertMask,
+                            bEnableDither);
         }
-    } else {
-    
-        for (int16_t i = 0; i < iRotatedHeight; i++) {
-
-            for (int16_t j = 0; j < iRotatedWidth; j+= 8) {
-                uint8_t chData = 0;
-
-                const uint8_t *pchBlock = &pchBuffer[iWidth - i - 1 + j * iWidth];
-
-                chData |=  *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-                chData <<= 1;
-                
-                chData |= *pchBlock >= 0x80 ? 0x01 : 0x00;
-                pchBlock += iWidth;
-
-                if (s_bInvertColor) { 
-                    chData = ~chData; 
-                }
-                epd_spi_write_byte(chData);
-            
-            }
+
+        frame_probe_stage(FRAME_PROBE_STAGE_SPI) {
+            frame_trace_begin(FRAME_TRACE_EVT_SPI_BURST, iRowCount * iBytesPerRow);
+            epd_spi_write(s_chBandBuffer, iRowCount * iBytesPerRow);
+            frame_trace_end(FRAME_TRACE_EVT_SPI_BURST, iRowCount * iBytesPerRow);
         }
     }
     
@@ -637,10 +965,130 @@ void Disp0_DrawBitmap(  int16_t x,
                         int16_t height, 
                         const uint8_t *bitmap)
 {
+    frame_trace_begin(FRAME_TRACE_EVT_PFB_FLUSH, y);
     EPD_DrawBitmap(x, y, width, height, bitmap);
+    frame_trace_end(FRAME_TRACE_EVT_PFB_FLUSH, y);
 }
 
 void epd_flush(void)
 {
     epd_send_cmd(DISPLAY_REFRESH);
-}
\ No newline at end of file
+
+#if __PLATFORM_CFG_USE_FRAME_PROBE__ || __PLATFORM_CFG_USE_FRAME_TRACE__
+    s_lRefreshStart = get_system_ticks();
+    frame_trace_begin(FRAME_TRACE_EVT_PANEL_BUSY, 0);
+#endif
+}
+
+bool epd_flush_if_changed(void)
+{
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    if (!s_tRenderSkip.bFrameChanged) {
+        /* the panel already shows this frame, save the refresh */
+        s_tRenderSkip.wSkippedFrames++;
+        return false;
+    }
+    s_tRenderSkip.bFrameChanged = false;
+#endif
+
+    epd_flush();
+    return true;
+}
+
+#if __PLATFORM_CFG_USE_EPD_OFFSCREEN__
+size_t epd_offscreen_get_page_size(void)
+{
+    return EPD_PAGE_SIZE;
+}
+
+void epd_offscreen_begin(uint8_t *pchPage)
+{
+    assert(NULL != pchPage);
+
+    /* the bands not drawn stay white */
+    memset(pchPage, s_bInvertColor ? 0x00 : 0xFF, EPD_PAGE_SIZE);
+
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    memset(&s_tOffscreen.tTable, 0, sizeof(s_tOffscreen.tTable));
+#endif
+
+    s_tOffscreen.wCoveredPixels = 0;
+    s_tOffscreen.pchPage = pchPage;
+}
+
+void epd_offscreen_cancel(void)
+{
+    s_tOffscreen.pchPage = NULL;
+}
+
+bool epd_offscreen_is_active(void)
+{
+    return NULL != s_tOffscreen.pchPage;
+}
+
+bool epd_offscreen_is_complete(void)
+{
+    /* the PFBs of a full frame do not overlap */
+    return  (NULL != s_tOffscreen.pchPage)
+        &&  (   s_tOffscreen.wCoveredPixels 
+            >=  (uint32_t)EPD_SCREEN_WIDTH * (uint32_t)EPD_SCREEN_HEIGHT);
+}
+
+bool epd_offscreen_present(void)
+{
+    if (NULL == s_tOffscreen.pchPage || epd_screen_is_busy()) {
+        return false;
+    }
+
+    epd_screen_set_window(0, 0, EPD_SCREEN_WIDTH, EPD_SCREEN_HEIGHT);
+
+    epd_send_cmd(DATA_START_TRANSMISSION_2);
+
+    gpio_put(EPD_DC_PIN, 1);
+    gpio_put(EPD_CS_PIN, 0);
+
+    frame_probe_stage(FRAME_PROBE_STAGE_SPI) {
+        frame_trace_begin(FRAME_TRACE_EVT_SPI_BURST, EPD_PAGE_SIZE);
+        epd_spi_write(s_tOffscreen.pchPage, EPD_PAGE_SIZE);
+        frame_trace_end(FRAME_TRACE_EVT_SPI_BURST, EPD_PAGE_SIZE);
+    }
+
+    gpio_put(EPD_CS_PIN, 1);
+
+    epd_send_cmd(DATA_STOP);
+    epd_send_cmd(PARTIAL_OUT);
+
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    /* the panel shows what the captured bands describe, i.e. redrawing the
+     * same page later costs nothing
+     */
+    s_tRenderSkip.tTable = s_tOffscreen.tTable;
+    s_tRenderSkip.bFrameChanged = false;
+#endif
+
+    s_tOffscreen.pchPage = NULL;
+
+    epd_flush();
+
+    return true;
+}
+#endif
+
+void epd_get_render_skip_info(uint32_t *pwSkippedBands, uint32_t *pwSkippedFrames)
+{
+#if __PLATFORM_CFG_USE_RENDER_SKIP__
+    if (NULL != pwSkippedBands) {
+        *pwSkippedBands = s_tRenderSkip.wSkippedBands;
+    }
+    if (NULL != pwSkippedFrames) {
+        *pwSkippedFrames = s_tRenderSkip.wSkippedFrames;
+    }
+#else
+    if (NULL != pwSkippedBands) {
+        *pwSkippedBands = 0;
+    }
+    if (NULL != pwSkippedFrames) {
+        *pwSkippedFrames = 0;
+    }
+#endif
+}
@@ -0,0 +1,260 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./flash_text.h"
+
+#include <string.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+#define FLASH_TEXT_BLOCK_SIZE       __PLATFORM_CFG_FLASH_TEXT_BLOCK_SIZE__
+#define FLASH_TEXT_CACHE_BLOCKS     __PLATFORM_CFG_FLASH_TEXT_CACHE_BLOCKS__
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_USE_FLASH_TEXT__
+bool flash_text_open(const char **ppchText, size_t *ptSize)
+{
+    if (NULL == ppchText || NULL == ptSize) {
+        return false;
+    }
+
+    const flash_text_blob_header_t *ptHeader
+        = (const flash_text_blob_header_t *)__PLATFORM_CFG_FLASH_TEXT_ADDRESS__;
+    const char *pchText = (const char *)(ptHeader + 1);
+
+    /* an erased flash reads 0xFFFFFFFF */
+    if (    (FLASH_TEXT_BLOB_MAGIC != ptHeader->wMagic)
+        ||  (0 == ptHeader->wSize)
+        ||  (ptHeader->wSize > __PLATFORM_CFG_FLASH_TEXT_SIZE__
+                             - sizeof(flash_text_blob_header_t))
+        ||  ('\0' != pchText[ptHeader->wSize - 1])) {
+        return false;
+    }
+
+    *ppchText = pchText;
+    *ptSize = ptHeader->wSize;
+
+    return true;
+}
+#endif
+
+/* the only place touching the storage, e.g. replace the memcpy with a read
+ * of a filesystem or of an SPI flash which is not memory-mapped
+ */
+static void __flash_text_read_block(flash_text_reader_t *ptThis,
+                                    uint8_t *pchBuffer,
+                                    uint32_t wAddress,
+                                    uint32_t wSize)
+{
+    memcpy(pchBuffer, ptThis->pchDocument + wAddress, wSize);
+}
+
+static const uint8_t *__flash_text_find_block(  flash_text_reader_t *ptThis,
+                                                uint32_t wAddress)
+{
+    for (uint_fast8_t n = 0; n < FLASH_TEXT_CACHE_BLOCKS; n++) {
+        if (wAddress == ptThis->wTag[n]) {
+            return ptThis->chBlocks[n];
+        }
+    }
+
+    return NULL;
+}
+
+static const uint8_t *__flash_text_get_block(   flash_text_reader_t *ptThis,
+                                                uint32_t wAddress)
+{
+    const uint8_t *pchBlock = __flash_text_find_block(ptThis, wAddress);
+    if (NULL != pchBlock) {
+        return pchBlock;
+    }
+
+    /* blocks are replaced in turn */
+    uint_fast8_t chIndex = ptThis->chVictim;
+    ptThis->chVictim = (chIndex + 1) % FLASH_TEXT_CACHE_BLOCKS;
+
+    __flash_text_read_block(ptThis,
+                            ptThis->chBlocks[chIndex],
+                            wAddress,
+                            MIN(FLASH_TEXT_BLOCK_SIZE,
+                                ptThis->wDocumentSize - wAddress));
+    ptThis->wTag[chIndex] = wAddress;
+
+    return ptThis->chBlocks[chIndex];
+}
+
+static uint8_t __flash_text_get_byte(flash_text_reader_t *ptThis, uint32_t wOffset)
+{
+    uint32_t wAddress = wOffset - (wOffset % FLASH_TEXT_BLOCK_SIZE);
+
+    return __flash_text_get_block(ptThis, wAddress)[wOffset - wAddress];
+}
+
+void flash_text_reader_init(flash_text_reader_t *ptThis,
+                            const char *pchDocument,
+                            uint32_t wSize)
+{
+    assert(NULL != ptThis);
+    assert(NULL != pchDocument || 0 == wSize);
+
+    ptThis->pchDocument = (const uint8_t *)pchDocument;
+    ptThis->wDocumentSize = wSize;
+    ptThis->chVictim = 0;
+    memset(ptThis->wTag, 0xFF, sizeof(ptThis->wTag));
+
+    flash_text_reader_set_window(ptThis, 0, wSize);
+}
+
+void flash_text_reader_set_window(  flash_text_reader_t *ptThis,
+                                    uint32_t wStart,
+                                    uint32_t wSize)
+{
+    assert(NULL != ptThis);
+
+    wStart = MIN(wStart, ptThis->wDocumentSize);
+
+    ptThis->wStart = wStart;
+    ptThis->wSize = MIN(wSize, ptThis->wDocumentSize - wStart);
+    ptThis->wPosition = 0;
+}
+
+bool flash_text_reader_seek(flash_text_reader_t *ptThis,
+                            int32_t nOffset,
+                            flash_text_seek_whence_t tWhence)
+{
+    assert(NULL != ptThis);
+
+    int64_t lPosition = nOffset;
+
+    switch (tWhence) {
+        case FLASH_TEXT_SEEK_SET:
+            break;
+        case FLASH_TEXT_SEEK_CUR:
+            lPosition += ptThis->wPosition;
+            break;
+        case FLASH_TEXT_SEEK_END:
+            lPosition += ptThis->wSize;
+            break;
+        default:
+            return false;
+    }
+
+    if (lPosition < 0 || lPosition > ptThis->wSize) {
+        return false;
+    }
+
+    ptThis->wPosition = (uint32_t)lPosition;
+
+    return true;
+}
+
+uint32_t flash_text_reader_get_position(flash_text_reader_t *ptThis)
+{
+    assert(NULL != ptThis);
+
+    return ptThis->wPosition;
+}
+
+int32_t flash_text_reader_read( flash_text_reader_t *ptThis,
+                                uint8_t *pchBuffer,
+                                uint16_t hwSize)
+{
+    assert(NULL != ptThis);
+    assert(NULL != pchBuffer || 0 == hwSize);
+
+    uint32_t wLeft = ptThis->wSize - ptThis->wPosition;
+    uint32_t wCount = MIN(hwSize, wLeft);
+    uint32_t wOffset = ptThis->wStart + ptThis->wPosition;
+
+    if (wCount < wLeft) {
+        /* stop in front of the lead byte when the first byte left behind
+         * continues a UTF-8 sequence
+         */
+        uint32_t wTrimmed = wCount;
+        for (uint_fast8_t n = 0; n < 3 && wTrimmed > 0; n++) {
+            if (0x80 != (__flash_text_get_byte(ptThis, wOffset + wTrimmed) & 0xC0)) {
+                break;
+            }
+            wTrimmed--;
+        }
+
+        if (wTrimmed > 0) {
+            wCount = wTrimmed;
+        }
+    }
+
+    uint32_t wRead = 0;
+    while (wRead < wCount) {
+        uint32_t wAddress = wOffset - (wOffset % FLASH_TEXT_BLOCK_SIZE);
+        const uint8_t *pchBlock = __flash_text_get_block(ptThis, wAddress);
+
+        uint32_t wChunk = MIN(wCount - wRead,
+                              FLASH_TEXT_BLOCK_SIZE - (wOffset - wAddress));
+        memcpy(pchBuffer + wRead, pchBlock + (wOffset - wAddress), wChunk);
+
+        wRead += wChunk;
+        wOffset += wChunk;
+    }
+
+    ptThis->wPosition += wRead;
+
+    return (int32_t)wRead;
+}
+
+uint16_t flash_text_reader_read_at( flash_text_reader_t *ptThis,
+                                    uint32_t wOffset,
+                                    uint8_t *pchBuffer,
+                                    uint16_t hwSize)
+{
+    assert(NULL != ptThis);
+    assert(NULL != pchBuffer || 0 == hwSize);
+
+    if (wOffset >= ptThis->wDocumentSize) {
+        return 0;
+    }
+
+    uint32_t wCount = MIN(hwSize, ptThis->wDocumentSize - wOffset);
+    uint32_t wRead = 0;
+
+    while (wRead < wCount) {
+        uint32_t wAddress = wOffset - (wOffset % FLASH_TEXT_BLOCK_SIZE);
+        uint32_t wChunk = MIN(wCount - wRead,
+                              FLASH_TEXT_BLOCK_SIZE - (wOffset - wAddress));
+        const uint8_t *pchBlock = __flash_text_find_block(ptThis, wAddress);
+
+        /* a miss is read from the storage without evicting the window */
+        if (NULL != pchBlock) {
+            memcpy(pchBuffer + wRead, pchBlock + (wOffset - wAddress), wChunk);
+        } else {
+            __flash_text_read_block(ptThis, pchBuffer + wRead, wOffset, wChunk);
+        }
+
+        wRead += wChunk;
+        wOffset += wChunk;
+    }
+
+    return (uint16_t)wRead;
+}
@@ -0,0 +1,172 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_FLASH_TEXT_H__
+#define __BADGER_RP2040_FLASH_TEXT_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+/* the document format, please keep tools/text_pack.py in sync */
+#define FLASH_TEXT_BLOB_MAGIC           0x31585442ul        /* "BTX1" */
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_FLASH_TEXT__
+#   define flash_text_open(__TEXT_PTR_PTR, __SIZE_PTR)                          \
+            ((void)(__TEXT_PTR_PTR), (void)(__SIZE_PTR), false)
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the header of a document, followed by the UTF-8 text (8 bytes)
+ */
+typedef struct flash_text_blob_header_t {
+    uint32_t wMagic;
+    uint32_t wSize;                             //!< the size of the text, including the '\0'
+} flash_text_blob_header_t;
+
+typedef enum {
+    FLASH_TEXT_SEEK_SET,
+    FLASH_TEXT_SEEK_CUR,
+    FLASH_TEXT_SEEK_END,
+} flash_text_seek_whence_t;
+
+/*!
+ * \brief a reader of a window of a document, the blocks read from the flash
+ *        are cached in SRAM and kept when the window moves
+ */
+typedef struct flash_text_reader_t {
+    const uint8_t *pchDocument;
+    uint32_t wDocumentSize;
+
+    /* the window seen by the user, relative to the document */
+    uint32_t wStart;
+    uint32_t wSize;
+    uint32_t wPosition;                         //!< relative to the window
+
+    uint8_t chVictim;                           //!< the next block to replace
+    uint32_t wTag[__PLATFORM_CFG_FLASH_TEXT_CACHE_BLOCKS__];    //!< UINT32_MAX means empty
+    uint8_t chBlocks[__PLATFORM_CFG_FLASH_TEXT_CACHE_BLOCKS__]
+                    [__PLATFORM_CFG_FLASH_TEXT_BLOCK_SIZE__];
+} flash_text_reader_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_FLASH_TEXT__
+/*!
+ * \brief find the document in the flash region reserved for it
+ * \param[out] ppchText the text (XIP address)
+ * \param[out] ptSize the size of the text, including the '\0'
+ * \retval true a valid document is found
+ * \retval false no document, e.g. the region is erased
+ */
+extern
+bool flash_text_open(const char **ppchText, size_t *ptSize);
+#endif
+
+/*!
+ * \brief initialize a reader of a document, the window covers the whole text
+ * \param[in] ptThis the reader
+ * \param[in] pchDocument the text
+ * \param[in] wSize the size of the text
+ */
+extern
+void flash_text_reader_init(flash_text_reader_t *ptThis,
+                            const char *pchDocument,
+                            uint32_t wSize);
+
+/*!
+ * \brief move the window of a reader without dropping the cache
+ * \param[in] ptThis the reader
+ * \param[in] wStart the offset of the window in the document
+ * \param[in] wSize the size of the window
+ */
+extern
+void flash_text_reader_set_window(  flash_text_reader_t *ptThis,
+                                    uint32_t wStart,
+                                    uint32_t wSize);
+
+/*!
+ * \brief set the read position inside the window
+ * \param[in] ptThis the reader
+ * \param[in] nOffset the offset
+ * \param[in] tWhence where the offset starts
+ * \retval true the position is updated
+ * \retval false the position is out of the window
+ */
+extern
+bool flash_text_reader_seek(flash_text_reader_t *ptThis,
+                            int32_t nOffset,
+                            flash_text_seek_whence_t tWhence);
+
+/*!
+ * \brief get the read position inside the window
+ * \param[in] ptThis the reader
+ * \return uint32_t the position
+ */
+extern
+uint32_t flash_text_reader_get_position(flash_text_reader_t *ptThis);
+
+/*!
+ * \brief read the window from the current position
+ * \note a read never ends in the middle of a UTF-8 sequence unless the
+ *       sequence does not fit into the buffer at all
+ * \param[in] ptThis the reader
+ * \param[out] pchBuffer the buffer
+ * \param[in] hwSize the size of the buffer
+ * \return int32_t the number of bytes read, 0 means the end of the window
+ */
+extern
+int32_t flash_text_reader_read( flash_text_reader_t *ptThis,
+                                uint8_t *pchBuffer,
+                                uint16_t hwSize);
+
+/*!
+ * \brief read the document at an offset, ignoring the window and leaving the
+ *        read position unchanged, e.g. for indexing the whole document
+ * \note the cached blocks are used but a miss does not replace them
+ * \param[in] ptThis the reader
+ * \param[in] wOffset the offset in the document
+ * \param[out] pchBuffer the buffer
+ * \param[in] hwSize the number of bytes to read
+ * \return uint16_t the number of bytes read, 0 means the end of the document
+ */
+extern
+uint16_t flash_text_reader_read_at( flash_text_reader_t *ptThis,
+                                    uint32_t wOffset,
+                                    uint8_t *pchBuffer,
+                                    uint16_t hwSize);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
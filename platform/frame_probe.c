@@ -0,0 +1,189 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./frame_probe.h"
+
+#if __PLATFORM_CFG_USE_FRAME_PROBE__
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+#if __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+#   include "hardware/structs/busctrl.h"
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+static
+struct {
+    uint8_t chSceneID;
+    int64_t lCurrent[__FRAME_PROBE_STAGE_COUNT];
+    int64_t lLast[__FRAME_PROBE_STAGE_COUNT];
+
+    frame_probe_scene_stat_t tScenes[__PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__];
+} s_tFrameProbe;
+
+static const char * const c_pchStageNames[__FRAME_PROBE_STAGE_COUNT] = {
+    [FRAME_PROBE_STAGE_SCENE_DRAW]  = "draw",
+    [FRAME_PROBE_STAGE_PACK]        = "pack",
+    [FRAME_PROBE_STAGE_SPI]         = "spi",
+    [FRAME_PROBE_STAGE_WINDOW]      = "window",
+    [FRAME_PROBE_STAGE_LUT]         = "lut",
+    [FRAME_PROBE_STAGE_BUSY]        = "busy",
+};
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+static const uint8_t c_chContestedEvents[4] = {
+    arbiter_sram0_perf_event_access_contested,
+    arbiter_sram1_perf_event_access_contested,
+    arbiter_sram2_perf_event_access_contested,
+    arbiter_sram3_perf_event_access_contested,
+};
+#endif
+
+void frame_probe_report(frame_probe_stage_t tStage, int64_t lTicks)
+{
+    if (tStage >= __FRAME_PROBE_STAGE_COUNT) {
+        return ;
+    }
+
+    /* the BUSY wait might be reported from an ISR in the future */
+    __IRQ_SAFE {
+        s_tFrameProbe.lCurrent[tStage] += lTicks;
+    }
+}
+
+void frame_probe_set_scene(uint_fast8_t chSceneID)
+{
+    if (chSceneID >= __PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__) {
+        chSceneID = __PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__ - 1;
+    }
+    s_tFrameProbe.chSceneID = chSceneID;
+
+#if __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+    for (int_fast8_t n = 0; n < dimof(c_chContestedEvents); n++) {
+        busctrl_hw->counter[n].sel = c_chContestedEvents[n];
+        busctrl_hw->counter[n].value = 0;           /* any write clears it */
+    }
+#endif
+}
+
+void frame_probe_on_frame_complete(int64_t lDrawTicks)
+{
+    frame_probe_scene_stat_t *ptStat
+        = &s_tFrameProbe.tScenes[s_tFrameProbe.chSceneID];
+
+    __IRQ_SAFE {
+        s_tFrameProbe.lCurrent[FRAME_PROBE_STAGE_SCENE_DRAW] += lDrawTicks;
+
+        memcpy( s_tFrameProbe.lLast,
+                s_tFrameProbe.lCurrent,
+                sizeof(s_tFrameProbe.lLast));
+        memset(s_tFrameProbe.lCurrent, 0, sizeof(s_tFrameProbe.lCurrent));
+    }
+
+    ptStat->wFrames++;
+    for (int_fast8_t n = 0; n < __FRAME_PROBE_STAGE_COUNT; n++) {
+        int64_t lTicks = s_tFrameProbe.lLast[n];
+
+        ptStat->lTotal[n] += lTicks;
+        if (lTicks > ptStat->nMax[n]) {
+            ptStat->nMax[n] = (int32_t)MIN(lTicks, INT32_MAX);
+        }
+    }
+
+#if __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+    /* the counters saturate at 24bits, fold them in each frame */
+    for (int_fast8_t n = 0; n < dimof(c_chContestedEvents); n++) {
+        ptStat->wContested[n] += busctrl_hw->counter[n].value;
+        busctrl_hw->counter[n].value = 0;
+    }
+#endif
+}
+
+const int64_t *frame_probe_get_last_frame(void)
+{
+    return s_tFrameProbe.lLast;
+}
+
+const frame_probe_scene_stat_t *frame_probe_get_scene_stat(
+                                                    uint_fast8_t chSceneID)
+{
+    if (chSceneID >= __PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__) {
+        return NULL;
+    }
+
+    return &s_tFrameProbe.tScenes[chSceneID];
+}
+
+void frame_probe_dump_scene(uint_fast8_t chSceneID)
+{
+    if (chSceneID >= __PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__) {
+        return ;
+    }
+
+    frame_probe_scene_stat_t *ptStat = &s_tFrameProbe.tScenes[chSceneID];
+    if (0 == ptStat->wFrames) {
+        return ;
+    }
+
+    int64_t lFrameTotal = 0;
+    for (int_fast8_t n = 0; n < __FRAME_PROBE_STAGE_COUNT; n++) {
+        lFrameTotal += ptStat->lTotal[n];
+    }
+    lFrameTotal /= ptStat->wFrames;
+
+    printf( "[frame probe] scene %d: %"PRIu32" frames, %"PRId32"us per frame"
+            " (code: "PLATFORM_CODE_PLACEMENT")\r\n",
+            (int)chSceneID,
+            ptStat->wFrames,
+            (int32_t)perfc_convert_ticks_to_us(lFrameTotal));
+
+    for (int_fast8_t n = 0; n < __FRAME_PROBE_STAGE_COUNT; n++) {
+        int64_t lAverage = ptStat->lTotal[n] / ptStat->wFrames;
+
+        printf( "    %-8s avg:%8"PRId32"us  max:%8"PRId32"us  %3d%%\r\n",
+                c_pchStageNames[n],
+                (int32_t)perfc_convert_ticks_to_us(lAverage),
+                (int32_t)perfc_convert_ticks_to_us(ptStat->nMax[n]),
+                (int)(lFrameTotal ? (lAverage * 100 / lFrameTotal) : 0));
+    }
+
+#if __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+    printf( "    contested sram0:%"PRIu32" sram1:%"PRIu32
+            " sram2:%"PRIu32" sram3:%"PRIu32" per frame\r\n",
+            ptStat->wContested[0] / ptStat->wFrames,
+            ptStat->wContested[1] / ptStat->wFrames,
+            ptStat->wContested[2] / ptStat->wFrames,
+            ptStat->wContested[3] / ptStat->wFrames);
+#endif
+
+    memset(ptStat, 0, sizeof(frame_probe_scene_stat_t));
+}
+
+#endif
@@ -0,0 +1,155 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_FRAME_PROBE_H__
+#define __BADGER_RP2040_FRAME_PROBE_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "perf_counter.h"
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#define __FRAME_PROBE_CONNECT3(__A, __B, __C)       __A##__B##__C
+#define __FRAME_PROBE_NAME(__NAME, __LINE)                                      \
+            __FRAME_PROBE_CONNECT3(__frame_probe_, __NAME, __LINE)
+
+#if __PLATFORM_CFG_USE_FRAME_PROBE__
+/*!
+ * \brief measure the code block that follows and add the elapsed cycles to
+ *        the given stage of the current frame, e.g.
+ *
+ *        frame_probe_stage(FRAME_PROBE_STAGE_SPI) {
+ *            epd_spi_write(pchBuffer, tSize);
+ *        }
+ *
+ * \note please do NOT use break or return inside the measured block, otherwise
+ *       the elapsed time is lost.
+ * \param[in] __STAGE the target stage, see frame_probe_stage_t
+ */
+#   define frame_probe_stage(__STAGE)                                           \
+    for (int64_t __FRAME_PROBE_NAME(lStart, __LINE__) = get_system_ticks(),     \
+                 __FRAME_PROBE_NAME(lOnce, __LINE__) = 1;                       \
+         __FRAME_PROBE_NAME(lOnce, __LINE__)--;                                 \
+         frame_probe_report((__STAGE),                                          \
+                            get_system_ticks()                                  \
+                          - __FRAME_PROBE_NAME(lStart, __LINE__)))
+#else
+#   define frame_probe_stage(__STAGE)
+#   define frame_probe_report(__STAGE, __TICKS)
+#   define frame_probe_set_scene(__ID)
+#   define frame_probe_on_frame_complete(__DRAW_TICKS)
+#   define frame_probe_dump_scene(__ID)
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the stages of the frame pipeline
+ */
+typedef enum {
+    FRAME_PROBE_STAGE_SCENE_DRAW,               //!< scene drawing into PFBs
+    FRAME_PROBE_STAGE_PACK,                     //!< dither/threshold and pack into 1bpp
+    FRAME_PROBE_STAGE_SPI,                      //!< pixel data transfer over SPI
+    FRAME_PROBE_STAGE_WINDOW,                   //!< partial window setup
+    FRAME_PROBE_STAGE_LUT,                      //!< waveform LUT upload
+    FRAME_PROBE_STAGE_BUSY,                     //!< waiting for the panel refresh
+
+    __FRAME_PROBE_STAGE_COUNT,
+} frame_probe_stage_t;
+
+/*!
+ * \brief the accumulated statistics of a scene
+ */
+typedef struct frame_probe_scene_stat_t {
+    uint32_t wFrames;
+    int64_t lTotal[__FRAME_PROBE_STAGE_COUNT];
+    int32_t nMax[__FRAME_PROBE_STAGE_COUNT];
+#if __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+    uint32_t wContested[4];                     //!< contested accesses of SRAM0~3
+#endif
+} frame_probe_scene_stat_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_FRAME_PROBE__
+
+/*!
+ * \brief add elapsed cycles to a stage of the current frame
+ * \param[in] tStage the target stage
+ * \param[in] lTicks the elapsed cycles
+ */
+extern
+void frame_probe_report(frame_probe_stage_t tStage, int64_t lTicks);
+
+/*!
+ * \brief select the scene that the following frames are attributed to
+ * \param[in] chSceneID the scene, see playlist_scene_id_t
+ */
+extern
+void frame_probe_set_scene(uint_fast8_t chSceneID);
+
+/*!
+ * \brief close the current frame and fold it into the statistics of the
+ *        current scene
+ * \param[in] lDrawTicks the cycles spent in scene drawing
+ */
+extern
+void frame_probe_on_frame_complete(int64_t lDrawTicks);
+
+/*!
+ * \brief get the stage cycles of the last completed frame
+ * \return const int64_t * an array of __FRAME_PROBE_STAGE_COUNT items
+ */
+extern
+const int64_t *frame_probe_get_last_frame(void);
+
+/*!
+ * \brief get the accumulated statistics of a given scene
+ * \param[in] chSceneID the scene, see playlist_scene_id_t
+ * \return const frame_probe_scene_stat_t * the statistics, NULL for an
+ *         invalid scene index
+ */
+extern
+const frame_probe_scene_stat_t *frame_probe_get_scene_stat(
+                                                    uint_fast8_t chSceneID);
+
+/*!
+ * \brief print the per-stage breakdown of a scene and reset its statistics
+ * \param[in] chSceneID the scene, see playlist_scene_id_t
+ */
+extern
+void frame_probe_dump_scene(uint_fast8_t chSceneID);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
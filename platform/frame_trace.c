@@ -0,0 +1,243 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./frame_trace.h"
+
+#if __PLATFORM_CFG_USE_FRAME_TRACE__
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+#include "arm_2d_helper.h"
+
+/*============================ MACROS ========================================*/
+
+/* the number of scenes that can be hooked at the same time, i.e. the scene
+ * being switched out and the scene being switched in
+ */
+#ifndef FRAME_TRACE_HOOK_SLOTS
+#   define FRAME_TRACE_HOOK_SLOTS      4
+#endif
+
+/* the component number used for the EventRecorder */
+#ifndef FRAME_TRACE_EVR_COMPONENT
+#   define FRAME_TRACE_EVR_COMPONENT   0xA0
+#endif
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+typedef struct __frame_trace_hook_t {
+    arm_2d_scene_t *ptScene;
+
+    void (*fnOnFrameStart)(arm_2d_scene_t *ptThis);
+    arm_2d_helper_draw_handler_t *fnScene;
+    void (*fnOnFrameCPL)(arm_2d_scene_t *ptThis);
+    void (*fnDepose)(arm_2d_scene_t *ptThis);
+} __frame_trace_hook_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+extern uint32_t SystemCoreClock;
+
+/*============================ LOCAL VARIABLES ===============================*/
+
+static
+struct {
+    uint16_t hwHead;
+    uint16_t hwCount;
+    volatile bool bFrozen;
+
+    frame_trace_record_t tRecords[__PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__];
+
+    __frame_trace_hook_t tHooks[FRAME_TRACE_HOOK_SLOTS];
+} s_tFrameTrace;
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+void frame_trace_record(frame_trace_event_id_t tEvent,
+                        frame_trace_phase_t tPhase,
+                        uint16_t hwArg)
+{
+    if (s_tFrameTrace.bFrozen) {
+        return ;
+    }
+
+    uint32_t wTimestamp = (uint32_t)get_system_ticks();
+
+    __IRQ_SAFE {
+        frame_trace_record_t *ptRecord
+            = &s_tFrameTrace.tRecords[s_tFrameTrace.hwHead];
+
+        ptRecord->wTimestamp = wTimestamp;
+        ptRecord->chEvent = (uint8_t)tEvent;
+        ptRecord->chPhase = (uint8_t)tPhase;
+        ptRecord->hwArg = hwArg;
+
+        if (++s_tFrameTrace.hwHead >= __PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__) {
+            s_tFrameTrace.hwHead = 0;
+        }
+        if (s_tFrameTrace.hwCount < __PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__) {
+            s_tFrameTrace.hwCount++;
+        }
+    }
+
+#if __PLATFORM_CFG_FRAME_TRACE_USE_EVENT_RECORDER__                             \
+&&  (defined(RTE_Compiler_EventRecorder) || defined(RTE_CMSIS_View_EventRecorder))
+    EventRecord2(   EventID(EventLevelOp, FRAME_TRACE_EVR_COMPONENT, tEvent),
+                    tPhase,
+                    hwArg);
+#endif
+}
+
+void frame_trace_dump(void)
+{
+    s_tFrameTrace.bFrozen = true;
+
+    uint_fast16_t hwCount = s_tFrameTrace.hwCount;
+    uint_fast16_t hwIndex = s_tFrameTrace.hwHead + __PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__
+                          - hwCount;
+
+    printf( "#TRACE-BEGIN freq=%"PRIu32" count=%d\r\n",
+            SystemCoreClock,
+            (int)hwCount);
+
+    while(hwCount--) {
+        frame_trace_record_t *ptRecord
+            = &s_tFrameTrace.tRecords[  hwIndex++
+                                    %   __PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__];
+
+        printf( "%08"PRIx32"%02x%02x%04x\r\n",
+                ptRecord->wTimestamp,
+                ptRecord->chEvent,
+                ptRecord->chPhase,
+                ptRecord->hwArg);
+    }
+
+    printf("#TRACE-END\r\n");
+
+    s_tFrameTrace.hwHead = 0;
+    s_tFrameTrace.hwCount = 0;
+    s_tFrameTrace.bFrozen = false;
+}
+
+/*----------------------------------------------------------------------------*
+ * Scene Hooks                                                                *
+ *----------------------------------------------------------------------------*/
+
+static __frame_trace_hook_t *__frame_trace_find_hook(arm_2d_scene_t *ptScene)
+{
+    arm_foreach(__frame_trace_hook_t, s_tFrameTrace.tHooks, ptHook) {
+        if (ptHook->ptScene == ptScene) {
+            return ptHook;
+        }
+    }
+
+    return NULL;
+}
+
+static void __frame_trace_on_frame_start(arm_2d_scene_t *ptScene)
+{
+    __frame_trace_hook_t *ptHook = __frame_trace_find_hook(ptScene);
+    assert(NULL != ptHook);
+
+    frame_trace_begin(FRAME_TRACE_EVT_ON_FRAME_START, 0);
+    if (NULL != ptHook->fnOnFrameStart) {
+        ptHook->fnOnFrameStart(ptScene);
+    }
+    frame_trace_end(FRAME_TRACE_EVT_ON_FRAME_START, 0);
+}
+
+static void __frame_trace_on_frame_complete(arm_2d_scene_t *ptScene)
+{
+    __frame_trace_hook_t *ptHook = __frame_trace_find_hook(ptScene);
+    assert(NULL != ptHook);
+
+    frame_trace_begin(FRAME_TRACE_EVT_ON_FRAME_CPL, 0);
+    if (NULL != ptHook->fnOnFrameCPL) {
+        ptHook->fnOnFrameCPL(ptScene);
+    }
+    frame_trace_end(FRAME_TRACE_EVT_ON_FRAME_CPL, 0);
+}
+
+static
+IMPL_PFB_ON_DRAW(__frame_trace_draw_scene)
+{
+    __frame_trace_hook_t *ptHook = __frame_trace_find_hook((arm_2d_scene_t *)pTarget);
+    assert(NULL != ptHook);
+
+    arm_fsm_rt_t tResult = arm_fsm_rt_cpl;
+
+    frame_trace_begin(FRAME_TRACE_EVT_SCENE_DRAW, bIsNewFrame);
+    if (NULL != ptHook->fnScene) {
+        tResult = ptHook->fnScene(pTarget, ptTile, bIsNewFrame);
+    }
+    frame_trace_end(FRAME_TRACE_EVT_SCENE_DRAW, bIsNewFrame);
+
+    return tResult;
+}
+
+static void __frame_trace_on_depose(arm_2d_scene_t *ptScene)
+{
+    __frame_trace_hook_t *ptHook = __frame_trace_find_hook(ptScene);
+    assert(NULL != ptHook);
+
+    void (*fnDepose)(arm_2d_scene_t *ptThis) = ptHook->fnDepose;
+
+    /* release the slot before the scene memory might be freed */
+    memset(ptHook, 0, sizeof(__frame_trace_hook_t));
+
+    if (NULL != fnDepose) {
+        fnDepose(ptScene);
+    }
+}
+
+void *frame_trace_hook_scene(void *ptTarget)
+{
+    arm_2d_scene_t *ptScene = (arm_2d_scene_t *)ptTarget;
+    if (NULL == ptScene) {
+        return NULL;
+    }
+
+    __frame_trace_hook_t *ptHook = __frame_trace_find_hook(NULL);
+    if (NULL == ptHook) {
+        /* no free slot, leave the scene untraced */
+        return ptTarget;
+    }
+
+    frame_trace_instant(FRAME_TRACE_EVT_SCENE_SWITCH, 0);
+
+    *ptHook = (__frame_trace_hook_t) {
+        .ptScene = ptScene,
+        .fnOnFrameStart = ptScene->fnOnFrameStart,
+        .fnScene = ptScene->fnScene,
+        .fnOnFrameCPL = ptScene->fnOnFrameCPL,
+        .fnDepose = ptScene->fnDepose,
+    };
+
+    ptScene->fnOnFrameStart = &__frame_trace_on_frame_start;
+    ptScene->fnScene = &__frame_trace_draw_scene;
+    ptScene->fnOnFrameCPL = &__frame_trace_on_frame_complete;
+    ptScene->fnDepose = &__frame_trace_on_depose;
+
+    return ptTarget;
+}
+
+#endif
@@ -0,0 +1,125 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_FRAME_TRACE_H__
+#define __BADGER_RP2040_FRAME_TRACE_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "arm_2d_helper.h"
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if __PLATFORM_CFG_USE_FRAME_TRACE__
+#   define frame_trace_begin(__EVENT, __ARG)                                    \
+            frame_trace_record((__EVENT), FRAME_TRACE_PHASE_BEGIN, (__ARG))
+#   define frame_trace_end(__EVENT, __ARG)                                      \
+            frame_trace_record((__EVENT), FRAME_TRACE_PHASE_END, (__ARG))
+#   define frame_trace_instant(__EVENT, __ARG)                                  \
+            frame_trace_record((__EVENT), FRAME_TRACE_PHASE_INSTANT, (__ARG))
+#else
+#   define frame_trace_begin(__EVENT, __ARG)
+#   define frame_trace_end(__EVENT, __ARG)
+#   define frame_trace_instant(__EVENT, __ARG)
+#   define frame_trace_hook_scene(__SCENE_PTR)      ((void)(__SCENE_PTR))
+#   define frame_trace_dump()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the events of the frame pipeline
+ * \note the values are part of the dump format, please only append new items
+ *       and keep tools/trace2chrome.py in sync.
+ */
+typedef enum {
+    FRAME_TRACE_EVT_ON_FRAME_START  = 0,        //!< scene fnOnFrameStart
+    FRAME_TRACE_EVT_SCENE_DRAW      = 1,        //!< scene fnScene (per PFB band)
+    FRAME_TRACE_EVT_ON_FRAME_CPL    = 2,        //!< scene fnOnFrameCPL
+    FRAME_TRACE_EVT_PFB_FLUSH       = 3,        //!< low level flushing of a PFB band
+    FRAME_TRACE_EVT_SPI_BURST       = 4,        //!< a SPI burst of packed pixels
+    FRAME_TRACE_EVT_PANEL_BUSY      = 5,        //!< panel refresh, i.e. BUSY period
+    FRAME_TRACE_EVT_SCENE_SWITCH    = 6,        //!< a new scene is loaded
+} frame_trace_event_id_t;
+
+typedef enum {
+    FRAME_TRACE_PHASE_BEGIN         = 'B',
+    FRAME_TRACE_PHASE_END           = 'E',
+    FRAME_TRACE_PHASE_INSTANT       = 'i',
+} frame_trace_phase_t;
+
+/*!
+ * \brief a trace record in the ring buffer (8 bytes)
+ */
+typedef struct frame_trace_record_t {
+    uint32_t wTimestamp;                        //!< the lower 32bits of the cycle counter
+    uint8_t chEvent;                            //!< frame_trace_event_id_t
+    uint8_t chPhase;                            //!< frame_trace_phase_t
+    uint16_t hwArg;                             //!< event specific argument
+} frame_trace_record_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_FRAME_TRACE__
+
+/*!
+ * \brief add an event to the trace ring buffer
+ * \param[in] tEvent the event id
+ * \param[in] tPhase the phase of the event
+ * \param[in] hwArg an event specific argument
+ */
+extern
+void frame_trace_record(frame_trace_event_id_t tEvent,
+                        frame_trace_phase_t tPhase,
+                        uint16_t hwArg);
+
+/*!
+ * \brief redirect fnOnFrameStart, fnScene and fnOnFrameCPL of a scene to
+ *        trampolines that trace the begin/end of each callback.
+ * \note the hook is removed automatically when the scene is deposed.
+ * \param[in] ptScene the target scene
+ * \return void* the ptScene
+ */
+extern
+void *frame_trace_hook_scene(void *ptScene);
+
+/*!
+ * \brief print the content of the ring buffer over stdio as hex records
+ *        which can be converted by tools/trace2chrome.py
+ * \note the ring buffer is cleared after dumping
+ */
+extern
+void frame_trace_dump(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
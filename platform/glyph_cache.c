@@ -0,0 +1,404 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./glyph_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+#define GLYPH_CACHE_ENTRIES         __PLATFORM_CFG_GLYPH_CACHE_ENTRIES__
+#define GLYPH_CACHE_MAX_HEIGHT      __PLATFORM_CFG_GLYPH_CACHE_MAX_HEIGHT__
+#define GLYPH_CACHE_BUCKETS         32
+
+/* the same threshold as the 1bpp packing of the EPD driver, i.e. a pixel
+ * blended with an alpha of 0x80 or more becomes the foreground colour
+ */
+#define GLYPH_CACHE_THRESHOLD       0x80
+
+#if GLYPH_CACHE_ENTRIES > 255
+#   error __PLATFORM_CFG_GLYPH_CACHE_ENTRIES__ must not exceed 255
+#endif
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+typedef struct __glyph_cache_entry_t {
+    const arm_2d_tile_t *ptFontTile;            //!< NULL means a free entry
+    arm_2d_location_t tLocation;                //!< the glyph in the font tile
+    uint8_t chWidth;
+    uint8_t chHeight;
+    uint8_t chNext;                             //!< the next entry of the bucket plus 1
+    uint32_t wLastUse;
+    uint32_t wRows[GLYPH_CACHE_MAX_HEIGHT];     //!< bit n is the pixel at x = n
+} __glyph_cache_entry_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+#if __PLATFORM_CFG_USE_GLYPH_CACHE__
+static
+struct {
+    uint32_t wClock;                            //!< the LRU time stamp
+    uint8_t chBuckets[GLYPH_CACHE_BUCKETS];     //!< the first entry plus 1, 0 means none
+    __glyph_cache_entry_t tEntries[GLYPH_CACHE_ENTRIES];
+
+    glyph_cache_info_t tInfo;
+} s_tGlyphCache;
+#endif
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_USE_GLYPH_CACHE__
+
+static uint_fast8_t __glyph_cache_hash(const arm_2d_tile_t *ptFontTile,
+                                       arm_2d_location_t tLocation)
+{
+    uint32_t wHash = (uint32_t)(uintptr_t)ptFontTile
+                   ^ ((uint32_t)(uint16_t)tLocation.iY * 0x9E3779B1ul)
+                   ^ ((uint32_t)(uint16_t)tLocation.iX << 16);
+
+    return (wHash ^ (wHash >> 16)) & (GLYPH_CACHE_BUCKETS - 1);
+}
+
+static void __glyph_cache_unlink(__glyph_cache_entry_t *ptEntry)
+{
+    uint_fast8_t chLink = ptEntry - s_tGlyphCache.tEntries + 1;
+    uint8_t *pchLink = &s_tGlyphCache.chBuckets[
+                            __glyph_cache_hash(ptEntry->ptFontTile,
+                                               ptEntry->tLocation)];
+
+    while (0 != *pchLink) {
+        if (*pchLink == chLink) {
+            *pchLink = ptEntry->chNext;
+            return ;
+        }
+        pchLink = &s_tGlyphCache.tEntries[*pchLink - 1].chNext;
+    }
+}
+
+/* get a free entry or the least recently used one */
+static __glyph_cache_entry_t *__glyph_cache_evict(void)
+{
+    __glyph_cache_entry_t *ptVictim = &s_tGlyphCache.tEntries[0];
+
+    arm_foreach(__glyph_cache_entry_t, s_tGlyphCache.tEntries, ptEntry) {
+        if (NULL == ptEntry->ptFontTile) {
+            return ptEntry;
+        }
+        if ((int32_t)(ptEntry->wLastUse - ptVictim->wLastUse) < 0) {
+            ptVictim = ptEntry;
+        }
+    }
+
+    __glyph_cache_unlink(ptVictim);
+    s_tGlyphCache.tInfo.wEvictions++;
+
+    return ptVictim;
+}
+
+/* threshold a glyph of an A2, A4 or A8 font into 1bpp rows */
+static bool __glyph_cache_rasterize(__glyph_cache_entry_t *ptEntry,
+                                    const arm_2d_tile_t *ptileChar)
+{
+    arm_2d_region_t tValidRegion;
+    arm_2d_tile_t *ptRoot = arm_2d_tile_get_root(ptileChar, &tValidRegion, NULL);
+    if (NULL == ptRoot) {
+        return false;
+    }
+
+    uint_fast8_t chBits;
+    switch (ptRoot->tInfo.tColourInfo.chScheme) {
+        case ARM_2D_COLOUR_MASK_A2:
+            chBits = 2;
+            break;
+        case ARM_2D_COLOUR_MASK_A4:
+            chBits = 4;
+            break;
+        case ARM_2D_COLOUR_MASK_A8:
+            chBits = 8;
+            break;
+        default:
+            return false;
+    }
+
+    /* rows of the sub-byte masks are byte aligned, the first pixel is in the
+     * least significant bits
+     */
+    uint32_t wStride = ((uint32_t)ptRoot->tRegion.tSize.iWidth * chBits + 7) >> 3;
+    uint_fast8_t chPixelMask = (1u << chBits) - 1;
+    uint_fast8_t chThreshold = GLYPH_CACHE_THRESHOLD >> (8 - chBits);
+
+    const uint8_t *pchRow = ptRoot->pchBuffer
+                          + tValidRegion.tLocation.iY * wStride;
+
+    for (int_fast16_t y = 0; y < ptEntry->chHeight; y++) {
+        uint32_t wBits = 0;
+
+        for (int_fast16_t x = 0; x < ptEntry->chWidth; x++) {
+            uint32_t wBitOffset = (uint32_t)(tValidRegion.tLocation.iX + x) * chBits;
+            uint_fast8_t chPixel = (pchRow[wBitOffset >> 3] >> (wBitOffset & 0x07))
+                                 & chPixelMask;
+
+            if (chPixel >= chThreshold) {
+                wBits |= 1ul << x;
+            }
+        }
+
+        ptEntry->wRows[y] = wBits;
+        pchRow += wStride;
+    }
+
+    return true;
+}
+
+static __glyph_cache_entry_t *__glyph_cache_find(const arm_2d_tile_t *ptileChar)
+{
+    const arm_2d_tile_t *ptFontTile = ptileChar->ptParent;
+    arm_2d_location_t tLocation = ptileChar->tRegion.tLocation;
+    arm_2d_size_t tSize = ptileChar->tRegion.tSize;
+
+    if (    (tSize.iWidth > GLYPH_CACHE_MAX_WIDTH)
+        ||  (tSize.iHeight > GLYPH_CACHE_MAX_HEIGHT)
+        ||  (tSize.iWidth <= 0 || tSize.iHeight <= 0)) {
+        return NULL;
+    }
+
+    uint8_t *pchBucket = &s_tGlyphCache.chBuckets[
+                                __glyph_cache_hash(ptFontTile, tLocation)];
+
+    for (uint_fast8_t chLink = *pchBucket;
+        0 != chLink;
+        chLink = s_tGlyphCache.tEntries[chLink - 1].chNext) {
+
+        __glyph_cache_entry_t *ptEntry = &s_tGlyphCache.tEntries[chLink - 1];
+
+        if (    (ptEntry->ptFontTile == ptFontTile)
+            &&  (ptEntry->tLocation.iX == tLocation.iX)
+            &&  (ptEntry->tLocation.iY == tLocation.iY)
+            &&  (ptEntry->chWidth == tSize.iWidth)
+            &&  (ptEntry->chHeight == tSize.iHeight)) {
+            ptEntry->wLastUse = ++s_tGlyphCache.wClock;
+            s_tGlyphCache.tInfo.wHits++;
+            return ptEntry;
+        }
+    }
+
+    __glyph_cache_entry_t *ptEntry = __glyph_cache_evict();
+
+    ptEntry->ptFontTile = NULL;
+    ptEntry->tLocation = tLocation;
+    ptEntry->chWidth = tSize.iWidth;
+    ptEntry->chHeight = tSize.iHeight;
+
+    if (!__glyph_cache_rasterize(ptEntry, ptileChar)) {
+        return NULL;
+    }
+
+    ptEntry->ptFontTile = ptFontTile;
+    ptEntry->wLastUse = ++s_tGlyphCache.wClock;
+    ptEntry->chNext = *pchBucket;
+    *pchBucket = ptEntry - s_tGlyphCache.tEntries + 1;
+
+    s_tGlyphCache.tInfo.wMisses++;
+
+    return ptEntry;
+}
+
+/* blend the glyph as the fonts of arm-2d do */
+static arm_fsm_rt_t __glyph_cache_blend(const arm_2d_tile_t *ptTile,
+                                        const arm_2d_region_t *ptRegion,
+                                        arm_2d_tile_t *ptileChar,
+                                        COLOUR_INT tForeColour,
+                                        uint_fast8_t chOpacity)
+{
+    s_tGlyphCache.tInfo.wBypasses++;
+
+    arm_2d_tile_t *ptRoot = arm_2d_tile_get_root(ptileChar, NULL, NULL);
+    if (NULL == ptRoot) {
+        return arm_fsm_rt_cpl;
+    }
+
+    switch (ptRoot->tInfo.tColourInfo.chScheme) {
+        case ARM_2D_COLOUR_MASK_A2:
+            return arm_2d_fill_colour_with_a2_mask_and_opacity(
+                                        ptTile,
+                                        ptRegion,
+                                        ptileChar,
+                                        (__arm_2d_color_t){tForeColour},
+                                        chOpacity);
+        case ARM_2D_COLOUR_MASK_A4:
+            return arm_2d_fill_colour_with_a4_mask_and_opacity(
+                                        ptTile,
+                                        ptRegion,
+                                        ptileChar,
+                                        (__arm_2d_color_t){tForeColour},
+                                        chOpacity);
+        default:
+            return arm_2d_fill_colour_with_mask_and_opacity(
+                                        ptTile,
+                                        ptRegion,
+                                        ptileChar,
+                                        (__arm_2d_color_t){tForeColour},
+                                        chOpacity);
+    }
+}
+
+static
+IMPL_FONT_DRAW_CHAR(__glyph_cache_draw_char)
+{
+    __glyph_cache_entry_t *ptEntry = NULL;
+
+    if (    (0.0f == fScale)
+        &&  (255 == chOpacity)) {
+        ptEntry = __glyph_cache_find(ptileChar);
+    }
+    if (NULL == ptEntry) {
+        return __glyph_cache_blend( ptTile,
+                                    ptRegion,
+                                    ptileChar,
+                                    tForeColour,
+                                    chOpacity);
+    }
+
+    arm_2d_tile_t tTarget;
+    if (NULL == arm_2d_tile_generate_child(ptTile, ptRegion, &tTarget, false)) {
+        return arm_fsm_rt_cpl;
+    }
+
+    /* the visible part of the glyph in the PFB */
+    arm_2d_region_t tValidRegion;
+    arm_2d_location_t tOffset;
+    arm_2d_tile_t *ptRoot = arm_2d_tile_get_root(&tTarget, &tValidRegion, &tOffset);
+    if (NULL == ptRoot) {
+        return arm_fsm_rt_cpl;
+    }
+
+    int_fast16_t iWidth = MIN(tValidRegion.tSize.iWidth, ptEntry->chWidth - tOffset.iX);
+    int_fast16_t iHeight = MIN(tValidRegion.tSize.iHeight, ptEntry->chHeight - tOffset.iY);
+    if (iWidth <= 0 || iHeight <= 0) {
+        return arm_fsm_rt_cpl;
+    }
+
+    uint32_t wMask = (iWidth >= 32) ? UINT32_MAX : ((1ul << iWidth) - 1);
+    int_fast16_t iStride = ptRoot->tRegion.tSize.iWidth;
+    COLOUR_INT *ptRow = (COLOUR_INT *)ptRoot->pchBuffer
+                      + tValidRegion.tLocation.iY * iStride
+                      + tValidRegion.tLocation.iX;
+    const uint32_t *pwBits = &ptEntry->wRows[tOffset.iY];
+
+    /* only the set bits touch the PFB, a row is skipped a byte at a time */
+    for (int_fast16_t y = 0; y < iHeight; y++) {
+        uint32_t wBits = (*pwBits++ >> tOffset.iX) & wMask;
+        COLOUR_INT *ptPixel = ptRow;
+
+        while (0 != wBits) {
+            if (0 == (wBits & 0xFF)) {
+                wBits >>= 8;
+                ptPixel += 8;
+                continue;
+            }
+            if (wBits & 0x01) {
+                *ptPixel = tForeColour;
+            }
+            wBits >>= 1;
+            ptPixel++;
+        }
+
+        ptRow += iStride;
+    }
+
+    return arm_fsm_rt_cpl;
+}
+
+static
+IMPL_FONT_GET_CHAR_DESCRIPTOR(__glyph_cache_get_char_descriptor)
+{
+    glyph_cache_font_t *ptThis = (glyph_cache_font_t *)ptFont;
+
+    return ptThis->ptFont->fnGetCharDescriptor(ptThis->ptFont,
+                                               ptDescriptor,
+                                               pchCharCode);
+}
+
+arm_2d_font_t *glyph_cache_font_init(   glyph_cache_font_t *ptThis,
+                                        const arm_2d_font_t *ptFont)
+{
+    assert(NULL != ptThis);
+    assert(NULL != ptFont);
+    assert(NULL != ptFont->fnGetCharDescriptor);
+
+    arm_2d_tile_t *ptRoot = arm_2d_tile_get_root(&ptFont->tileFont, NULL, NULL);
+    if (    (NULL == ptRoot)
+        ||  (ARM_2D_COLOUR_1BIT == ptRoot->tInfo.tColourInfo.chScheme)) {
+        /* an A1 font is 1bpp already and its glyphs follow the display mode
+         * of arm_lcd_text, e.g. ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR
+         */
+        return (arm_2d_font_t *)ptFont;
+    }
+
+    ptThis->use_as__arm_2d_font_t = *ptFont;
+    ptThis->use_as__arm_2d_font_t.fnGetCharDescriptor
+        = &__glyph_cache_get_char_descriptor;
+    ptThis->use_as__arm_2d_font_t.fnDrawChar = &__glyph_cache_draw_char;
+    ptThis->ptFont = ptFont;
+
+    return &ptThis->use_as__arm_2d_font_t;
+}
+
+void glyph_cache_get_info(glyph_cache_info_t *ptInfo)
+{
+    assert(NULL != ptInfo);
+    *ptInfo = s_tGlyphCache.tInfo;
+}
+
+void glyph_cache_dump_info(void)
+{
+    glyph_cache_info_t *ptInfo = &s_tGlyphCache.tInfo;
+    uint32_t wLookups = ptInfo->wHits + ptInfo->wMisses;
+
+    if (0 == wLookups + ptInfo->wBypasses) {
+        return ;
+    }
+
+    printf( "Glyph Cache: hit %"PRIu32" miss %"PRIu32" (%"PRIu32"%%) evict %"PRIu32
+            " bypass %"PRIu32"\r\n",
+            ptInfo->wHits,
+            ptInfo->wMisses,
+            (0 == wLookups) ? 0 : (uint32_t)(ptInfo->wHits * 100ull / wLookups),
+            ptInfo->wEvictions,
+            ptInfo->wBypasses);
+
+    memset(ptInfo, 0, sizeof(glyph_cache_info_t));
+}
+
+#else
+
+void glyph_cache_get_info(glyph_cache_info_t *ptInfo)
+{
+    assert(NULL != ptInfo);
+    memset(ptInfo, 0, sizeof(glyph_cache_info_t));
+}
+
+#endif
@@ -0,0 +1,106 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_GLYPH_CACHE_H__
+#define __BADGER_RP2040_GLYPH_CACHE_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "arm_2d_helper.h"
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+/* a cached glyph is a 32-bit word per row */
+#define GLYPH_CACHE_MAX_WIDTH       32
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_GLYPH_CACHE__
+#   define glyph_cache_font_init(__CACHED_FONT_PTR, __FONT_PTR)                 \
+            ((void)(__CACHED_FONT_PTR), (arm_2d_font_t *)(__FONT_PTR))
+#   define glyph_cache_dump_info()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief a font drawing its glyphs from the 1bpp glyph cache. It uses the
+ *        character descriptors of the wrapped font.
+ */
+typedef struct glyph_cache_font_t {
+    implement(arm_2d_font_t);
+    const arm_2d_font_t *ptFont;                //!< the wrapped font
+} glyph_cache_font_t;
+
+/*!
+ * \brief the statistics of the glyph cache
+ */
+typedef struct glyph_cache_info_t {
+    uint32_t wHits;                             //!< glyphs drawn from the cache
+    uint32_t wMisses;                           //!< glyphs rasterized into the cache
+    uint32_t wEvictions;                        //!< glyphs evicted to make room
+    uint32_t wBypasses;                         //!< glyphs drawn by blending, e.g. with opacity
+} glyph_cache_info_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_GLYPH_CACHE__
+/*!
+ * \brief wrap a font, so its glyphs are thresholded to 1bpp once and then
+ *        drawn from the cache, e.g. for arm_lcd_text_set_font() or a text box
+ * \note A2, A4 and A8 fonts are supported, an A1 font is returned as it is.
+ *       Glyphs wider than GLYPH_CACHE_MAX_WIDTH or taller than
+ *       __PLATFORM_CFG_GLYPH_CACHE_MAX_HEIGHT__, and glyphs drawn with an
+ *       opacity or a scale are blended as usual.
+ * \param[in] ptThis the wrapper, it must live as long as the font is used
+ * \param[in] ptFont the font to wrap
+ * \return arm_2d_font_t* the font to use, i.e. the wrapped font when the
+ *         glyph cache is disabled
+ */
+extern
+arm_2d_font_t *glyph_cache_font_init(   glyph_cache_font_t *ptThis,
+                                        const arm_2d_font_t *ptFont);
+
+/*!
+ * \brief print the statistics over stdio and clear them
+ */
+extern
+void glyph_cache_dump_info(void);
+#endif
+
+/*!
+ * \brief get the statistics of the glyph cache
+ * \param[out] ptInfo the statistics, all zero when the cache is disabled
+ */
+extern
+void glyph_cache_get_info(glyph_cache_info_t *ptInfo);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,230 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./idle_sleep.h"
+
+#if __PLATFORM_CFG_USE_IDLE_SLEEP__
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#endif
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+#if __PLATFORM_CFG_USE_IDLE_SLEEP__
+static
+struct {
+    int8_t chAlarm;
+    volatile bool bEvent;
+    volatile bool bBusyReleased;                //!< kept apart from bEvent
+    volatile bool bWaitForBusy;
+
+    bool bFrameDeadline;
+    int64_t lFrameDeadline;
+    int64_t lDeadline;
+
+    uint32_t wSleeps;
+    uint32_t wWakeups;
+    int64_t lSleepTicks;
+    int64_t lResetTimestamp;
+} s_tIdleSleep = {
+    .chAlarm = -1,
+    .lDeadline = INT64_MAX,
+};
+#endif
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_USE_IDLE_SLEEP__
+
+static void __idle_sleep_on_alarm(uint nAlarm)
+{
+    ARM_2D_UNUSED(nAlarm);
+
+    idle_sleep_notify();
+}
+
+void idle_sleep_init(void)
+{
+    s_tIdleSleep.chAlarm = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback(s_tIdleSleep.chAlarm, &__idle_sleep_on_alarm);
+
+    s_tIdleSleep.lResetTimestamp = get_system_ticks();
+}
+
+void idle_sleep_notify(void)
+{
+    s_tIdleSleep.bEvent = true;
+    __sev();
+}
+
+void idle_sleep_notify_busy_released(void)
+{
+    /* the edge only wakes idle_sleep_wait_for_busy(). It must not cut short
+     * the sleep between two frames, which usually starts while the panel is
+     * still refreshing.
+     */
+    s_tIdleSleep.bBusyReleased = true;
+    if (s_tIdleSleep.bWaitForBusy) {
+        __sev();
+    }
+}
+
+void idle_sleep_next_frame_in_ms(uint32_t wMS)
+{
+    int64_t lDeadline = get_system_ticks() + perfc_convert_ms_to_ticks(wMS);
+
+    if (!s_tIdleSleep.bFrameDeadline) {
+        s_tIdleSleep.bFrameDeadline = true;
+        s_tIdleSleep.lFrameDeadline = lDeadline;
+    } else {
+        s_tIdleSleep.lFrameDeadline = MIN(s_tIdleSleep.lFrameDeadline, lDeadline);
+    }
+}
+
+void idle_sleep_set_deadline(int64_t lTimestamp)
+{
+    s_tIdleSleep.lDeadline = MIN(s_tIdleSleep.lDeadline, lTimestamp);
+}
+
+/*!
+ * \brief sleep until the deadline or an event
+ * \note the events that arrive while the core is running are kept, so the
+ *       next sleep returns immediately and no wakeup is lost.
+ * \param[in] lDeadline the deadline in system ticks
+ * \param[in] bForBusy whether the release of the BUSY pin ends the sleep
+ */
+static bool __idle_sleep_until(int64_t lDeadline, bool bForBusy)
+{
+    int64_t lStart = get_system_ticks();
+    if (lDeadline <= lStart || s_tIdleSleep.chAlarm < 0) {
+        return false;
+    }
+
+    absolute_time_t tTarget = delayed_by_us(
+                                get_absolute_time(),
+                                perfc_convert_ticks_to_us(lDeadline - lStart));
+
+    if (hardware_alarm_set_target(s_tIdleSleep.chAlarm, tTarget)) {
+        /* the deadline has already passed */
+        return false;
+    }
+
+    while(true) {
+        if (bForBusy && s_tIdleSleep.bBusyReleased) {
+            /* leave bEvent to the next sleep */
+            break;
+        }
+        if (s_tIdleSleep.bEvent) {
+            s_tIdleSleep.bEvent = false;
+            break;
+        }
+        __wfe();
+        s_tIdleSleep.wWakeups++;
+    }
+
+    hardware_alarm_cancel(s_tIdleSleep.chAlarm);
+
+    s_tIdleSleep.wSleeps++;
+    s_tIdleSleep.lSleepTicks += get_system_ticks() - lStart;
+
+    return true;
+}
+
+void idle_sleep_wait(void)
+{
+    if (s_tIdleSleep.bFrameDeadline) {
+        __idle_sleep_until(MIN(   s_tIdleSleep.lFrameDeadline, 
+                                  s_tIdleSleep.lDeadline),
+                           false);
+    }
+
+    s_tIdleSleep.bFrameDeadline = false;
+    s_tIdleSleep.lDeadline = INT64_MAX;
+}
+
+void idle_sleep_wait_for_busy(void)
+{
+    int64_t lDeadline = get_system_ticks() 
+                      + perfc_convert_ms_to_ticks(
+                            __PLATFORM_CFG_IDLE_SLEEP_BUSY_TIMEOUT__);
+
+    /* raise the flag before reading the pin, so an edge in between is seen */
+    s_tIdleSleep.bBusyReleased = false;
+    s_tIdleSleep.bWaitForBusy = true;
+
+    if (epd_screen_is_busy()) {
+        __idle_sleep_until(lDeadline, true);
+    }
+
+    s_tIdleSleep.bWaitForBusy = false;
+}
+
+void idle_sleep_get_info(idle_sleep_info_t *ptInfo)
+{
+    assert(NULL != ptInfo);
+
+    *ptInfo = (idle_sleep_info_t) {
+        .wSleeps = s_tIdleSleep.wSleeps,
+        .wWakeups = s_tIdleSleep.wWakeups,
+        .lSleepTicks = s_tIdleSleep.lSleepTicks,
+        .lTotalTicks = get_system_ticks() - s_tIdleSleep.lResetTimestamp,
+    };
+}
+
+void idle_sleep_dump_info(void)
+{
+    idle_sleep_info_t tInfo;
+    idle_sleep_get_info(&tInfo);
+
+    int32_t nSleepRatio = 0;
+    if (tInfo.lTotalTicks > 0) {
+        nSleepRatio = (int32_t)((tInfo.lSleepTicks * 100) / tInfo.lTotalTicks);
+    }
+
+    printf( "[idle sleep] %"PRIu32" sleeps, %"PRIu32" wakeups, "
+            "slept %"PRIu32"ms of %"PRIu32"ms (%d%%)\r\n",
+            tInfo.wSleeps,
+            tInfo.wWakeups,
+            (uint32_t)perfc_convert_ticks_to_ms(tInfo.lSleepTicks),
+            (uint32_t)perfc_convert_ticks_to_ms(tInfo.lTotalTicks),
+            (int)nSleepRatio);
+
+    s_tIdleSleep.wSleeps = 0;
+    s_tIdleSleep.wWakeups = 0;
+    s_tIdleSleep.lSleepTicks = 0;
+    s_tIdleSleep.lResetTimestamp = get_system_ticks();
+}
+
+#else
+
+void idle_sleep_next_frame_in_ms(uint32_t wMS)
+{
+    ARM_2D_UNUSED(wMS);
+}
+
+#endif
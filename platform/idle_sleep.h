@@ -0,0 +1,141 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_IDLE_SLEEP_H__
+#define __BADGER_RP2040_IDLE_SLEEP_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_IDLE_SLEEP__
+#   define idle_sleep_init()
+#   define idle_sleep_notify()
+#   define idle_sleep_notify_busy_released()
+#   define idle_sleep_set_deadline(__TIMESTAMP)     ((void)(__TIMESTAMP))
+#   define idle_sleep_wait()
+#   define idle_sleep_wait_for_busy()
+#   define idle_sleep_dump_info()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the statistics of the idle sleep
+ */
+typedef struct idle_sleep_info_t {
+    uint32_t wSleeps;                           //!< the number of sleeps
+    uint32_t wWakeups;                          //!< the number of WFE wakeups
+    int64_t lSleepTicks;                        //!< the time spent in sleep
+    int64_t lTotalTicks;                        //!< the time since the last reset
+} idle_sleep_info_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+/*!
+ * \brief declare that the current scene does not need a new frame within the
+ *        given time. It is usually called in the fnOnFrameStart of a scene.
+ * \note the main loop sleeps between frames only after a scene declares the
+ *       deadline of its next frame. If it is called more than once in a
+ *       frame, the earliest deadline wins.
+ * \note it is available even when __PLATFORM_CFG_USE_IDLE_SLEEP__ is 0
+ * \param[in] wMS the time to the next frame in ms
+ */
+extern
+void idle_sleep_next_frame_in_ms(uint32_t wMS);
+
+#if __PLATFORM_CFG_USE_IDLE_SLEEP__
+
+/*!
+ * \brief claim the hardware alarm used for the wakeups
+ */
+extern
+void idle_sleep_init(void);
+
+/*!
+ * \brief wake up the main loop, e.g. from the interrupt handler of a DMA
+ *        completion or an input event
+ * \note it is safe to call it from interrupt handlers
+ */
+extern
+void idle_sleep_notify(void);
+
+/*!
+ * \brief report the release of the BUSY pin of the EPD
+ * \note unlike idle_sleep_notify(), it only wakes idle_sleep_wait_for_busy()
+ *       and is ignored by the sleep between frames.
+ * \note it is safe to call it from interrupt handlers
+ */
+extern
+void idle_sleep_notify_busy_released(void);
+
+/*!
+ * \brief declare a deadline the main loop must wake up for, e.g. the timeout
+ *        of the current scene in the playlist
+ * \note the deadline is only valid for the next idle_sleep_wait()
+ * \param[in] lTimestamp the deadline in system ticks
+ */
+extern
+void idle_sleep_set_deadline(int64_t lTimestamp);
+
+/*!
+ * \brief sleep until the earliest deadline or an event. It is called by the
+ *        main loop after a frame is complete.
+ * \note the core does not sleep when no scene declared the deadline of the
+ *       next frame.
+ */
+extern
+void idle_sleep_wait(void);
+
+/*!
+ * \brief sleep until the release of the BUSY pin, an event or the timeout
+ *        __PLATFORM_CFG_IDLE_SLEEP_BUSY_TIMEOUT__
+ */
+extern
+void idle_sleep_wait_for_busy(void);
+
+/*!
+ * \brief get the statistics since the last reset
+ * \param[out] ptInfo the statistics
+ */
+extern
+void idle_sleep_get_info(idle_sleep_info_t *ptInfo);
+
+/*!
+ * \brief print the statistics and reset them
+ */
+extern
+void idle_sleep_dump_info(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
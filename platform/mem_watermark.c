@@ -0,0 +1,247 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./mem_watermark.h"
+
+#if __PLATFORM_CFG_USE_MEM_WATERMARK__
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+#define MEM_WATERMARK_STACK_PATTERN         0x5AA5A55Aul
+
+/* the words right below the stack pointer that are never painted, they 
+ * cover the frame of the painting itself and a pending exception
+ */
+#define MEM_WATERMARK_STACK_GUARD           16
+
+/* the granularity of the largest free block probing */
+#define MEM_WATERMARK_HEAP_PROBE_STEP       64
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+/* keeps the 8 bytes alignment of malloc() */
+typedef union __mem_watermark_heap_header_t {
+    uint32_t wSize;
+    uint64_t dwAlign;
+} __mem_watermark_heap_header_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+
+extern uint32_t Image$$ARM_LIB_STACK$$ZI$$Base[];
+extern uint32_t Image$$ARM_LIB_STACK$$ZI$$Limit[];
+extern uint8_t Image$$ARM_LIB_HEAP$$ZI$$Base[];
+extern uint8_t Image$$ARM_LIB_HEAP$$ZI$$Limit[];
+
+/*============================ LOCAL VARIABLES ===============================*/
+
+static
+struct {
+    uint32_t wStackPeak;
+    uint32_t wHeapCurrent;
+    uint32_t wHeapPeak;
+    uint16_t hwFrameCounter;
+} s_tMemWatermark;
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+static uint32_t __mem_watermark_stack_size(void)
+{
+    return (uintptr_t)Image$$ARM_LIB_STACK$$ZI$$Limit 
+         - (uintptr_t)Image$$ARM_LIB_STACK$$ZI$$Base;
+}
+
+static uint32_t __mem_watermark_heap_size(void)
+{
+    return (uintptr_t)Image$$ARM_LIB_HEAP$$ZI$$Limit 
+         - (uintptr_t)Image$$ARM_LIB_HEAP$$ZI$$Base;
+}
+
+/*!
+ * \brief paint the stack from the bottom to the current stack pointer
+ * \note it must stay a leaf function, so its own frame is covered by the guard
+ */
+__attribute__((noinline))
+static void __mem_watermark_paint_stack(void)
+{
+    uint32_t *pwWord = Image$$ARM_LIB_STACK$$ZI$$Base;
+    uint32_t *pwEnd = (uint32_t *)__builtin_frame_address(0)
+                    - MEM_WATERMARK_STACK_GUARD;
+
+    while (pwWord < pwEnd) {
+        *pwWord++ = MEM_WATERMARK_STACK_PATTERN;
+    }
+}
+
+static uint32_t __mem_watermark_scan_stack(void)
+{
+    const uint32_t *pwWord = Image$$ARM_LIB_STACK$$ZI$$Base;
+    const uint32_t *pwLimit = Image$$ARM_LIB_STACK$$ZI$$Limit;
+
+    /* the stack grows downwards, the first touched word is the high-water */
+    while (pwWord < pwLimit && MEM_WATERMARK_STACK_PATTERN == *pwWord) {
+        pwWord++;
+    }
+
+    return (uintptr_t)pwLimit - (uintptr_t)pwWord;
+}
+
+void mem_watermark_init(void)
+{
+    __mem_watermark_paint_stack();
+    s_tMemWatermark.wStackPeak = __mem_watermark_scan_stack();
+}
+
+void *mem_watermark_heap_alloc(size_t tSize)
+{
+    __mem_watermark_heap_header_t *ptHeader 
+        = malloc(sizeof(__mem_watermark_heap_header_t) + tSize);
+
+    if (NULL == ptHeader) {
+        return NULL;
+    }
+    ptHeader->wSize = tSize;
+
+    __IRQ_SAFE {
+        s_tMemWatermark.wHeapCurrent += tSize;
+        s_tMemWatermark.wHeapPeak = MAX( s_tMemWatermark.wHeapPeak, 
+                                         s_tMemWatermark.wHeapCurrent);
+    }
+
+    return ptHeader + 1;
+}
+
+void mem_watermark_heap_free(void *pBuffer)
+{
+    if (NULL == pBuffer) {
+        return ;
+    }
+
+    __mem_watermark_heap_header_t *ptHeader 
+        = (__mem_watermark_heap_header_t *)pBuffer - 1;
+
+    __IRQ_SAFE {
+        assert(s_tMemWatermark.wHeapCurrent >= ptHeader->wSize);
+        s_tMemWatermark.wHeapCurrent -= ptHeader->wSize;
+    }
+
+    free(ptHeader);
+}
+
+void mem_watermark_on_frame_complete(void)
+{
+#if __PLATFORM_CFG_MEM_WATERMARK_SCAN_PERIOD__ > 0
+    if (++s_tMemWatermark.hwFrameCounter < __PLATFORM_CFG_MEM_WATERMARK_SCAN_PERIOD__) {
+        return ;
+    }
+    s_tMemWatermark.hwFrameCounter = 0;
+
+    uint32_t wStackPeak = __mem_watermark_scan_stack();
+    if (wStackPeak <= s_tMemWatermark.wStackPeak) {
+        return ;
+    }
+    s_tMemWatermark.wStackPeak = wStackPeak;
+
+    ARM_2D_LOG_INFO(
+        STATISTICS, 
+        0, 
+        "MEM_WATERMARK", 
+        "Stack:%"PRIu32"/%"PRIu32"\tHeap:%"PRIu32"(peak %"PRIu32")",
+        wStackPeak,
+        __mem_watermark_stack_size(),
+        s_tMemWatermark.wHeapCurrent,
+        s_tMemWatermark.wHeapPeak
+    );
+#endif
+}
+
+static uint32_t __mem_watermark_probe_largest_free(uint32_t wUpperBound)
+{
+    uint32_t wLow = 0;
+    uint32_t wHigh = wUpperBound;
+
+    /* binary search the biggest request malloc() can still serve */
+    while (wHigh - wLow > MEM_WATERMARK_HEAP_PROBE_STEP) {
+        uint32_t wSize = wLow + (wHigh - wLow) / 2;
+        void *pBuffer = malloc(wSize);
+        if (NULL != pBuffer) {
+            free(pBuffer);
+            wLow = wSize;
+        } else {
+            wHigh = wSize;
+        }
+    }
+
+    return wLow;
+}
+
+void mem_watermark_get_info(mem_watermark_info_t *ptInfo)
+{
+    assert(NULL != ptInfo);
+
+    s_tMemWatermark.wStackPeak = MAX(   s_tMemWatermark.wStackPeak, 
+                                        __mem_watermark_scan_stack());
+
+    uint32_t wHeapSize = __mem_watermark_heap_size();
+    uint32_t wHeapFree = wHeapSize - MIN(wHeapSize, s_tMemWatermark.wHeapCurrent);
+    uint32_t wLargestFree = __mem_watermark_probe_largest_free(wHeapFree);
+
+    *ptInfo = (mem_watermark_info_t) {
+        .wStackSize = __mem_watermark_stack_size(),
+        .wStackPeak = s_tMemWatermark.wStackPeak,
+
+        .wHeapSize = wHeapSize,
+        .wHeapCurrent = s_tMemWatermark.wHeapCurrent,
+        .wHeapPeak = s_tMemWatermark.wHeapPeak,
+        .wHeapLargestFree = wLargestFree,
+        .chFragmentationEstimate 
+            = (0 == wHeapFree) 
+            ? 0
+            : 100 - (uint8_t)(((uint64_t)wLargestFree * 100) / wHeapFree),
+    };
+}
+
+void mem_watermark_dump_scene(void)
+{
+    mem_watermark_info_t tInfo;
+    mem_watermark_get_info(&tInfo);
+
+    printf( "[watermark] stack %"PRIu32"/%"PRIu32" bytes, "
+            "heap %"PRIu32"(peak %"PRIu32")/%"PRIu32" bytes, "
+            "largest free %"PRIu32", fragmentation ~%d%%\r\n",
+            tInfo.wStackPeak,
+            tInfo.wStackSize,
+            tInfo.wHeapCurrent,
+            tInfo.wHeapPeak,
+            tInfo.wHeapSize,
+            tInfo.wHeapLargestFree,
+            tInfo.chFragmentationEstimate);
+
+    /* start the measurement window of the next scene */
+    __mem_watermark_paint_stack();
+    s_tMemWatermark.wStackPeak = __mem_watermark_scan_stack();
+    s_tMemWatermark.wHeapPeak = s_tMemWatermark.wHeapCurrent;
+}
+
+#endif
@@ -0,0 +1,124 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_MEM_WATERMARK_H__
+#define __BADGER_RP2040_MEM_WATERMARK_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_MEM_WATERMARK__
+#   define mem_watermark_init()
+#   define mem_watermark_heap_alloc(__SIZE)     malloc(__SIZE)
+#   define mem_watermark_heap_free(__PTR)       free(__PTR)
+#   define mem_watermark_on_frame_complete()
+#   define mem_watermark_dump_scene()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the stack and heap usage
+ */
+typedef struct mem_watermark_info_t {
+    uint32_t wStackSize;                        //!< the size of the main stack
+    uint32_t wStackPeak;                        //!< the high-water mark of the main stack
+
+    uint32_t wHeapSize;                         //!< the size of the heap region
+    uint32_t wHeapCurrent;                      //!< bytes allocated via mem_watermark_heap_alloc()
+    uint32_t wHeapPeak;                         //!< the peak of wHeapCurrent
+    uint32_t wHeapLargestFree;                  //!< the largest block the heap can serve
+
+    /*! 0~100%, 1 - largest free / total free. It is an estimate: the total 
+     *  free is the heap region minus wHeapCurrent, i.e. it ignores other 
+     *  malloc() users and the block headers of the C library, and the largest
+     *  free block is probed in steps of 64 bytes.
+     */
+    uint8_t  chFragmentationEstimate;
+} mem_watermark_info_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_MEM_WATERMARK__
+
+/*!
+ * \brief paint the unused part of the main stack
+ * \note please call it as early as possible
+ */
+extern
+void mem_watermark_init(void);
+
+/*!
+ * \brief allocate memory from the heap and count it
+ * \note the memory is 8 bytes aligned as malloc()
+ * \param[in] tSize the size in bytes
+ * \return void* the memory, NULL means the heap is exhausted
+ */
+extern
+void *mem_watermark_heap_alloc(size_t tSize);
+
+/*!
+ * \brief free the memory allocated by mem_watermark_heap_alloc()
+ * \param[in] pBuffer the memory
+ */
+extern
+void mem_watermark_heap_free(void *pBuffer);
+
+/*!
+ * \brief scan the stack every __PLATFORM_CFG_MEM_WATERMARK_SCAN_PERIOD__ 
+ *        frames and log a new high-water mark to the STATISTICS channel
+ */
+extern
+void mem_watermark_on_frame_complete(void);
+
+/*!
+ * \brief get the stack and heap usage since the last scene switching
+ * \note the largest free heap block is probed with malloc(), please do NOT
+ *       call it during the rendering.
+ * \param[out] ptInfo the usage
+ */
+extern
+void mem_watermark_get_info(mem_watermark_info_t *ptInfo);
+
+/*!
+ * \brief print the stack and heap usage of the scene which is being switched
+ *        out and start a new measurement window, i.e. repaint the stack and
+ *        reset the heap peak.
+ */
+extern
+void mem_watermark_dump_scene(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,165 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./mono_film.h"
+
+#include <string.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+/* the frames are padded to 4 bytes, i.e. their headers are aligned */
+#define __MONO_FILM_FRAME_STRIDE(__FRAME_PTR)                                   \
+            (sizeof(mono_film_frame_header_t)                                   \
+            + (((__FRAME_PTR)->hwSize + 3) & ~3ul))
+
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_USE_MONO_FILM__
+bool mono_film_open(mono_film_t *ptThis)
+{
+    assert(NULL != ptThis);
+
+    const mono_film_blob_header_t *ptHeader
+        = (const mono_film_blob_header_t *)__PLATFORM_CFG_MONO_FILM_ADDRESS__;
+
+    /* an erased flash reads 0xFFFFFFFF */
+    if (    (MONO_FILM_BLOB_MAGIC != ptHeader->wMagic)
+        ||  (ptHeader->wSize > __PLATFORM_CFG_MONO_FILM_SIZE__
+                             - sizeof(mono_film_blob_header_t))
+        ||  (0 == ptHeader->hwWidth)
+        ||  (0 == ptHeader->hwHeight)
+        ||  (0 == ptHeader->hwFrameCount)) {
+        return false;
+    }
+
+    /* all frames are in the blob and the film starts with a key frame */
+    const uint8_t *pchFrame = (const uint8_t *)(ptHeader + 1);
+    const uint8_t *pchEnd = pchFrame + ptHeader->wSize;
+
+    for (uint_fast16_t n = 0; n < ptHeader->hwFrameCount; n++) {
+        const mono_film_frame_header_t *ptFrame 
+            = (const mono_film_frame_header_t *)pchFrame;
+
+        if (    (pchEnd - pchFrame < (ptrdiff_t)sizeof(mono_film_frame_header_t))
+            ||  (pchEnd - pchFrame < (ptrdiff_t)__MONO_FILM_FRAME_STRIDE(ptFrame))
+            ||  (0 == n && MONO_FILM_FRAME_KEY != ptFrame->chType)) {
+            return false;
+        }
+        pchFrame += __MONO_FILM_FRAME_STRIDE(ptFrame);
+    }
+
+    *ptThis = (mono_film_t) {
+        .ptHeader = ptHeader,
+        .pchNext = (const uint8_t *)(ptHeader + 1),
+    };
+
+    return true;
+}
+#endif
+
+size_t mono_film_get_frame_size(mono_film_t *ptThis)
+{
+    assert(NULL != ptThis);
+    assert(NULL != ptThis->ptHeader);
+
+    return ((ptThis->ptHeader->hwWidth + 7) >> 3) * ptThis->ptHeader->hwHeight;
+}
+
+static void __mono_film_rewind(mono_film_t *ptThis)
+{
+    ptThis->pchNext = (const uint8_t *)(ptThis->ptHeader + 1);
+    ptThis->hwFrame = 0;
+}
+
+bool __platform_time_critical_func(mono_film_decode_next_frame)(
+                                                    mono_film_t *ptThis,
+                                                    uint8_t *pchFrame)
+{
+    assert(NULL != ptThis);
+    assert(NULL != ptThis->ptHeader);
+    assert(NULL != pchFrame);
+
+    const mono_film_frame_header_t *ptFrame 
+        = (const mono_film_frame_header_t *)ptThis->pchNext;
+    const uint8_t *pchSource = (const uint8_t *)(ptFrame + 1);
+    const uint8_t *pchSourceEnd = pchSource + ptFrame->hwSize;
+    uint8_t *pchTarget = pchFrame;
+    uint8_t *pchTargetEnd = pchFrame + mono_film_get_frame_size(ptThis);
+    bool bDelta = (MONO_FILM_FRAME_DELTA == ptFrame->chType);
+
+    while (pchSource < pchSourceEnd) {
+        uint_fast8_t chControl = *pchSource++;
+
+        if (chControl < 0x80) {
+            /* literal bytes */
+            uint_fast8_t chCount = chControl + 1;
+            if (    (pchSourceEnd - pchSource < chCount)
+                ||  (pchTargetEnd - pchTarget < chCount)) {
+                break;
+            }
+
+            if (bDelta) {
+                do {
+                    *pchTarget++ ^= *pchSource++;
+                } while(--chCount);
+            } else {
+                memcpy(pchTarget, pchSource, chCount);
+                pchTarget += chCount;
+                pchSource += chCount;
+            }
+        } else {
+            /* a run of the same byte */
+            uint_fast8_t chCount = chControl - 0x7F;
+            if (    (pchSource >= pchSourceEnd)
+                ||  (pchTargetEnd - pchTarget < chCount)) {
+                break;
+            }
+
+            uint8_t chValue = *pchSource++;
+            if (!bDelta) {
+                memset(pchTarget, chValue, chCount);
+            } else if (0 != chValue) {
+                for (uint_fast8_t n = 0; n < chCount; n++) {
+                    pchTarget[n] ^= chValue;
+                }
+            }
+            pchTarget += chCount;
+        }
+    }
+
+    if (pchSource != pchSourceEnd || pchTarget != pchTargetEnd) {
+        /* start over from the key frame */
+        __mono_film_rewind(ptThis);
+        return false;
+    }
+
+    if (++ptThis->hwFrame >= ptThis->ptHeader->hwFrameCount) {
+        __mono_film_rewind(ptThis);
+    } else {
+        ptThis->pchNext += __MONO_FILM_FRAME_STRIDE(ptFrame);
+    }
+
+    return true;
+}
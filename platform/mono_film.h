@@ -0,0 +1,124 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_MONO_FILM_H__
+#define __BADGER_RP2040_MONO_FILM_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+/* the film format, please keep tools/film_pack.py in sync */
+#define MONO_FILM_BLOB_MAGIC            0x314D4C46ul        /* "FLM1" */
+
+#define MONO_FILM_FRAME_KEY             0       //!< the frame replaces the previous one
+#define MONO_FILM_FRAME_DELTA           1       //!< the frame is XORed onto the previous one
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_MONO_FILM__
+#   define mono_film_open(__FILM_PTR)       ((void)(__FILM_PTR), false)
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the header of a film, followed by the frames (16 bytes)
+ * \note a frame is packed in the 1bpp format of arm-2d, i.e. byte aligned
+ *       rows with the leftmost pixel in the least significant bit. A set bit
+ *       is black.
+ */
+typedef struct mono_film_blob_header_t {
+    uint32_t wMagic;
+    uint32_t wSize;                             //!< the size of the frames
+    uint16_t hwWidth;
+    uint16_t hwHeight;
+    uint16_t hwFrameCount;
+    uint16_t hwPeriod;                          //!< the period of a frame in ms
+} mono_film_blob_header_t;
+
+/*!
+ * \brief the header of a frame, followed by the run-length encoded bytes of
+ *        the packed frame and padded to 4 bytes (4 bytes)
+ * \note a control byte N < 0x80 is followed by N + 1 literal bytes, and a
+ *       control byte N >= 0x80 is followed by one byte repeated N - 0x7F
+ *       times. For a delta frame, a run of 0x00 leaves the bytes untouched.
+ */
+typedef struct mono_film_frame_header_t {
+    uint16_t hwSize;                            //!< the size of the encoded bytes
+    uint8_t chType;                             //!< MONO_FILM_FRAME_xxxx
+    uint8_t chReserved;
+} mono_film_frame_header_t;
+
+/*!
+ * \brief a player of the film in flash
+ */
+typedef struct mono_film_t {
+    const mono_film_blob_header_t *ptHeader;
+    const uint8_t *pchNext;                     //!< the header of the next frame
+    uint16_t hwFrame;                           //!< the index of the next frame
+} mono_film_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_MONO_FILM__
+/*!
+ * \brief open the film at __PLATFORM_CFG_MONO_FILM_ADDRESS__
+ * \param[out] ptThis the player
+ * \retval true a valid film is found
+ * \retval false no film, e.g. the flash is erased
+ */
+extern
+bool mono_film_open(mono_film_t *ptThis);
+#endif
+
+/*!
+ * \brief get the size of a decoded frame
+ * \param[in] ptThis the player
+ * \return size_t the size in bytes
+ */
+extern
+size_t mono_film_get_frame_size(mono_film_t *ptThis);
+
+/*!
+ * \brief decode the next frame, the film restarts after the last frame
+ * \note a delta frame needs the previous frame in the buffer, i.e. the
+ *       buffer must be kept between two calls
+ * \param[in] ptThis the player
+ * \param[in,out] pchFrame the frame buffer of mono_film_get_frame_size() bytes
+ * \retval true the frame is decoded
+ * \retval false the frame is corrupted, the film is rewound
+ */
+extern
+bool mono_film_decode_next_frame(mono_film_t *ptThis, uint8_t *pchFrame);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
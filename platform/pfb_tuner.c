@@ -0,0 +1,266 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+#include "./pfb_tuner.h"
+
+#if __PLATFORM_CFG_USE_PFB_TUNER__
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+#include "arm_2d_helper.h"
+#include "arm_2d_disp_adapters.h"
+#include "perf_counter.h"
+
+/*============================ MACROS ========================================*/
+
+/* frames ignored after a geometry change, e.g. the first frame of a scene */
+#ifndef PFB_TUNER_WARM_UP_FRAMES
+#   define PFB_TUNER_WARM_UP_FRAMES     2
+#endif
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+typedef struct __pfb_tuner_result_t {
+    int64_t lTotalCycles;
+    uint16_t hwFrames;
+} __pfb_tuner_result_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+/*!
+ * \brief the PFB geometry variants. The width should be a multiple of 8 for the
+ *        EPD driver. Text-heavy scenes usually prefer wide bands, while 
+ *        transform-heavy scenes prefer square blocks.
+ */
+static const arm_2d_size_t c_tPFBGeometries[] = {
+    {__DISP0_CFG_PFB_BLOCK_WIDTH__, __DISP0_CFG_PFB_BLOCK_HEIGHT__},
+    {__DISP0_CFG_PFB_BLOCK_WIDTH__, __DISP0_CFG_PFB_BLOCK_HEIGHT__ >> 1},
+    {144, 32},
+    {72, 64},
+};
+
+static
+struct {
+    uint8_t chProfile[__PLATFORM_CFG_PFB_TUNER_SCENE_COUNT__];
+    uint8_t chCurrent;
+    bool bInitialized;
+    bool bPending;                              //!< chCurrent is not applied yet
+
+#if __PLATFORM_CFG_PFB_TUNER_CALIBRATE__
+    struct {
+        uint8_t chSceneID;
+        uint8_t chVariant;
+        uint8_t chWarmUp;
+        bool bCalibrating;
+
+        __pfb_tuner_result_t tResults[dimof(c_tPFBGeometries)];
+    } Calibration;
+#endif
+
+} s_tPFBTuner = {
+    .chProfile = __PLATFORM_CFG_PFB_TUNER_PROFILE__,
+};
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+static bool __pfb_tuner_is_variant_valid(uint_fast8_t chVariant)
+{
+    if (chVariant >= dimof(c_tPFBGeometries)) {
+        return false;
+    }
+
+    const arm_2d_size_t *ptSize = &c_tPFBGeometries[chVariant];
+    if (ptSize->iWidth <= 0 || ptSize->iHeight <= 0) {
+        return false;
+    }
+
+    uint32_t wBufferSize = (uint32_t)ptSize->iWidth 
+                         * (uint32_t)ptSize->iHeight
+                         * (__DISP0_CFG_COLOUR_DEPTH__ >> 3);
+
+    return wBufferSize <= disp_adapter0_get_pfb_buffer_size();
+}
+
+/*!
+ * \brief select a PFB geometry, it is applied by pfb_tuner_task() between two
+ *        frames, as the PFB helper cannot be initialised again in its own
+ *        callbacks
+ */
+static void __pfb_tuner_apply(uint_fast8_t chVariant)
+{
+    if (!__pfb_tuner_is_variant_valid(chVariant)) {
+        chVariant = 0;
+    }
+
+    if (chVariant != s_tPFBTuner.chCurrent) {
+        s_tPFBTuner.chCurrent = chVariant;
+        s_tPFBTuner.bPending = true;
+    }
+}
+
+void pfb_tuner_init(void)
+{
+    /* disp_adapter0_init() starts with the first variant */
+    s_tPFBTuner.chCurrent = 0;
+    s_tPFBTuner.bPending = false;
+    s_tPFBTuner.bInitialized = true;
+}
+
+bool pfb_tuner_task(void)
+{
+    if (!s_tPFBTuner.bPending) {
+        return false;
+    }
+    s_tPFBTuner.bPending = false;
+
+    return disp_adapter0_set_pfb_size(c_tPFBGeometries[s_tPFBTuner.chCurrent]);
+}
+
+arm_2d_size_t pfb_tuner_get_geometry(void)
+{
+    return c_tPFBGeometries[s_tPFBTuner.chCurrent];
+}
+
+#if __PLATFORM_CFG_PFB_TUNER_CALIBRATE__
+static void __pfb_tuner_calibration_start_variant(uint_fast8_t chVariant)
+{
+    /* skip the variants that do not fit into the PFB pool */
+    while(  chVariant < dimof(c_tPFBGeometries) 
+        &&  !__pfb_tuner_is_variant_valid(chVariant)) {
+        chVariant++;
+    }
+
+    s_tPFBTuner.Calibration.chVariant = chVariant;
+    s_tPFBTuner.Calibration.chWarmUp = PFB_TUNER_WARM_UP_FRAMES;
+
+    if (chVariant < dimof(c_tPFBGeometries)) {
+        __pfb_tuner_apply(chVariant);
+    }
+}
+
+static void __pfb_tuner_calibration_report(void)
+{
+    uint_fast8_t chSceneID = s_tPFBTuner.Calibration.chSceneID;
+    uint_fast8_t chWinner = s_tPFBTuner.chProfile[chSceneID];
+    int64_t lBest = INT64_MAX;
+
+    printf("[pfb tuner] scene %d:\r\n", (int)chSceneID);
+
+    for (uint_fast8_t n = 0; n < dimof(c_tPFBGeometries); n++) {
+        __pfb_tuner_result_t *ptResult = &s_tPFBTuner.Calibration.tResults[n];
+        if (0 == ptResult->hwFrames) {
+            continue;
+        }
+
+        int64_t lAverage = ptResult->lTotalCycles / ptResult->hwFrames;
+
+        printf( "    %3dx%-3d %8"PRId32"us per frame, %6"PRIu32" bytes PFB\r\n",
+                c_tPFBGeometries[n].iWidth,
+                c_tPFBGeometries[n].iHeight,
+                (int32_t)perfc_convert_ticks_to_us(lAverage),
+                (uint32_t)c_tPFBGeometries[n].iWidth 
+                    * (uint32_t)c_tPFBGeometries[n].iHeight
+                    * (__DISP0_CFG_COLOUR_DEPTH__ >> 3));
+
+        /* prefer the smaller PFB when the frame time is about the same */
+        if (lAverage * 32 < lBest * 31) {
+            lBest = lAverage;
+            chWinner = n;
+        }
+    }
+
+    s_tPFBTuner.chProfile[chSceneID] = chWinner;
+
+    printf( "    winner: %dx%d\r\n"
+            "[pfb tuner] profile: {",
+            c_tPFBGeometries[chWinner].iWidth,
+            c_tPFBGeometries[chWinner].iHeight);
+    for (uint_fast8_t n = 0; n < dimof(s_tPFBTuner.chProfile); n++) {
+        printf("%s%d", n ? ", " : "", (int)s_tPFBTuner.chProfile[n]);
+    }
+    printf("}\r\n");
+}
+#endif
+
+void pfb_tuner_set_scene(uint_fast8_t chSceneID)
+{
+    if (!s_tPFBTuner.bInitialized) {
+        return ;
+    }
+    if (chSceneID >= __PLATFORM_CFG_PFB_TUNER_SCENE_COUNT__) {
+        __pfb_tuner_apply(0);
+        return ;
+    }
+
+#if __PLATFORM_CFG_PFB_TUNER_CALIBRATE__
+    if (s_tPFBTuner.Calibration.bCalibrating) {
+        /* the previous scene is switched out before the sweep completes */
+        __pfb_tuner_calibration_report();
+    }
+
+    memset(&s_tPFBTuner.Calibration, 0, sizeof(s_tPFBTuner.Calibration));
+    s_tPFBTuner.Calibration.chSceneID = chSceneID;
+    s_tPFBTuner.Calibration.bCalibrating = true;
+
+    __pfb_tuner_calibration_start_variant(0);
+#else
+    __pfb_tuner_apply(s_tPFBTuner.chProfile[chSceneID]);
+#endif
+}
+
+void pfb_tuner_on_frame_complete(int32_t nFrameCycles)
+{
+#if __PLATFORM_CFG_PFB_TUNER_CALIBRATE__
+    if (!s_tPFBTuner.Calibration.bCalibrating) {
+        return ;
+    }
+
+    if (s_tPFBTuner.Calibration.chWarmUp > 0) {
+        s_tPFBTuner.Calibration.chWarmUp--;
+        return ;
+    }
+
+    __pfb_tuner_result_t *ptResult 
+        = &s_tPFBTuner.Calibration.tResults[s_tPFBTuner.Calibration.chVariant];
+
+    ptResult->lTotalCycles += nFrameCycles;
+    if (++ptResult->hwFrames < __PLATFORM_CFG_PFB_TUNER_CALIBRATE_FRAMES__) {
+        return ;
+    }
+
+    /* move to the next variant */
+    __pfb_tuner_calibration_start_variant(s_tPFBTuner.Calibration.chVariant + 1);
+
+    if (s_tPFBTuner.Calibration.chVariant >= dimof(c_tPFBGeometries)) {
+        s_tPFBTuner.Calibration.bCalibrating = false;
+
+        __pfb_tuner_calibration_report();
+        __pfb_tuner_apply(s_tPFBTuner.chProfile[s_tPFBTuner.Calibration.chSceneID]);
+    }
+#else
+    ARM_2D_UNUSED(nFrameCycles);
+#endif
+}
+
+#endif
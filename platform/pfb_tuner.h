@@ -0,0 +1,100 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_PFB_TUNER_H__
+#define __BADGER_RP2040_PFB_TUNER_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "arm_2d_helper.h"
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_PFB_TUNER__
+#   define pfb_tuner_init()
+#   define pfb_tuner_task()                         (false)
+#   define pfb_tuner_set_scene(__ID)
+#   define pfb_tuner_on_frame_complete(__FRAME_CYCLES)
+#endif
+
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_PFB_TUNER__
+
+/*!
+ * \brief initialise the PFB tuner after disp_adapter0_init()
+ * \note the PFB geometry variants must fit into the PFB blocks of the display
+ *       adapter, variants that do not fit are ignored.
+ */
+extern
+void pfb_tuner_init(void);
+
+/*!
+ * \brief apply the PFB geometry selected by pfb_tuner_set_scene() or the
+ *        calibration, see disp_adapter0_set_pfb_size()
+ * \note call it between two frames, i.e. when the display adapter task 
+ *       returns arm_fsm_rt_cpl
+ * \retval true the PFB helper is initialised again, please install the 
+ *         dependencies and the refresh mode again
+ * \retval false nothing is changed
+ */
+extern
+bool pfb_tuner_task(void);
+
+/*!
+ * \brief select the PFB geometry of a scene, or start the calibration of the
+ *        scene when calibration is enabled. The geometry is applied by 
+ *        pfb_tuner_task().
+ * \param[in] chSceneID the scene, see playlist_scene_id_t
+ */
+extern
+void pfb_tuner_set_scene(uint_fast8_t chSceneID);
+
+/*!
+ * \brief feed the cycles of a completed frame to the calibration
+ * \note the next PFB geometry of the calibration might be selected here
+ * \param[in] nFrameCycles the cycles used by the PFB helper for the frame
+ */
+extern
+void pfb_tuner_on_frame_complete(int32_t nFrameCycles);
+
+/*!
+ * \brief get the PFB geometry currently in use
+ * \return arm_2d_size_t the size of the PFB block
+ */
+extern
+arm_2d_size_t pfb_tuner_get_geometry(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -16,6 +16,12 @@
 ****************************************************************************/
 /*============================ INCLUDES ======================================*/
 #include "./platform.h"
+#include "./dma_2dcopy.h"
+#include "./slab_pool.h"
+#include "./mem_watermark.h"
+#include "./idle_sleep.h"
+#include "./timer_wheel.h"
+#include "./wall_clock.h"
 
 #include "arm_2d.h"
 #include "arm_2d_helper.h"
@@ -37,6 +43,9 @@ void platform_init(void)
 {
     extern void SystemCoreClockUpdate();
 
+    /* paint the stack before anything deep is called */
+    mem_watermark_init();
+
     SystemCoreClockUpdate();
     /*! \note if you do want to use SysTick in your application, please use 
      *!       init_cycle_counter(true); 
@@ -49,6 +58,12 @@ void platform_init(void)
     EventRecorderInitialize(0, 1);
 #endif
     stdio_init_all();
+
+    dma_2dcopy_init();
+    slab_pool_init();
+    idle_sleep_init();
+    system_timer_init();
+    wall_clock_init();
     
     epd_screen_init();
     epd_sceen_clear();
@@ -32,6 +32,9 @@
 #include "pico/stdlib.h"
 #include "perf_counter.h"
 
+#include "./platform_cfg.h"
+#include "./frame_probe.h"
+
 #if defined(RTE_Compiler_EventRecorder) || defined(RTE_CMSIS_View_EventRecorder)
 #   include <EventRecorder.h>
 #endif
@@ -42,7 +45,44 @@ extern "C" {
 
 
 /*============================ MACROS ========================================*/
+
+/* where the code runs, it is printed with the benchmark results */
+#if defined(PICO_NO_FLASH)
+#   define PLATFORM_CODE_PLACEMENT          "sram"
+#elif __PLATFORM_CFG_USE_TIME_CRITICAL_SECTION__
+#   define PLATFORM_CODE_PLACEMENT          "xip+sram"
+#else
+#   define PLATFORM_CODE_PLACEMENT          "xip"
+#endif
+
+/* pin zero-initialised data to a dedicated SRAM bank when the banked memory
+ * map (project/mdk/RP2040_banked.sct) is used. Other scatter files treat them
+ * as normal ZI data.
+ */
+#define PLATFORM_IN_DMA_BANK                __attribute__((section(".bss.bank.dma")))
+#define PLATFORM_IN_CORE1_BANK              __attribute__((section(".bss.bank.core1")))
+
 /*============================ MACROFIED FUNCTIONS ===========================*/
+
+/*!
+ * \brief place a function into a .time_critical section, i.e. SRAM
+ * \note the targets running in SRAM keep all code in SRAM anyway
+ */
+#if __PLATFORM_CFG_USE_TIME_CRITICAL_SECTION__
+#   define __platform_time_critical_func(__FUNC)    __time_critical_func(__FUNC)
+#else
+#   define __platform_time_critical_func(__FUNC)    __FUNC
+#endif
+
+#if !__PLATFORM_CFG_USE_EPD_OFFSCREEN__
+#   define epd_offscreen_get_page_size()            ((size_t)0)
+#   define epd_offscreen_begin(__PAGE_PTR)          ((void)(__PAGE_PTR))
+#   define epd_offscreen_cancel()
+#   define epd_offscreen_is_active()                (false)
+#   define epd_offscreen_is_complete()              (false)
+#   define epd_offscreen_present()                  (false)
+#endif
+
 /*============================ TYPES =========================================*/
 /*============================ GLOBAL VARIABLES ==============================*/
 /*============================ LOCAL VARIABLES ===============================*/
@@ -52,6 +92,53 @@ extern void platform_init(void);
 
 extern void epd_flush(void);
 
+/*!
+ * \brief refresh the panel only when at least one band of the current frame
+ *        has been sent since the last refresh
+ * \return true the refresh has been issued
+ */
+extern bool epd_flush_if_changed(void);
+
+extern void epd_get_render_skip_info(   uint32_t *pwSkippedBands, 
+                                        uint32_t *pwSkippedFrames);
+
+#if __PLATFORM_CFG_USE_EPD_OFFSCREEN__
+/*!
+ * \brief get the size of an offscreen page, i.e. the whole screen in 1bpp
+ * \return size_t the size in bytes
+ */
+extern size_t epd_offscreen_get_page_size(void);
+
+/*!
+ * \brief render the following frames into a page instead of the panel, the
+ *        panel keeps showing the current content without refreshing
+ * \param[in] pchPage a buffer of epd_offscreen_get_page_size() bytes
+ */
+extern void epd_offscreen_begin(uint8_t *pchPage);
+
+/*!
+ * \brief stop rendering into the page without showing it
+ */
+extern void epd_offscreen_cancel(void);
+
+extern bool epd_offscreen_is_active(void);
+
+/*!
+ * \brief check whether the whole page has been rendered since
+ *        epd_offscreen_begin(), i.e. no band was left out by a partial frame
+ * \return true the page is complete
+ */
+extern bool epd_offscreen_is_complete(void);
+
+/*!
+ * \brief send the page to the panel in a single SPI burst and refresh it,
+ *        the following frames go to the panel again
+ * \retval true the refresh has been issued
+ * \retval false no page is being rendered or the panel is busy
+ */
+extern bool epd_offscreen_present(void);
+#endif
+
 extern void epd_sceen_clear(void);
 
 extern bool epd_screen_is_busy(void);
@@ -0,0 +1,442 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_PLATFORM_CFG_H__
+#define __BADGER_RP2040_PLATFORM_CFG_H__
+
+/*============================ INCLUDES ======================================*/
+/*============================ MACROS ========================================*/
+
+//-------- <<< Use Configuration Wizard in Context Menu >>> -----------------
+
+// <h>Display Pipeline
+// =======================
+
+// <q> Skip unchanged PFB bands and frames
+// <i> Hash the packed 1bpp output of each PFB band and compare it with the band sent previously at the same location. Unchanged bands skip the window setup and SPI transfer, and a frame without any changed band skips DISPLAY_REFRESH.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_RENDER_SKIP__
+#   define __PLATFORM_CFG_USE_RENDER_SKIP__                         1
+#endif
+
+// <o> Number of band hashes to keep <1-255>
+// <i> A full frame of 296x128 uses 8 bands with the default 296x16 PFB.
+#ifndef __PLATFORM_CFG_RENDER_SKIP_BAND_COUNT__
+#   define __PLATFORM_CFG_RENDER_SKIP_BAND_COUNT__                  32
+#endif
+
+// <q> Render whole pages offscreen
+// <i> Allow a scene to render the next page into a packed 1bpp buffer while the panel keeps showing the current one, so a page flip is a single SPI burst plus one refresh, e.g. the page-flip mode of the text reader.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_EPD_OFFSCREEN__
+#   define __PLATFORM_CFG_USE_EPD_OFFSCREEN__                       1
+#endif
+
+// <q> Draw glyphs from a 1bpp glyph cache
+// <i> Threshold the glyphs of a font wrapped by glyph_cache_font_init() into packed 1bpp rows once, and draw them by writing only the set pixels instead of alpha-blending the A2/A4/A8 masks into the GRAY8 PFB on every frame. The least recently used glyph is evicted when the cache is full.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_GLYPH_CACHE__
+#   define __PLATFORM_CFG_USE_GLYPH_CACHE__                         1
+#endif
+
+// <o> Number of cached glyphs <1-255>
+// <i> Each glyph takes 16 bytes plus 4 bytes per row.
+#ifndef __PLATFORM_CFG_GLYPH_CACHE_ENTRIES__
+#   define __PLATFORM_CFG_GLYPH_CACHE_ENTRIES__                     96
+#endif
+
+// <o> Maximum height of a cached glyph in pixels <1-64>
+// <i> Taller glyphs and glyphs wider than 32 pixels are blended as usual.
+#ifndef __PLATFORM_CFG_GLYPH_CACHE_MAX_HEIGHT__
+#   define __PLATFORM_CFG_GLYPH_CACHE_MAX_HEIGHT__                  24
+#endif
+
+// <q> Select the PFB geometry per scene
+// <i> Switch the PFB block size at runtime to the variant stored in the profile of each scene, by initialising the PFB helper again between two frames. All variants share the PFB pool, hence they must not exceed __DISP0_CFG_PFB_BLOCK_WIDTH__ x __DISP0_CFG_PFB_BLOCK_HEIGHT__ pixels.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_PFB_TUNER__
+#   define __PLATFORM_CFG_USE_PFB_TUNER__                           1
+#endif
+
+// <q> Calibrate the PFB geometry
+// <i> Sweep all PFB geometry variants on each scene, print the frame time of each variant and use the winner for the rest of the run. The printed profile can be pasted into __PLATFORM_CFG_PFB_TUNER_PROFILE__.
+// <i> This feature is disabled by default.
+#ifndef __PLATFORM_CFG_PFB_TUNER_CALIBRATE__
+#   define __PLATFORM_CFG_PFB_TUNER_CALIBRATE__                     0
+#endif
+
+// <o> Number of frames measured for each variant during calibration <1-255>
+#ifndef __PLATFORM_CFG_PFB_TUNER_CALIBRATE_FRAMES__
+#   define __PLATFORM_CFG_PFB_TUNER_CALIBRATE_FRAMES__              8
+#endif
+
+// <o> Maximum number of scenes with a PFB profile <1-64>
+#ifndef __PLATFORM_CFG_PFB_TUNER_SCENE_COUNT__
+#   define __PLATFORM_CFG_PFB_TUNER_SCENE_COUNT__                   16
+#endif
+
+// <q> Use DMA for 2D copies
+// <i> Copy 2D regions, e.g. virtual resource assets in XIP flash, with chained DMA control blocks. Regions with matching strides are copied in a single transfer.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_DMA_2D_COPY__
+#   define __PLATFORM_CFG_USE_DMA_2D_COPY__                         1
+#endif
+
+// <o> Maximum number of rows per DMA 2D copy <1-1024>
+// <i> Each row takes a 16-byte control block. Bigger copies are split into several batches.
+#ifndef __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__
+#   define __PLATFORM_CFG_DMA_2D_COPY_MAX_ROWS__                    128
+#endif
+
+// <o> Size of the virtual resource prefetch buffer in bytes <0-65536>
+// <i> While a PFB band is being drawn, prefetch the same asset region of the next band. Set 0 to disable the prefetching.
+#ifndef __PLATFORM_CFG_DMA_2D_COPY_PREFETCH_SIZE__
+#   define __PLATFORM_CFG_DMA_2D_COPY_PREFETCH_SIZE__               4096
+#endif
+
+// <q> Use memcpy instead of DMA
+// <i> A stand-in for host builds and for debugging.
+#ifndef __PLATFORM_CFG_DMA_2D_COPY_USE_MEMCPY__
+#   define __PLATFORM_CFG_DMA_2D_COPY_USE_MEMCPY__                  0
+#endif
+
+// <q> Stream assets through a read-ahead buffer
+// <i> Read big sequential assets, e.g. the JPEG of the rickrolling scene, through a double buffered read-ahead buffer in SRAM. The next block is fetched by the DMA from the non-allocating XIP alias, so the streaming does not thrash the XIP cache.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_ASSET_STREAM__
+#   define __PLATFORM_CFG_USE_ASSET_STREAM__                        1
+#endif
+
+// <o> Size of a read-ahead block in bytes <64-16384:4>
+// <i> Each stream uses two blocks.
+#ifndef __PLATFORM_CFG_ASSET_STREAM_BLOCK_SIZE__
+#   define __PLATFORM_CFG_ASSET_STREAM_BLOCK_SIZE__                 1024
+#endif
+
+// <o> Maximum number of streams opened at the same time <1-8>
+#ifndef __PLATFORM_CFG_ASSET_STREAM_COUNT__
+#   define __PLATFORM_CFG_ASSET_STREAM_COUNT__                      2
+#endif
+
+// <q> Run the hot kernels from SRAM
+// <i> Place the PFB packing, band hashing and flushing functions into .time_critical sections, which are copied to SRAM at startup by the scatter loading. The scatter file of the AC6-flash target also places the GRAY8 kernels of arm-2d and the TJpgDec decoder into SRAM.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_TIME_CRITICAL_SECTION__
+#   define __PLATFORM_CFG_USE_TIME_CRITICAL_SECTION__               1
+#endif
+
+// </h>
+
+// <h>Scene Playlist
+// =======================
+
+// <q> Construct the next scene in the background
+// <i> Call the loader of the next scene in the playlist while the current scene is waiting on the panel, so the switching only swaps the scenes. The report of each switching shows the latency and whether the scene was preloaded. A scene is not preloaded while another instance of it is showing.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_SCENE_PRELOAD__
+#   define __PLATFORM_CFG_USE_SCENE_PRELOAD__                       1
+#endif
+
+// <o> Preload the next scene N ms before the switching <0-60000>
+// <i> Both scenes are alive in this period, hence a longer lead costs memory.
+#ifndef __PLATFORM_CFG_SCENE_PRELOAD_LEAD__
+#   define __PLATFORM_CFG_SCENE_PRELOAD_LEAD__                      3000
+#endif
+
+// <q> Load the playlist from a flash-resident blob
+// <i> Parse the playlist packed by tools/playlist_pack.py at boot, so the scenes, their durations, refresh profiles and contents (e.g. the QR code payload) can be changed without rebuilding the firmware. The built-in playlist is used when no valid blob is found.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_FLASH_PLAYLIST__
+#   define __PLATFORM_CFG_USE_FLASH_PLAYLIST__                      1
+#endif
+
+// <o> The XIP address of the playlist blob <0x10000000-0x10FFFFFF>
+// <i> The default is the last 64KB of the 2MB flash, which is reserved in the scatter files of the AC6-flash target.
+#ifndef __PLATFORM_CFG_FLASH_PLAYLIST_ADDRESS__
+#   define __PLATFORM_CFG_FLASH_PLAYLIST_ADDRESS__                  0x101F0000
+#endif
+
+// <o> The size of the flash region reserved for the playlist blob
+// <i> Please keep it in sync with __PLAYLIST_SIZE in the scatter file.
+#ifndef __PLATFORM_CFG_FLASH_PLAYLIST_SIZE__
+#   define __PLATFORM_CFG_FLASH_PLAYLIST_SIZE__                     0x00010000
+#endif
+
+// <o> The maximum number of entries in the playlist <1-127>
+// <i> The parsed entries are kept in a static array, i.e. no heap is used. Please pass the same value to tools/playlist_pack.py with --max-entries.
+#ifndef __PLATFORM_CFG_PLAYLIST_MAX_ENTRIES__
+#   define __PLATFORM_CFG_PLAYLIST_MAX_ENTRIES__                    32
+#endif
+
+// </h>
+
+// <h>Flash Text Document
+// =======================
+
+// <q> Read the text of the text reader from a flash-resident document
+// <i> Show the document packed by tools/text_pack.py when no text is given to the text reader, e.g. a book much larger than the SRAM. The text box streams it through a small block cache and the line-break index becomes sparse for large documents. The built-in story is used when no valid document is found.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_FLASH_TEXT__
+#   define __PLATFORM_CFG_USE_FLASH_TEXT__                          1
+#endif
+
+// <o> The XIP address of the document <0x10000000-0x10FFFFFF>
+// <i> The default is the 512KB in front of the playlist blob, which is reserved in the scatter files of the AC6-flash target. Move it and enlarge it for boards with a bigger flash.
+#ifndef __PLATFORM_CFG_FLASH_TEXT_ADDRESS__
+#   define __PLATFORM_CFG_FLASH_TEXT_ADDRESS__                      0x10170000
+#endif
+
+// <o> The size of the flash region reserved for the document
+// <i> Please keep it in sync with __TEXT_SIZE in the scatter file.
+#ifndef __PLATFORM_CFG_FLASH_TEXT_SIZE__
+#   define __PLATFORM_CFG_FLASH_TEXT_SIZE__                         0x00080000
+#endif
+
+// <o> The size of a cache block in bytes <64-4096:4>
+#ifndef __PLATFORM_CFG_FLASH_TEXT_BLOCK_SIZE__
+#   define __PLATFORM_CFG_FLASH_TEXT_BLOCK_SIZE__                   256
+#endif
+
+// <o> The number of cache blocks <1-8>
+// <i> Two blocks keep a read that crosses a block boundary in the cache.
+#ifndef __PLATFORM_CFG_FLASH_TEXT_CACHE_BLOCKS__
+#   define __PLATFORM_CFG_FLASH_TEXT_CACHE_BLOCKS__                 2
+#endif
+
+// </h>
+
+// <h>Flash Mono Film
+// =======================
+
+// <q> Play a pre-dithered 1bpp film in the rickrolling scene
+// <i> Play the film packed by tools/film_pack.py instead of decoding and dithering the JPEG sprite sheet on every frame. The film stores key frames and XOR deltas as run-length encoded 1bpp rows. The JPEG is used when no valid film is found.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_MONO_FILM__
+#   define __PLATFORM_CFG_USE_MONO_FILM__                           1
+#endif
+
+// <o> The XIP address of the film <0x10000000-0x10FFFFFF>
+// <i> The default is the 128KB in front of the text document, which is reserved in the scatter files of the AC6-flash target.
+#ifndef __PLATFORM_CFG_MONO_FILM_ADDRESS__
+#   define __PLATFORM_CFG_MONO_FILM_ADDRESS__                       0x10150000
+#endif
+
+// <o> The size of the flash region reserved for the film
+// <i> Please keep it in sync with __FILM_SIZE in the scatter file.
+#ifndef __PLATFORM_CFG_MONO_FILM_SIZE__
+#   define __PLATFORM_CFG_MONO_FILM_SIZE__                          0x00020000
+#endif
+
+// </h>
+
+// <h>JPEG Frame Cache
+// =======================
+
+// <q> Decode each frame of the JPEG sprite sheet only once
+// <i> The rickrolling scene decodes the current frame into a buffer of the frame size when the film advances, and the PFB bands copy from that buffer. Otherwise, the TJpgDec loader runs for every band that intersects the frame, each time from the start of the frame. It is only used when the pre-dithered film is not available.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+#   define __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__                    1
+#endif
+
+// </h>
+
+// <h>Memory Management
+// =======================
+
+// <q> Allocate the scratch memory of scenes from arenas
+// <i> Serve __arm_2d_allocate_scratch_memory() from one of two bump arenas, one per scene alive during a switching. Blocks freed in LIFO order are rolled back immediately, and the whole arena is released when the scene frees its control block in depose. Requests that do not fit fall back to the heap.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_SCENE_ARENA__
+#   define __PLATFORM_CFG_USE_SCENE_ARENA__                         1
+#endif
+
+// <o> Size of each scene arena in bytes <1024-65536:8>
+#ifndef __PLATFORM_CFG_SCENE_ARENA_SIZE__
+#   define __PLATFORM_CFG_SCENE_ARENA_SIZE__                        8192
+#endif
+
+// <q> Keep size-classed workspaces for blur and transform operations
+// <i> Serve the scratch memory of type ARM_2D_MEM_TYPE_FAST, e.g. IIR blur accumulators, from size-classed buffers (256B ~ 8KB) that are kept after release and reused by the next request of the same class, so workspaces never churn the heap. When a scene is switched out, the kept buffers above the peak use of the scene are freed.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__
+#   define __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__                   1
+#endif
+
+// <o> Number of cached workspaces per size class <1-8>
+#ifndef __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__
+#   define __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__                 2
+#endif
+
+// <q> Serve small scratch memory requests from slab pools
+// <i> Power-of-two slab pools (16B ~ 512B) with O(1) allocation and free. The blocks are aligned to their size, up to 32 bytes. The pools are shared by both cores and protected by a hardware spinlock. The small requests are served by the slabs before the scene arenas, except the control blocks of the scenes. Requests that cannot be served fall back to the scene arena and then the heap.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_SLAB_POOL__
+#   define __PLATFORM_CFG_USE_SLAB_POOL__                           1
+#endif
+
+// <o> Number of 16 bytes blocks <0-1024>
+#ifndef __PLATFORM_CFG_SLAB_POOL_16B_BLOCKS__
+#   define __PLATFORM_CFG_SLAB_POOL_16B_BLOCKS__                    32
+#endif
+
+// <o> Number of 32 bytes blocks <0-1024>
+#ifndef __PLATFORM_CFG_SLAB_POOL_32B_BLOCKS__
+#   define __PLATFORM_CFG_SLAB_POOL_32B_BLOCKS__                    32
+#endif
+
+// <o> Number of 64 bytes blocks <0-1024>
+#ifndef __PLATFORM_CFG_SLAB_POOL_64B_BLOCKS__
+#   define __PLATFORM_CFG_SLAB_POOL_64B_BLOCKS__                    16
+#endif
+
+// <o> Number of 128 bytes blocks <0-1024>
+#ifndef __PLATFORM_CFG_SLAB_POOL_128B_BLOCKS__
+#   define __PLATFORM_CFG_SLAB_POOL_128B_BLOCKS__                   16
+#endif
+
+// <o> Number of 256 bytes blocks <0-1024>
+#ifndef __PLATFORM_CFG_SLAB_POOL_256B_BLOCKS__
+#   define __PLATFORM_CFG_SLAB_POOL_256B_BLOCKS__                   8
+#endif
+
+// <o> Number of 512 bytes blocks <0-1024>
+#ifndef __PLATFORM_CFG_SLAB_POOL_512B_BLOCKS__
+#   define __PLATFORM_CFG_SLAB_POOL_512B_BLOCKS__                   4
+#endif
+
+// <q> Print the trace of the scratch memory
+// <i> Print every request and release of the scratch memory and the switching of the scene arenas to stdout, one line each. A captured trace can be replayed by tests/host/scratch_memory_trace_test.c.
+// <i> This feature is disabled by default.
+#ifndef __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__
+#   define __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__                    0
+#endif
+
+// <q> Track the stack and heap high-water marks
+// <i> Paint the unused stack at boot and scan it for the high-water mark, count the current and peak heap usage of the scratch memory, and probe the largest free heap block for an estimate of the fragmentation. The results are logged to the STATISTICS channel of Arm-2D and printed for each scene.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_MEM_WATERMARK__
+#   define __PLATFORM_CFG_USE_MEM_WATERMARK__                       1
+#endif
+
+// <o> Scan the stack every N frames <0-1024>
+// <i> 0 means the stack is only scanned when a scene is switched out.
+#ifndef __PLATFORM_CFG_MEM_WATERMARK_SCAN_PERIOD__
+#   define __PLATFORM_CFG_MEM_WATERMARK_SCAN_PERIOD__               16
+#endif
+
+// </h>
+
+// <h>Power Management
+// =======================
+
+// <q> Sleep with WFE between events
+// <i> Instead of spinning, the main loop sleeps with WFE while the panel is BUSY, and between frames when the scene declares the deadline of its next frame. The core is woken up by a hardware alarm, the release of the BUSY pin or idle_sleep_notify() from other interrupts.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_IDLE_SLEEP__
+#   define __PLATFORM_CFG_USE_IDLE_SLEEP__                          1
+#endif
+
+// <o> Maximum time to sleep while the panel is BUSY in ms <1-1000>
+// <i> A fallback in case the release of the BUSY pin is missed.
+#ifndef __PLATFORM_CFG_IDLE_SLEEP_BUSY_TIMEOUT__
+#   define __PLATFORM_CFG_IDLE_SLEEP_BUSY_TIMEOUT__                 50
+#endif
+
+// <q> Use the RTC as the wall clock
+// <i> Keep the time of day in the RTC, which is set to the build time at startup. A one-shot RTC alarm wakes up the main loop when the digits shown by a scene change. When disabled, the wall clock is derived from the uptime.
+// <i> This feature is enabled by default.
+#ifndef __PLATFORM_CFG_USE_WALL_CLOCK__
+#   define __PLATFORM_CFG_USE_WALL_CLOCK__                          1
+#endif
+
+// <o> The granularity of the clock scene
+//     <1=> Second
+//     <60=> Minute
+// <i> The clock scene only refreshes the panel when the digits of this granularity change.
+#ifndef __PLATFORM_CFG_WALL_CLOCK_GRANULARITY__
+#   define __PLATFORM_CFG_WALL_CLOCK_GRANULARITY__                  1
+#endif
+
+// </h>
+
+// <h>Performance Analysis
+// =======================
+
+// <q> Enable the frame pipeline stage probes
+// <i> Measure scene drawing, dither/pack, SPI transfer, window setup, LUT upload and BUSY wait with the perf_counter cycle counter. When disabled, all probes are compiled out.
+// <i> This feature is disabled by default.
+#ifndef __PLATFORM_CFG_USE_FRAME_PROBE__
+#   define __PLATFORM_CFG_USE_FRAME_PROBE__                         0
+#endif
+
+// <o> Maximum number of scenes tracked by the frame probes <1-64>
+// <i> The frame probes aggregate the statistics for each scene ID of the playlist, no matter where and how often it appears.
+#ifndef __PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__
+#   define __PLATFORM_CFG_FRAME_PROBE_SCENE_COUNT__                 16
+#endif
+
+// <q> Count the contested SRAM accesses
+// <i> Use the bus fabric performance counters to count the contested accesses to SRAM0~3 of each scene. Compare the numbers between the default and the banked memory map (RP2040_banked.sct).
+#ifndef __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__
+#   define __PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__              1
+#endif
+
+// <q> Enable the frame pipeline timeline trace
+// <i> Record begin/end events of scene callbacks, PFB bands, SPI bursts and BUSY periods into a ring buffer that can be dumped over stdio and converted into Chrome trace JSON with tools/trace2chrome.py.
+// <i> This feature is disabled by default.
+#ifndef __PLATFORM_CFG_USE_FRAME_TRACE__
+#   define __PLATFORM_CFG_USE_FRAME_TRACE__                         0
+#endif
+
+// <o> Number of events in the trace ring buffer <16-8192>
+// <i> Each event takes 8 bytes. When the ring buffer is full, the oldest events are overwritten.
+#ifndef __PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__
+#   define __PLATFORM_CFG_FRAME_TRACE_BUFFER_SIZE__                 512
+#endif
+
+// <q> Dump the trace on each scene switching
+// <i> Print the content of the trace ring buffer before a new scene is loaded.
+#ifndef __PLATFORM_CFG_FRAME_TRACE_DUMP_ON_SWITCH__
+#   define __PLATFORM_CFG_FRAME_TRACE_DUMP_ON_SWITCH__              1
+#endif
+
+// <q> Mirror the trace events to the EventRecorder
+// <i> Send each trace event to the CMSIS-View EventRecorder as well, if it is available.
+#ifndef __PLATFORM_CFG_FRAME_TRACE_USE_EVENT_RECORDER__
+#   define __PLATFORM_CFG_FRAME_TRACE_USE_EVENT_RECORDER__          0
+#endif
+
+// </h>
+
+// <<< end of configuration section >>>
+
+/*!
+ * \brief the index of the PFB geometry variant used by each scene in the
+ *        demo playlist, see c_tPFBGeometries in pfb_tuner.c
+ */
+#ifndef __PLATFORM_CFG_PFB_TUNER_PROFILE__
+#   define __PLATFORM_CFG_PFB_TUNER_PROFILE__                       {0}
+#endif
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#endif
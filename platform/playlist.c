@@ -0,0 +1,158 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./playlist.h"
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+#if __PLATFORM_CFG_USE_FLASH_PLAYLIST__
+static playlist_entry_t s_tFlashEntries[__PLATFORM_CFG_PLAYLIST_MAX_ENTRIES__];
+#endif
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+/* the CRC-32 used by zlib, i.e. binascii.crc32() in python */
+static uint32_t __playlist_crc32(const uint8_t *pchData, size_t tSize)
+{
+    uint32_t wCRC = 0xFFFFFFFFul;
+
+    while(tSize--) {
+        wCRC ^= *pchData++;
+        for (uint_fast8_t n = 0; n < 8; n++) {
+            wCRC = (wCRC >> 1) ^ (0xEDB88320ul & -(wCRC & 1));
+        }
+    }
+
+    return ~wCRC;
+}
+
+int_fast16_t playlist_parse(const void *pBlob,
+                            size_t tSize,
+                            playlist_entry_t *ptEntries,
+                            uint_fast16_t hwMaxCount)
+{
+    if (    (NULL == pBlob)
+        ||  (NULL == ptEntries)
+        ||  ((uintptr_t)pBlob & 0x03)) {
+        return PLAYLIST_ERR_INVALID_PARAM;
+    }
+
+    const uint8_t *pchBlob = (const uint8_t *)pBlob;
+    const playlist_blob_header_t *ptHeader = (const playlist_blob_header_t *)pBlob;
+
+    if (tSize < sizeof(playlist_blob_header_t)) {
+        return PLAYLIST_ERR_BAD_SIZE;
+    }
+    if (ptHeader->wMagic != PLAYLIST_BLOB_MAGIC) {
+        return PLAYLIST_ERR_BAD_MAGIC;
+    }
+    if (ptHeader->hwVersion != PLAYLIST_BLOB_VERSION) {
+        return PLAYLIST_ERR_UNSUPPORTED_VERSION;
+    }
+    if (    (ptHeader->wSize < sizeof(playlist_blob_header_t))
+        ||  (ptHeader->wSize > tSize)
+        ||  (ptHeader->wSize & 0x03)) {
+        return PLAYLIST_ERR_BAD_SIZE;
+    }
+    if (ptHeader->hwCount > hwMaxCount) {
+        return PLAYLIST_ERR_TOO_MANY_ENTRIES;
+    }
+    if (__playlist_crc32(   pchBlob + sizeof(playlist_blob_header_t),
+                            ptHeader->wSize - sizeof(playlist_blob_header_t))
+        != ptHeader->wCRC32) {
+        return PLAYLIST_ERR_BAD_CHECKSUM;
+    }
+
+    /* walk the entries, everything is referenced in place */
+    uint32_t wOffset = sizeof(playlist_blob_header_t);
+    for (uint_fast16_t n = 0; n < ptHeader->hwCount; n++) {
+
+        if (wOffset + sizeof(playlist_blob_entry_t) > ptHeader->wSize) {
+            return PLAYLIST_ERR_BAD_ENTRY;
+        }
+
+        const playlist_blob_entry_t *ptEntry
+            = (const playlist_blob_entry_t *)(pchBlob + wOffset);
+        wOffset += sizeof(playlist_blob_entry_t);
+
+        if (    (ptEntry->chSceneID >= __PLAYLIST_SCENE_COUNT)
+            ||  (wOffset + ptEntry->hwParamSize > ptHeader->wSize)) {
+            return PLAYLIST_ERR_BAD_ENTRY;
+        }
+
+        ptEntries[n] = (playlist_entry_t) {
+            .nLastInMS = (int32_t)MIN(ptEntry->wDurationMS, INT32_MAX),
+            .chSceneID = ptEntry->chSceneID,
+            .bInvertColour = !!(ptEntry->chFlags & PLAYLIST_FLAG_INVERT_COLOUR),
+            .bDither = !!(ptEntry->chFlags & PLAYLIST_FLAG_DITHER),
+            .hwParamSize = ptEntry->hwParamSize,
+            .pParam = ptEntry->hwParamSize ? (pchBlob + wOffset) : NULL,
+        };
+
+        wOffset += (ptEntry->hwParamSize + 3) & ~0x03ul;
+    }
+
+    if (wOffset != ptHeader->wSize) {
+        return PLAYLIST_ERR_BAD_SIZE;
+    }
+
+    return ptHeader->hwCount;
+}
+
+#if __PLATFORM_CFG_USE_FLASH_PLAYLIST__
+bool playlist_load_from_flash(playlist_t *ptPlaylist)
+{
+    assert(NULL != ptPlaylist);
+
+    int64_t lStart = get_system_ticks();
+
+    /* the flash is memory mapped (XIP), i.e. nothing is copied */
+    int_fast16_t iResult = playlist_parse(
+                            (const void *)__PLATFORM_CFG_FLASH_PLAYLIST_ADDRESS__,
+                            __PLATFORM_CFG_FLASH_PLAYLIST_SIZE__,
+                            s_tFlashEntries,
+                            dimof(s_tFlashEntries));
+
+    if (iResult <= 0) {
+        printf( "[playlist] no valid blob at 0x%08x (%d), use the built-in one\r\n",
+                (unsigned int)__PLATFORM_CFG_FLASH_PLAYLIST_ADDRESS__,
+                (int)iResult);
+        return false;
+    }
+
+    ptPlaylist->ptEntries = s_tFlashEntries;
+    ptPlaylist->hwCount = (uint16_t)iResult;
+
+    printf( "[playlist] %d entries loaded from 0x%08x in %"PRIu32"us\r\n",
+            (int)iResult,
+            (unsigned int)__PLATFORM_CFG_FLASH_PLAYLIST_ADDRESS__,
+            (uint32_t)perfc_convert_ticks_to_us(get_system_ticks() - lStart));
+
+    return true;
+}
+#endif
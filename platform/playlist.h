@@ -0,0 +1,158 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_PLAYLIST_H__
+#define __BADGER_RP2040_PLAYLIST_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+/* the blob format, please keep tools/playlist_pack.py in sync */
+#define PLAYLIST_BLOB_MAGIC             0x314C5042ul        /* "BPL1" */
+#define PLAYLIST_BLOB_VERSION           1
+
+#define PLAYLIST_FLAG_INVERT_COLOUR     (1u << 0)
+#define PLAYLIST_FLAG_DITHER            (1u << 1)
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_FLASH_PLAYLIST__
+#   define playlist_load_from_flash(__PLAYLIST_PTR)  ((void)(__PLAYLIST_PTR), false)
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the scenes a playlist can refer to
+ * \note the values are part of the blob format, please only append new items
+ *       and keep tools/playlist_pack.py in sync.
+ */
+typedef enum {
+    PLAYLIST_SCENE_MONO_LOADING         = 0,
+    PLAYLIST_SCENE_QRCODE               = 1,    //!< param: the string to encode
+    PLAYLIST_SCENE_MONO_CLOCK           = 2,
+    PLAYLIST_SCENE_MONO_HISTOGRAM       = 3,
+    PLAYLIST_SCENE_PROGRESS_STATUS      = 4,
+    PLAYLIST_SCENE_MONO_LIST            = 5,
+    PLAYLIST_SCENE_MONO_TRACKING_LIST   = 6,
+    PLAYLIST_SCENE_MONO_ICON_MENU       = 7,
+    PLAYLIST_SCENE_TEXT_READER          = 8,    //!< param: the text to show
+    PLAYLIST_SCENE_RICKROLLING          = 9,
+
+    __PLAYLIST_SCENE_COUNT,
+} playlist_scene_id_t;
+
+typedef enum {
+    PLAYLIST_ERR_NONE                   = 0,
+    PLAYLIST_ERR_INVALID_PARAM          = -1,
+    PLAYLIST_ERR_BAD_MAGIC              = -2,   //!< e.g. an erased flash region
+    PLAYLIST_ERR_UNSUPPORTED_VERSION    = -3,
+    PLAYLIST_ERR_BAD_SIZE               = -4,
+    PLAYLIST_ERR_BAD_CHECKSUM           = -5,
+    PLAYLIST_ERR_BAD_ENTRY              = -6,
+    PLAYLIST_ERR_TOO_MANY_ENTRIES       = -7,
+} playlist_err_t;
+
+/*!
+ * \brief the header of a playlist blob (16 bytes, little endian)
+ */
+typedef struct playlist_blob_header_t {
+    uint32_t wMagic;                            //!< PLAYLIST_BLOB_MAGIC
+    uint16_t hwVersion;                         //!< PLAYLIST_BLOB_VERSION
+    uint16_t hwCount;                           //!< the number of entries
+    uint32_t wSize;                             //!< the size of the blob, including the header
+    uint32_t wCRC32;                            //!< the CRC-32 of the bytes after the header
+} playlist_blob_header_t;
+
+/*!
+ * \brief the header of an entry in the blob (8 bytes, little endian), it is
+ *        followed by the parameter which is padded to 4 bytes
+ */
+typedef struct playlist_blob_entry_t {
+    uint8_t chSceneID;                          //!< playlist_scene_id_t
+    uint8_t chFlags;                            //!< PLAYLIST_FLAG_xxxx
+    uint16_t hwParamSize;                       //!< the size of the parameter
+    uint32_t wDurationMS;                       //!< 0 means staying forever
+} playlist_blob_entry_t;
+
+/*!
+ * \brief a parsed entry, the parameter is referenced in place
+ */
+typedef struct playlist_entry_t {
+    int32_t nLastInMS;                          //!< 0 means staying forever
+    uint8_t chSceneID;                          //!< playlist_scene_id_t
+
+    /* the refresh profile, applied when the scene is switched in */
+    bool bInvertColour;
+    bool bDither;
+
+    uint16_t hwParamSize;
+    const void *pParam;                         //!< NULL means the default content
+} playlist_entry_t;
+
+typedef struct playlist_t {
+    const playlist_entry_t *ptEntries;
+    uint16_t hwCount;
+} playlist_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+/*!
+ * \brief validate a playlist blob and parse its entries without copying
+ *        the parameters
+ * \param[in] pBlob the blob, 4 bytes aligned
+ * \param[in] tSize the maximum size of the blob, e.g. the size of the region
+ * \param[out] ptEntries the buffer for the parsed entries
+ * \param[in] hwMaxCount the capacity of the buffer
+ * \return int_fast16_t the number of entries or a playlist_err_t
+ */
+extern
+int_fast16_t playlist_parse(const void *pBlob,
+                            size_t tSize,
+                            playlist_entry_t *ptEntries,
+                            uint_fast16_t hwMaxCount);
+
+#if __PLATFORM_CFG_USE_FLASH_PLAYLIST__
+/*!
+ * \brief load the playlist blob from __PLATFORM_CFG_FLASH_PLAYLIST_ADDRESS__
+ * \note the entries are kept in a static buffer. The playlist is untouched
+ *       when there is no valid blob, i.e. the built-in one can be used.
+ * \param[out] ptPlaylist the target playlist
+ * \retval true a blob is loaded
+ * \retval false there is no valid blob
+ */
+extern
+bool playlist_load_from_flash(playlist_t *ptPlaylist);
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
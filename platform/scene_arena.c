@@ -0,0 +1,294 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./scene_arena.h"
+
+#if __PLATFORM_CFG_USE_SCENE_ARENA__
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+#define SCENE_ARENA_COUNT           2
+#define SCENE_ARENA_NONE            UINT32_MAX
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the header in front of each block in an arena (8 bytes)
+ */
+typedef struct __scene_arena_block_t {
+    uint32_t wPrevious;                         //!< offset of the previous header
+    uint32_t bFreed         : 1;
+    uint32_t                : 31;
+} __scene_arena_block_t;
+
+typedef struct __scene_arena_t {
+    uint32_t wUsed;
+    uint32_t wTop;                              //!< offset of the last header
+    uint32_t wPeak;
+    uint32_t wFallbacks;
+    void *pFirst;                               //!< the control block of the scene
+    bool bWaitFirst;                            //!< the next block is pFirst
+    bool bBypass;                               //!< still used by an old scene
+
+    uint8_t chBuffer[__PLATFORM_CFG_SCENE_ARENA_SIZE__] __ALIGNED(8);
+} __scene_arena_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+static
+struct {
+    uint8_t chCurrent;                          //!< the arena of the scene showing
+    uint8_t chNext;                             //!< the arena of the scene loaded
+    bool bNextOpened;                           //!< the loaded scene is not showing yet
+    bool bLoading;                              //!< the loader of the next scene is running
+    bool bInitialized;
+
+    __scene_arena_t tArenas[SCENE_ARENA_COUNT];
+} s_tSceneArena;
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+static void __scene_arena_reset(__scene_arena_t *ptThis)
+{
+    ptThis->wUsed = 0;
+    ptThis->wTop = SCENE_ARENA_NONE;
+    ptThis->pFirst = NULL;
+    ptThis->bBypass = false;
+}
+
+static void __scene_arena_init(void)
+{
+    arm_foreach(__scene_arena_t, s_tSceneArena.tArenas, ptArena) {
+        __scene_arena_reset(ptArena);
+    }
+    s_tSceneArena.bInitialized = true;
+}
+
+static __scene_arena_t *__scene_arena_find(void *pBuffer)
+{
+    arm_foreach(__scene_arena_t, s_tSceneArena.tArenas, ptArena) {
+        if (    (uint8_t *)pBuffer >= ptArena->chBuffer
+            &&  (uint8_t *)pBuffer < ptArena->chBuffer + sizeof(ptArena->chBuffer)) {
+            return ptArena;
+        }
+    }
+
+    return NULL;
+}
+
+static void *__scene_arena_allocate(__scene_arena_t *ptThis, 
+                                    uint32_t wSize, 
+                                    uint_fast8_t nAlign)
+{
+    nAlign = MAX(nAlign, sizeof(__scene_arena_block_t));
+    assert(0 == (nAlign & (nAlign - 1)));
+
+    uint32_t wStart = (ptThis->wUsed + sizeof(__scene_arena_block_t) + nAlign - 1) 
+                    & ~(uint32_t)(nAlign - 1);
+
+    if (wStart + wSize > sizeof(ptThis->chBuffer)) {
+        return NULL;
+    }
+
+    uint32_t wHeader = wStart - sizeof(__scene_arena_block_t);
+    __scene_arena_block_t *ptBlock 
+        = (__scene_arena_block_t *)&ptThis->chBuffer[wHeader];
+    
+    ptBlock->wPrevious = ptThis->wTop;
+    ptBlock->bFreed = false;
+
+    ptThis->wTop = wHeader;
+    ptThis->wUsed = wStart + wSize;
+    ptThis->wPeak = MAX(ptThis->wPeak, ptThis->wUsed);
+
+    return &ptThis->chBuffer[wStart];
+}
+
+static void __scene_arena_free(__scene_arena_t *ptThis, void *pBuffer)
+{
+    if (pBuffer == ptThis->pFirst) {
+        /* the scene releases its control block: drop everything at once */
+        __scene_arena_reset(ptThis);
+        return ;
+    }
+
+    __scene_arena_block_t *ptBlock = (__scene_arena_block_t *)pBuffer - 1;
+    ptBlock->bFreed = true;
+
+    /* roll back the freed blocks on the top */
+    while (SCENE_ARENA_NONE != ptThis->wTop) {
+        ptBlock = (__scene_arena_block_t *)&ptThis->chBuffer[ptThis->wTop];
+        if (!ptBlock->bFreed) {
+            break;
+        }
+        ptThis->wUsed = ptThis->wTop;
+        ptThis->wTop = ptBlock->wPrevious;
+    }
+}
+
+void scene_arena_open_next(void)
+{
+    __IRQ_SAFE {
+        if (!s_tSceneArena.bInitialized) {
+            __scene_arena_init();
+        }
+
+        s_tSceneArena.chNext = (s_tSceneArena.chCurrent + 1) % SCENE_ARENA_COUNT;
+        s_tSceneArena.bNextOpened = true;
+        s_tSceneArena.bLoading = true;
+
+        __scene_arena_t *ptArena = &s_tSceneArena.tArenas[s_tSceneArena.chNext];
+        ptArena->wPeak = ptArena->wUsed;
+        ptArena->wFallbacks = 0;
+
+        /* the scene used the arena last time is still alive, which should 
+         * not happen in a linear playlist. Never mix two scenes in one arena,
+         * otherwise the wholesale release would free both.
+         */
+        ptArena->bBypass = (SCENE_ARENA_NONE != ptArena->wTop);
+        ptArena->bWaitFirst = !ptArena->bBypass;
+    }
+
+#if __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__
+    printf("[scratch] O\r\n");
+#endif
+}
+
+void scene_arena_close_next(void)
+{
+    s_tSceneArena.bLoading = false;
+
+#if __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__
+    printf("[scratch] C\r\n");
+#endif
+}
+
+void scene_arena_switch_to_next(void)
+{
+    __IRQ_SAFE {
+        if (s_tSceneArena.bNextOpened) {
+            s_tSceneArena.chCurrent = s_tSceneArena.chNext;
+            s_tSceneArena.bNextOpened = false;
+        }
+        s_tSceneArena.bLoading = false;
+    }
+
+#if __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__
+    printf("[scratch] S\r\n");
+#endif
+}
+
+bool scene_arena_is_waiting_control_block(void)
+{
+    return  s_tSceneArena.bLoading
+        &&  s_tSceneArena.tArenas[s_tSceneArena.chNext].bWaitFirst;
+}
+
+static uint_fast8_t __scene_arena_get_index(scene_arena_select_t tWhich)
+{
+    if (SCENE_ARENA_NEXT == tWhich) {
+        return (s_tSceneArena.chCurrent + 1) % SCENE_ARENA_COUNT;
+    }
+
+    return s_tSceneArena.chCurrent;
+}
+
+void scene_arena_get_info(scene_arena_info_t *ptInfo, scene_arena_select_t tWhich)
+{
+    assert(NULL != ptInfo);
+
+    __scene_arena_t *ptArena = &s_tSceneArena.tArenas[__scene_arena_get_index(tWhich)];
+
+    *ptInfo = (scene_arena_info_t) {
+        .wSize = sizeof(ptArena->chBuffer),
+        .wUsed = ptArena->wUsed,
+        .wPeak = ptArena->wPeak,
+        .wFallbacks = ptArena->wFallbacks,
+    };
+}
+
+void scene_arena_dump_info(scene_arena_select_t tWhich)
+{
+    scene_arena_info_t tInfo;
+    scene_arena_get_info(&tInfo, tWhich);
+
+    printf( "[scene arena] %d: peak %"PRIu32"/%"PRIu32" bytes, "
+            "%"PRIu32" heap fallbacks\r\n",
+            (int)__scene_arena_get_index(tWhich),
+            tInfo.wPeak,
+            tInfo.wSize,
+            tInfo.wFallbacks);
+}
+
+void *scene_arena_allocate(uint32_t wSize, uint_fast8_t nAlign)
+{
+    void *pBuffer = NULL;
+
+    __IRQ_SAFE {
+        if (!s_tSceneArena.bInitialized) {
+            __scene_arena_init();
+        }
+
+        /* the current scene keeps its arena while the next one is preloaded */
+        __scene_arena_t *ptArena = &s_tSceneArena.tArenas[
+                                            s_tSceneArena.bLoading 
+                                        ?   s_tSceneArena.chNext 
+                                        :   s_tSceneArena.chCurrent];
+        if (!ptArena->bBypass) {
+            pBuffer = __scene_arena_allocate(ptArena, wSize, nAlign);
+        }
+
+        if (NULL == pBuffer) {
+            ptArena->wFallbacks++;
+        } else if (ptArena->bWaitFirst) {
+            ptArena->pFirst = pBuffer;
+        }
+
+        /* when the control block goes to the heap, only the LIFO roll back 
+         * releases the arena
+         */
+        ptArena->bWaitFirst = false;
+    }
+
+    return pBuffer;
+}
+
+bool scene_arena_free(void *pBuffer)
+{
+    __scene_arena_t *ptArena = __scene_arena_find(pBuffer);
+    if (NULL == ptArena) {
+        return false;
+    }
+
+    __IRQ_SAFE {
+        __scene_arena_free(ptArena, pBuffer);
+    }
+
+    return true;
+}
+
+#endif
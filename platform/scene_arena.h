@@ -0,0 +1,146 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_SCENE_ARENA_H__
+#define __BADGER_RP2040_SCENE_ARENA_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_SCENE_ARENA__
+#   define scene_arena_open_next()
+#   define scene_arena_close_next()
+#   define scene_arena_switch_to_next()
+#   define scene_arena_dump_info(__WHICH)
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the statistics of a scene arena
+ */
+typedef struct scene_arena_info_t {
+    uint32_t wSize;                             //!< the size of the arena
+    uint32_t wUsed;                             //!< the bytes in use
+    uint32_t wPeak;                             //!< the high-water mark
+    uint32_t wFallbacks;                        //!< requests served by the heap
+} scene_arena_info_t;
+
+/*!
+ * \brief the arena to report
+ */
+typedef enum {
+    SCENE_ARENA_CURRENT,                        //!< used by the scene showing
+    SCENE_ARENA_NEXT,                           //!< used by the next scene, e.g. a preloaded one
+} scene_arena_select_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_SCENE_ARENA__
+
+/*!
+ * \brief open the free arena for the loader of the next scene, so the scratch
+ *        memory it allocates (starting with the control block of the scene)
+ *        comes from there until scene_arena_close_next().
+ * \note call it right before a scene loader. The arena of the current scene
+ *       stays the current one, see scene_arena_switch_to_next().
+ */
+extern
+void scene_arena_open_next(void);
+
+/*!
+ * \brief route the allocations back to the arena of the current scene
+ * \note call it right after the scene loader
+ */
+extern
+void scene_arena_close_next(void);
+
+/*!
+ * \brief make the arena opened by scene_arena_open_next() the current one,
+ *        i.e. the scene loaded into it starts showing
+ * \note call it when the scene player switches to the next scene. Between a
+ *       preload and the switching, the current scene keeps allocating from
+ *       its own arena.
+ */
+extern
+void scene_arena_switch_to_next(void);
+
+/*!
+ * \brief check whether the next allocation is the control block of the scene
+ *        being loaded. It must come from the arena, otherwise the arena cannot
+ *        be released when the scene frees it.
+ * \retval true the next allocation is the control block
+ * \retval false the next allocation is an ordinary one
+ */
+extern
+bool scene_arena_is_waiting_control_block(void);
+
+/*!
+ * \brief allocate memory from the arena of the current scene
+ * \param[in] wSize the size in bytes
+ * \param[in] nAlign the alignment
+ * \return void* the memory, NULL means the arena is exhausted
+ */
+extern
+void *scene_arena_allocate(uint32_t wSize, uint_fast8_t nAlign);
+
+/*!
+ * \brief free memory allocated from an arena. Freeing the control block of a
+ *        scene, i.e. the first block after scene_arena_open_next(), 
+ *        releases the whole arena.
+ * \param[in] pBuffer the memory
+ * \retval true the memory belongs to an arena
+ * \retval false the memory does not belong to any arena
+ */
+extern
+bool scene_arena_free(void *pBuffer);
+
+/*!
+ * \brief get the statistics of an arena, which are kept until the arena is
+ *        used by another scene
+ * \param[out] ptInfo the statistics
+ * \param[in] tWhich the arena
+ */
+extern
+void scene_arena_get_info(scene_arena_info_t *ptInfo, scene_arena_select_t tWhich);
+
+/*!
+ * \brief print the statistics of an arena
+ * \param[in] tWhich the arena
+ */
+extern
+void scene_arena_dump_info(scene_arena_select_t tWhich);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./scene_arena.h"
+#include "./scratch_workspace.h"
+#include "./slab_pool.h"
+#include "./mem_watermark.h"
+
+#if     __PLATFORM_CFG_USE_SCENE_ARENA__                                        \
+    ||  __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__                                  \
+    ||  __PLATFORM_CFG_USE_SLAB_POOL__                                          \
+    ||  __PLATFORM_CFG_USE_MEM_WATERMARK__
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+/*!
+ * \brief the scratch memory of Arm-2D, it overrides the weak implementation
+ *        in Arm-2D. The requests are served in the following order:
+ *        - ARM_2D_MEM_TYPE_FAST: the size-classed workspaces
+ *        - the slab pools (up to 512 bytes), except the control block of a
+ *          scene being loaded, which must come from the scene arena
+ *        - the arena of the current scene
+ *        - the heap
+ * \note the small blocks go to the slabs first, as a small block in the 
+ *       middle of a scene arena blocks the LIFO roll back of the blocks under
+ *       it until it is freed. See tests/host/scratch_memory_trace_test.c.
+ */
+static void *__scratch_memory_allocate( uint32_t wSize,
+                                        uint_fast8_t nAlign,
+                                        arm_2d_mem_type_t tType)
+{
+    void *pBuffer = NULL;
+    ARM_2D_UNUSED(tType);
+
+#if __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__
+    if (ARM_2D_MEM_TYPE_FAST == tType) {
+        pBuffer = scratch_workspace_acquire(wSize, nAlign);
+        if (NULL != pBuffer) {
+            return pBuffer;
+        }
+    }
+#endif
+
+#if __PLATFORM_CFG_USE_SLAB_POOL__
+#   if __PLATFORM_CFG_USE_SCENE_ARENA__
+    if (!scene_arena_is_waiting_control_block())
+#   endif
+    {
+        pBuffer = slab_pool_allocate(wSize, nAlign);
+        if (NULL != pBuffer) {
+            return pBuffer;
+        }
+    }
+#endif
+
+#if __PLATFORM_CFG_USE_SCENE_ARENA__
+    pBuffer = scene_arena_allocate(wSize, nAlign);
+    if (NULL != pBuffer) {
+        return pBuffer;
+    }
+#endif
+
+    /* the heap only guarantees 8 bytes alignment */
+    assert(nAlign <= 8);
+    return mem_watermark_heap_alloc(wSize);
+}
+
+void * __arm_2d_allocate_scratch_memory(uint32_t wSize,
+                                        uint_fast8_t nAlign,
+                                        arm_2d_mem_type_t tType)
+{
+    void *pBuffer = __scratch_memory_allocate(wSize, nAlign, tType);
+
+#if __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__
+    printf( "[scratch] A %p %"PRIu32" %d %d\r\n", 
+            pBuffer, wSize, (int)nAlign, (int)tType);
+#endif
+
+    return pBuffer;
+}
+
+void __arm_2d_free_scratch_memory(  arm_2d_mem_type_t tType,
+                                    void *pBuff)
+{
+    ARM_2D_UNUSED(tType);
+
+    if (NULL == pBuff) {
+        return ;
+    }
+
+#if __PLATFORM_CFG_SCRATCH_MEMORY_TRACE__
+    printf("[scratch] F %p\r\n", pBuff);
+#endif
+
+#if __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__
+    if (scratch_workspace_release(pBuff)) {
+        return ;
+    }
+#endif
+
+#if __PLATFORM_CFG_USE_SCENE_ARENA__
+    if (scene_arena_free(pBuff)) {
+        return ;
+    }
+#endif
+
+#if __PLATFORM_CFG_USE_SLAB_POOL__
+    if (slab_pool_free(pBuff)) {
+        return ;
+    }
+#endif
+
+    mem_watermark_heap_free(pBuff);
+}
+
+#endif
@@ -0,0 +1,229 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./scratch_workspace.h"
+#include "./mem_watermark.h"
+
+#if __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+typedef struct __scratch_workspace_class_t {
+    void *pBuffers[__PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__];
+    uint8_t chInUseMask;
+    uint8_t chPeak;
+    uint8_t chTrimPeak;                         //!< the peak since the last trim
+    uint32_t wHits;
+    uint32_t wMisses;
+} __scratch_workspace_class_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+static
+__scratch_workspace_class_t s_tWorkspaces[SCRATCH_WORKSPACE_CLASS_COUNT];
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+static uint_fast8_t __scratch_workspace_count_bits(uint_fast8_t chMask)
+{
+    uint_fast8_t chCount = 0;
+    while(chMask) {
+        chMask &= chMask - 1;
+        chCount++;
+    }
+    return chCount;
+}
+
+void *scratch_workspace_acquire(uint32_t wSize, uint_fast8_t nAlign)
+{
+    /* malloc guarantees 8 bytes alignment */
+    if (nAlign > 8) {
+        return NULL;
+    }
+
+    uint_fast8_t chClass = 0;
+    uint32_t wClassSize = SCRATCH_WORKSPACE_MIN_SIZE;
+    while (wClassSize < wSize) {
+        wClassSize <<= 1;
+        if (++chClass >= SCRATCH_WORKSPACE_CLASS_COUNT) {
+            return NULL;
+        }
+    }
+
+    __scratch_workspace_class_t *ptClass = &s_tWorkspaces[chClass];
+    void *pBuffer = NULL;
+
+    __IRQ_SAFE {
+        int_fast8_t nFree = -1;
+
+        for (uint_fast8_t n = 0; n < __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__; n++) {
+            if (ptClass->chInUseMask & (1 << n)) {
+                continue;
+            }
+            if (NULL != ptClass->pBuffers[n]) {
+                /* prefer a kept buffer */
+                nFree = n;
+                break;
+            }
+            if (nFree < 0) {
+                nFree = n;
+            }
+        }
+
+        if (nFree >= 0) {
+            if (NULL != ptClass->pBuffers[nFree]) {
+                ptClass->wHits++;
+            } else {
+                ptClass->pBuffers[nFree] = mem_watermark_heap_alloc(wClassSize);
+                ptClass->wMisses++;
+            }
+
+            pBuffer = ptClass->pBuffers[nFree];
+            if (NULL != pBuffer) {
+                ptClass->chInUseMask |= (1 << nFree);
+                uint_fast8_t chInUse 
+                    = __scratch_workspace_count_bits(ptClass->chInUseMask);
+                ptClass->chPeak = MAX(ptClass->chPeak, chInUse);
+                ptClass->chTrimPeak = MAX(ptClass->chTrimPeak, chInUse);
+            }
+        }
+    }
+
+    return pBuffer;
+}
+
+bool scratch_workspace_release(void *pBuffer)
+{
+    if (NULL == pBuffer) {
+        return false;
+    }
+
+    bool bResult = false;
+
+    __IRQ_SAFE {
+        arm_foreach(__scratch_workspace_class_t, s_tWorkspaces, ptClass) {
+            for (uint_fast8_t n = 0; n < __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__; n++) {
+                if (ptClass->pBuffers[n] == pBuffer) {
+                    ptClass->chInUseMask &= ~(1 << n);
+                    bResult = true;
+                    break;
+                }
+            }
+            if (bResult) {
+                break;
+            }
+        }
+    }
+
+    return bResult;
+}
+
+void scratch_workspace_trim(void)
+{
+    arm_foreach(__scratch_workspace_class_t, s_tWorkspaces, ptClass) {
+        void *pBuffers[__PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__];
+        uint_fast8_t chCount = 0;
+
+        __IRQ_SAFE {
+            uint_fast8_t chKeep = ptClass->chTrimPeak;
+            uint_fast8_t chReserved = 0;
+
+            for (uint_fast8_t n = 0; n < __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__; n++) {
+                chReserved += (NULL != ptClass->pBuffers[n]);
+            }
+
+            for (uint_fast8_t n = 0; n < __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__; n++) {
+                if (chReserved <= chKeep) {
+                    break;
+                }
+                /* the buffers in use always stay */
+                if (    (NULL == ptClass->pBuffers[n])
+                    ||  (ptClass->chInUseMask & (1 << n))) {
+                    continue;
+                }
+
+                pBuffers[chCount++] = ptClass->pBuffers[n];
+                ptClass->pBuffers[n] = NULL;
+                chReserved--;
+            }
+
+            ptClass->chTrimPeak 
+                = __scratch_workspace_count_bits(ptClass->chInUseMask);
+        }
+
+        /* free them outside the critical section */
+        while (chCount) {
+            mem_watermark_heap_free(pBuffers[--chCount]);
+        }
+    }
+}
+
+void scratch_workspace_get_info(uint_fast8_t chClass, 
+                                scratch_workspace_class_info_t *ptInfo)
+{
+    assert(chClass < SCRATCH_WORKSPACE_CLASS_COUNT);
+    assert(NULL != ptInfo);
+
+    __scratch_workspace_class_t *ptClass = &s_tWorkspaces[chClass];
+    uint_fast8_t chReserved = 0;
+    for (uint_fast8_t n = 0; n < __PLATFORM_CFG_SCRATCH_WORKSPACE_SLOTS__; n++) {
+        chReserved += (NULL != ptClass->pBuffers[n]);
+    }
+
+    *ptInfo = (scratch_workspace_class_info_t) {
+        .wSize = SCRATCH_WORKSPACE_MIN_SIZE << chClass,
+        .chReserved = chReserved,
+        .chInUse = __scratch_workspace_count_bits(ptClass->chInUseMask),
+        .chPeak = ptClass->chPeak,
+        .wHits = ptClass->wHits,
+        .wMisses = ptClass->wMisses,
+    };
+}
+
+void scratch_workspace_dump_info(void)
+{
+    for (uint_fast8_t n = 0; n < SCRATCH_WORKSPACE_CLASS_COUNT; n++) {
+        scratch_workspace_class_info_t tInfo;
+        scratch_workspace_get_info(n, &tInfo);
+
+        if (0 == tInfo.chReserved) {
+            continue;
+        }
+
+        printf( "[workspace] %5"PRIu32"B: %d reserved, %d in use, peak %d, "
+                "hit %"PRIu32" miss %"PRIu32"\r\n",
+                tInfo.wSize,
+                tInfo.chReserved,
+                tInfo.chInUse,
+                tInfo.chPeak,
+                tInfo.wHits,
+                tInfo.wMisses);
+    }
+}
+
+#endif
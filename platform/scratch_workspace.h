@@ -0,0 +1,115 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_SCRATCH_WORKSPACE_H__
+#define __BADGER_RP2040_SCRATCH_WORKSPACE_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+#define SCRATCH_WORKSPACE_MIN_SIZE          256
+#define SCRATCH_WORKSPACE_CLASS_COUNT       6       /* 256B ~ 8KB */
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_SCRATCH_WORKSPACE__
+#   define scratch_workspace_trim()
+#   define scratch_workspace_dump_info()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the statistics of a workspace size class
+ */
+typedef struct scratch_workspace_class_info_t {
+    uint32_t wSize;                             //!< the size of the class
+    uint8_t chReserved;                         //!< buffers allocated from the heap
+    uint8_t chInUse;                            //!< buffers in use
+    uint8_t chPeak;                             //!< the peak number of buffers in use
+    uint32_t wHits;                             //!< requests served by a kept buffer
+    uint32_t wMisses;                           //!< requests served by the heap
+} scratch_workspace_class_info_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_SCRATCH_WORKSPACE__
+
+/*!
+ * \brief acquire a workspace of at least the given size
+ * \note the workspace is kept for reuse after release, please acquire it 
+ *       once when a scene is loaded and release it in depose
+ * \param[in] wSize the size in bytes
+ * \param[in] nAlign the alignment, no more than 8
+ * \return void* the workspace, NULL means the request is not handled, e.g.
+ *         too big or all the slots of the class are in use
+ */
+extern
+void *scratch_workspace_acquire(uint32_t wSize, uint_fast8_t nAlign);
+
+/*!
+ * \brief give a workspace back for reuse
+ * \param[in] pBuffer the workspace
+ * \retval true the buffer is a workspace
+ * \retval false the buffer does not belong to any workspace
+ */
+extern
+bool scratch_workspace_release(void *pBuffer);
+
+/*!
+ * \brief free the kept buffers of each class above the peak number of
+ *        buffers in use since the last trim, so a scene that needed many
+ *        workspaces does not keep the heap for the scenes after it
+ * \note call it when a scene is switched out. The buffers still in use are
+ *       never freed.
+ */
+extern
+void scratch_workspace_trim(void);
+
+/*!
+ * \brief get the statistics of a size class
+ * \param[in] chClass the index of the size class
+ * \param[out] ptInfo the statistics
+ */
+extern
+void scratch_workspace_get_info(uint_fast8_t chClass, 
+                                scratch_workspace_class_info_t *ptInfo);
+
+/*!
+ * \brief print the statistics of the classes in use
+ */
+extern
+void scratch_workspace_dump_info(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,211 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./slab_pool.h"
+
+#if __PLATFORM_CFG_USE_SLAB_POOL__
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "hardware/sync.h"
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+/* the classes are laid out from the biggest to the smallest, so every class
+ * starts with its natural alignment (up to SLAB_POOL_MAX_ALIGNMENT)
+ */
+#define SLAB_POOL_SIZE                                                          \
+            (   __PLATFORM_CFG_SLAB_POOL_512B_BLOCKS__ * 512                    \
+            +   __PLATFORM_CFG_SLAB_POOL_256B_BLOCKS__ * 256                    \
+            +   __PLATFORM_CFG_SLAB_POOL_128B_BLOCKS__ * 128                    \
+            +   __PLATFORM_CFG_SLAB_POOL_64B_BLOCKS__ * 64                      \
+            +   __PLATFORM_CFG_SLAB_POOL_32B_BLOCKS__ * 32                      \
+            +   __PLATFORM_CFG_SLAB_POOL_16B_BLOCKS__ * 16)
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+typedef struct __slab_pool_block_t __slab_pool_block_t;
+struct __slab_pool_block_t {
+    __slab_pool_block_t *ptNext;
+};
+
+typedef struct __slab_pool_class_t {
+    uint8_t *pchBase;
+    uint16_t hwBlocks;
+
+    __slab_pool_block_t *ptFree;
+    uint16_t hwCurrent;
+    uint16_t hwPeak;
+    uint32_t wFailures;
+} __slab_pool_class_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+static
+struct {
+    spin_lock_t *ptLock;
+
+    /* index 0 is the 16 bytes class */
+    __slab_pool_class_t tClasses[SLAB_POOL_CLASS_COUNT];
+
+    uint8_t chPool[SLAB_POOL_SIZE + 1] __ALIGNED(SLAB_POOL_MAX_ALIGNMENT);
+} s_tSlabPool = {
+    .tClasses = {
+        [0] = {.hwBlocks = __PLATFORM_CFG_SLAB_POOL_16B_BLOCKS__,   },
+        [1] = {.hwBlocks = __PLATFORM_CFG_SLAB_POOL_32B_BLOCKS__,   },
+        [2] = {.hwBlocks = __PLATFORM_CFG_SLAB_POOL_64B_BLOCKS__,   },
+        [3] = {.hwBlocks = __PLATFORM_CFG_SLAB_POOL_128B_BLOCKS__,  },
+        [4] = {.hwBlocks = __PLATFORM_CFG_SLAB_POOL_256B_BLOCKS__,  },
+        [5] = {.hwBlocks = __PLATFORM_CFG_SLAB_POOL_512B_BLOCKS__,  },
+    },
+};
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+void slab_pool_init(void)
+{
+    /* M0+ has no exclusive access, a hardware spinlock guards both cores */
+    s_tSlabPool.ptLock = spin_lock_init(spin_lock_claim_unused(true));
+
+    uint8_t *pchBlock = s_tSlabPool.chPool;
+
+    for (int_fast8_t n = SLAB_POOL_CLASS_COUNT - 1; n >= 0; n--) {
+        __slab_pool_class_t *ptClass = &s_tSlabPool.tClasses[n];
+        uint16_t hwBlockSize = SLAB_POOL_MIN_BLOCK_SIZE << n;
+
+        ptClass->pchBase = pchBlock;
+        ptClass->ptFree = NULL;
+
+        /* build the free list backwards, so the lowest block comes first */
+        for (int_fast16_t i = ptClass->hwBlocks - 1; i >= 0; i--) {
+            __slab_pool_block_t *ptBlock 
+                = (__slab_pool_block_t *)(pchBlock + i * hwBlockSize);
+            ptBlock->ptNext = ptClass->ptFree;
+            ptClass->ptFree = ptBlock;
+        }
+
+        pchBlock += ptClass->hwBlocks * hwBlockSize;
+    }
+}
+
+void *slab_pool_allocate(uint32_t wSize, uint_fast8_t nAlign)
+{
+    if (NULL == s_tSlabPool.ptLock || nAlign > SLAB_POOL_MAX_ALIGNMENT) {
+        return NULL;
+    }
+
+    /* the block size decides the alignment */
+    wSize = MAX(wSize, nAlign);
+
+    uint_fast8_t chClass = 0;
+    while ((uint32_t)(SLAB_POOL_MIN_BLOCK_SIZE << chClass) < wSize) {
+        if (++chClass >= SLAB_POOL_CLASS_COUNT) {
+            return NULL;
+        }
+    }
+
+    __slab_pool_class_t *ptClass = &s_tSlabPool.tClasses[chClass];
+    __slab_pool_block_t *ptBlock = NULL;
+
+    uint32_t wSave = spin_lock_blocking(s_tSlabPool.ptLock);
+
+    ptBlock = ptClass->ptFree;
+    if (NULL != ptBlock) {
+        ptClass->ptFree = ptBlock->ptNext;
+        ptClass->hwCurrent++;
+        ptClass->hwPeak = MAX(ptClass->hwPeak, ptClass->hwCurrent);
+    } else {
+        /* no fall through to a bigger class, keep the latency bounded */
+        ptClass->wFailures++;
+    }
+
+    spin_unlock(s_tSlabPool.ptLock, wSave);
+
+    return ptBlock;
+}
+
+bool slab_pool_free(void *pBuffer)
+{
+    uint8_t *pchBuffer = (uint8_t *)pBuffer;
+
+    if (    pchBuffer < s_tSlabPool.chPool 
+        ||  pchBuffer >= s_tSlabPool.chPool + SLAB_POOL_SIZE) {
+        return false;
+    }
+
+    /* the classes are laid out from the biggest to the smallest */
+    uint_fast8_t chClass = 0;
+    while (pchBuffer < s_tSlabPool.tClasses[chClass].pchBase) {
+        chClass++;
+    }
+
+    __slab_pool_class_t *ptClass = &s_tSlabPool.tClasses[chClass];
+    __slab_pool_block_t *ptBlock = (__slab_pool_block_t *)pBuffer;
+
+    assert(0 == ((pchBuffer - ptClass->pchBase) 
+                    & ((SLAB_POOL_MIN_BLOCK_SIZE << chClass) - 1)));
+
+    uint32_t wSave = spin_lock_blocking(s_tSlabPool.ptLock);
+
+    ptBlock->ptNext = ptClass->ptFree;
+    ptClass->ptFree = ptBlock;
+    ptClass->hwCurrent--;
+
+    spin_unlock(s_tSlabPool.ptLock, wSave);
+
+    return true;
+}
+
+void slab_pool_get_info(uint_fast8_t chClass, slab_pool_class_info_t *ptInfo)
+{
+    assert(chClass < SLAB_POOL_CLASS_COUNT);
+    assert(NULL != ptInfo);
+
+    __slab_pool_class_t *ptClass = &s_tSlabPool.tClasses[chClass];
+
+    *ptInfo = (slab_pool_class_info_t) {
+        .hwBlockSize = SLAB_POOL_MIN_BLOCK_SIZE << chClass,
+        .hwBlocks = ptClass->hwBlocks,
+        .hwCurrent = ptClass->hwCurrent,
+        .hwPeak = ptClass->hwPeak,
+        .wFailures = ptClass->wFailures,
+    };
+}
+
+void slab_pool_dump_info(void)
+{
+    for (uint_fast8_t n = 0; n < SLAB_POOL_CLASS_COUNT; n++) {
+        slab_pool_class_info_t tInfo;
+        slab_pool_get_info(n, &tInfo);
+
+        printf( "[slab pool] %3dB: %3d/%3d in use, peak %3d, %"PRIu32" failures\r\n",
+                tInfo.hwBlockSize,
+                tInfo.hwCurrent,
+                tInfo.hwBlocks,
+                tInfo.hwPeak,
+                tInfo.wFailures);
+    }
+}
+
+#endif
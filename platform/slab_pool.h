@@ -0,0 +1,108 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_SLAB_POOL_H__
+#define __BADGER_RP2040_SLAB_POOL_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+#define SLAB_POOL_MIN_BLOCK_SIZE        16
+#define SLAB_POOL_CLASS_COUNT           6       /* 16B ~ 512B */
+#define SLAB_POOL_MAX_ALIGNMENT         32
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_SLAB_POOL__
+#   define slab_pool_init()
+#   define slab_pool_dump_info()
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the statistics of a slab class
+ */
+typedef struct slab_pool_class_info_t {
+    uint16_t hwBlockSize;
+    uint16_t hwBlocks;                          //!< the number of blocks
+    uint16_t hwCurrent;                         //!< blocks in use
+    uint16_t hwPeak;                            //!< the peak number of blocks in use
+    uint32_t wFailures;                         //!< requests the class cannot serve
+} slab_pool_class_info_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_SLAB_POOL__
+
+/*!
+ * \brief build the free lists and claim the hardware spinlock
+ */
+extern
+void slab_pool_init(void);
+
+/*!
+ * \brief allocate a block from the smallest suitable class
+ * \note a block of size N is aligned to MIN(N, SLAB_POOL_MAX_ALIGNMENT)
+ * \param[in] wSize the size in bytes
+ * \param[in] nAlign the alignment
+ * \return void* the block, NULL means the request cannot be served
+ */
+extern
+void *slab_pool_allocate(uint32_t wSize, uint_fast8_t nAlign);
+
+/*!
+ * \brief free a block
+ * \param[in] pBuffer the block
+ * \retval true the block belongs to the slab pools
+ * \retval false the block does not belong to the slab pools
+ */
+extern
+bool slab_pool_free(void *pBuffer);
+
+/*!
+ * \brief get the statistics of a class
+ * \param[in] chClass the index of the class
+ * \param[out] ptInfo the statistics
+ */
+extern
+void slab_pool_get_info(uint_fast8_t chClass, slab_pool_class_info_t *ptInfo);
+
+/*!
+ * \brief print the statistics of all classes
+ */
+extern
+void slab_pool_dump_info(void);
+
+#endif
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
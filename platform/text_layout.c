@@ -0,0 +1,405 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./text_layout.h"
+
+#include <string.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#define __TEXT_LAYOUT_IS_KEPT(__PTR, __LINE)                                    \
+            (0 == ((__LINE) & ((1ul << (__PTR)->tCFG.chStrideShift) - 1)))
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+static void __text_layout_reset(text_layout_t *ptThis)
+{
+    ptThis->wCursor = 0;
+    ptThis->wLineCount = 0;
+    ptThis->bComplete = false;
+    ptThis->bFull = false;
+    ptThis->tLine = (text_layout_line_t){0};
+
+    ptThis->iWordWidth = 0;
+    ptThis->hwWordGlyphs = 0;
+    ptThis->iSpaceWidth = 0;
+    ptThis->hwSpaceGlyphs = 0;
+
+    memset(ptThis->chAdvance, -1, sizeof(ptThis->chAdvance));
+    ptThis->hwChunkSize = 0;
+
+    if (ptThis->tCFG.hwMaxLines > 0) {
+        ptThis->wLineCount = 1;
+    } else {
+        ptThis->bFull = true;
+    }
+}
+
+void text_layout_init(text_layout_t *ptThis, const text_layout_cfg_t *ptCFG)
+{
+    assert(NULL != ptThis);
+    assert(NULL != ptCFG);
+    assert(NULL != ptCFG->fnGetAdvance);
+    assert(NULL != ptCFG->pchText || NULL != ptCFG->fnRead || 0 == ptCFG->tSize);
+    assert(NULL != ptCFG->ptLines || 0 == ptCFG->hwMaxLines);
+    assert(ptCFG->chStrideShift < 32);
+
+    memset(ptThis, 0, sizeof(text_layout_t));
+    ptThis->tCFG = *ptCFG;
+
+    __text_layout_reset(ptThis);
+}
+
+bool text_layout_set_box(text_layout_t *ptThis, void *pTarget, int16_t iBoxWidth)
+{
+    assert(NULL != ptThis);
+
+    if (    (pTarget == ptThis->tCFG.pTarget)
+        &&  (iBoxWidth == ptThis->tCFG.iBoxWidth)) {
+        return false;
+    }
+
+    ptThis->tCFG.pTarget = pTarget;
+    ptThis->tCFG.iBoxWidth = iBoxWidth;
+    __text_layout_reset(ptThis);
+
+    return true;
+}
+
+static int16_t __text_layout_get_advance(   text_layout_t *ptThis,
+                                            const char *pchChar,
+                                            uint_fast8_t chLength)
+{
+    uint8_t chCode = (uint8_t)*pchChar;
+
+    if (    (1 == chLength)
+        &&  (chCode >= TEXT_LAYOUT_ASCII_FIRST)
+        &&  (chCode <= TEXT_LAYOUT_ASCII_LAST)) {
+        int8_t *pchAdvance = &ptThis->chAdvance[chCode - TEXT_LAYOUT_ASCII_FIRST];
+        if (*pchAdvance < 0) {
+            *pchAdvance = (int8_t)MIN(INT8_MAX,
+                                      ptThis->tCFG.fnGetAdvance(ptThis->tCFG.pTarget,
+                                                                pchChar,
+                                                                1));
+        }
+        return *pchAdvance + ptThis->tCFG.iCharSpacing;
+    }
+
+    return ptThis->tCFG.fnGetAdvance(ptThis->tCFG.pTarget, pchChar, chLength)
+         + ptThis->tCFG.iCharSpacing;
+}
+
+/* keep the current line in the buffer if it is one of the strides */
+static void __text_layout_keep_line(text_layout_t *ptThis)
+{
+    uint32_t wLine = ptThis->wLineCount - 1;
+
+    if (__TEXT_LAYOUT_IS_KEPT(ptThis, wLine)) {
+        ptThis->tCFG.ptLines[wLine >> ptThis->tCFG.chStrideShift] = ptThis->tLine;
+    }
+}
+
+/* keep every other kept line and double the stride, false means it cannot grow */
+static bool __text_layout_grow_stride(text_layout_t *ptThis)
+{
+    if (    (0 == ptThis->tCFG.hwMaxLines)
+        ||  (ptThis->tCFG.chStrideShift >= 30)) {
+        return false;
+    }
+
+    for (uint_fast16_t n = 0; (n << 1) < ptThis->tCFG.hwMaxLines; n++) {
+        ptThis->tCFG.ptLines[n] = ptThis->tCFG.ptLines[n << 1];
+    }
+    ptThis->tCFG.chStrideShift++;
+
+    return true;
+}
+
+/* start a new line at the given offset, false means the buffer is full */
+static bool __text_layout_new_line(text_layout_t *ptThis, uint32_t wOffset)
+{
+    uint32_t wLine = ptThis->wLineCount;
+
+    while ( (0 == ptThis->wLineLimit)
+        &&  __TEXT_LAYOUT_IS_KEPT(ptThis, wLine)
+        &&  (wLine >> ptThis->tCFG.chStrideShift) >= ptThis->tCFG.hwMaxLines) {
+        if (!__text_layout_grow_stride(ptThis)) {
+            break;
+        }
+    }
+
+    if (    (   __TEXT_LAYOUT_IS_KEPT(ptThis, wLine)
+            &&  (wLine >> ptThis->tCFG.chStrideShift) >= ptThis->tCFG.hwMaxLines)
+        ||  (0 != ptThis->wLineLimit && wLine >= ptThis->wLineLimit)) {
+        /* the index ends where the missing line starts */
+        ptThis->wCursor = wOffset;
+        ptThis->bFull = true;
+        return false;
+    }
+
+    __text_layout_keep_line(ptThis);
+
+    ptThis->tLine = (text_layout_line_t) {
+        .wOffset = wOffset,
+    };
+    ptThis->wLineCount++;
+
+    return true;
+}
+
+/* append the pending word to the current line or wrap it to a new line */
+static bool __text_layout_commit_word(text_layout_t *ptThis)
+{
+    if (0 == ptThis->hwWordGlyphs) {
+        return true;
+    }
+
+    text_layout_line_t *ptLine = &ptThis->tLine;
+
+    if (    (ptLine->hwGlyphs > 0)
+        &&  (ptLine->iWidth + ptThis->iSpaceWidth + ptThis->iWordWidth
+                > ptThis->tCFG.iBoxWidth)) {
+        if (!__text_layout_new_line(ptThis, ptThis->wWordOffset)) {
+            return false;
+        }
+    }
+
+    if (ptLine->hwGlyphs > 0) {
+        ptLine->iWidth += ptThis->iSpaceWidth;
+        ptLine->hwGlyphs += ptThis->hwSpaceGlyphs;
+    }
+    ptLine->iWidth += ptThis->iWordWidth;
+    ptLine->hwGlyphs += ptThis->hwWordGlyphs;
+
+    ptThis->iWordWidth = 0;
+    ptThis->hwWordGlyphs = 0;
+    ptThis->iSpaceWidth = 0;
+    ptThis->hwSpaceGlyphs = 0;
+
+    return true;
+}
+
+static uint_fast8_t __text_layout_utf8_length(uint8_t chLead)
+{
+    if (chLead < 0x80) {
+        return 1;
+    } else if ((chLead & 0xE0) == 0xC0) {
+        return 2;
+    } else if ((chLead & 0xF0) == 0xE0) {
+        return 3;
+    } else if ((chLead & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 1;   /* an invalid lead byte takes one byte */
+}
+
+/* get the text from wOffset, a UTF-8 sequence is only cut by the end of the text */
+static const uint8_t *__text_layout_fetch(  text_layout_t *ptThis,
+                                            uint32_t wOffset,
+                                            uint32_t *pwAvailable)
+{
+    uint32_t wLeft = ptThis->tCFG.tSize - wOffset;
+
+    if (NULL != ptThis->tCFG.pchText) {
+        *pwAvailable = wLeft;
+        return (const uint8_t *)ptThis->tCFG.pchText + wOffset;
+    }
+
+    uint32_t wEnd = ptThis->wChunkOffset + ptThis->hwChunkSize;
+
+    /* refill the chunk when it cannot hold the longest UTF-8 sequence */
+    if (    (wOffset < ptThis->wChunkOffset)
+        ||  (wOffset >= wEnd)
+        ||  ((wEnd - wOffset) < 4 && wEnd < ptThis->tCFG.tSize)) {
+        ptThis->wChunkOffset = wOffset;
+        ptThis->hwChunkSize = ptThis->tCFG.fnRead(
+                                    ptThis->tCFG.pSource,
+                                    wOffset,
+                                    ptThis->chChunk,
+                                    (uint16_t)MIN(wLeft, sizeof(ptThis->chChunk)));
+        wEnd = wOffset + ptThis->hwChunkSize;
+    }
+
+    *pwAvailable = wEnd - wOffset;
+    return &ptThis->chChunk[wOffset - ptThis->wChunkOffset];
+}
+
+static void __text_layout_finish(text_layout_t *ptThis)
+{
+    if (__text_layout_commit_word(ptThis)) {
+        __text_layout_keep_line(ptThis);
+        ptThis->bComplete = true;
+    }
+}
+
+bool text_layout_build(text_layout_t *ptThis, uint32_t wBudget)
+{
+    assert(NULL != ptThis);
+
+    size_t tSize = ptThis->tCFG.tSize;
+
+    while (!ptThis->bComplete && !ptThis->bFull && wBudget > 0) {
+
+        uint32_t wOffset = ptThis->wCursor;
+        uint32_t wAvailable = 0;
+        const uint8_t *pchChar = NULL;
+
+        if (wOffset < tSize) {
+            pchChar = __text_layout_fetch(ptThis, wOffset, &wAvailable);
+        }
+
+        if (0 == wAvailable || '\0' == *pchChar) {
+            __text_layout_finish(ptThis);
+            break;
+        }
+
+        uint_fast8_t chLength = __text_layout_utf8_length(*pchChar);
+        chLength = MIN(chLength, wAvailable);
+
+        ptThis->wCursor += chLength;
+        wBudget -= MIN(wBudget, chLength);
+
+        char chChar = (char)*pchChar;
+
+        if ('\n' == chChar) {
+            /* a paragraph ends */
+            if (__text_layout_commit_word(ptThis)) {
+                __text_layout_new_line(ptThis, ptThis->wCursor);
+            }
+            ptThis->iSpaceWidth = 0;
+            ptThis->hwSpaceGlyphs = 0;
+            continue;
+        } else if ('\r' == chChar) {
+            continue;
+        } else if (' ' == chChar || '\t' == chChar) {
+            if (!__text_layout_commit_word(ptThis)) {
+                break;
+            }
+            ptThis->iSpaceWidth += __text_layout_get_advance(ptThis, " ", 1);
+            ptThis->hwSpaceGlyphs++;
+            continue;
+        }
+
+        int16_t iAdvance = __text_layout_get_advance(   ptThis,
+                                                        (const char *)pchChar,
+                                                        chLength);
+
+        if (0 == ptThis->hwWordGlyphs) {
+            ptThis->wWordOffset = wOffset;
+        } else if (ptThis->iWordWidth + iAdvance > ptThis->tCFG.iBoxWidth) {
+            /* a word wider than the box starts a line of its own and is
+             * broken at the character, even when its first part would still
+             * fit into the current line
+             */
+            if (    (ptThis->tLine.hwGlyphs > 0)
+                &&  !__text_layout_new_line(ptThis, ptThis->wWordOffset)) {
+                break;
+            }
+            if (!__text_layout_commit_word(ptThis)) {
+                break;
+            }
+            if (!__text_layout_new_line(ptThis, wOffset)) {
+                break;
+            }
+            ptThis->wWordOffset = wOffset;
+        }
+
+        ptThis->iWordWidth += iAdvance;
+        ptThis->hwWordGlyphs++;
+    }
+
+    return ptThis->bComplete || ptThis->bFull;
+}
+
+uint32_t text_layout_get_line_count(text_layout_t *ptThis)
+{
+    assert(NULL != ptThis);
+    return ptThis->wLineCount;
+}
+
+bool text_layout_is_complete(text_layout_t *ptThis)
+{
+    assert(NULL != ptThis);
+    return ptThis->bComplete || ptThis->bFull;
+}
+
+const text_layout_line_t *text_layout_get_line(text_layout_t *ptThis, uint32_t wLine)
+{
+    assert(NULL != ptThis);
+
+    if (wLine >= ptThis->wLineCount) {
+        return NULL;
+    } else if (wLine + 1 == ptThis->wLineCount) {
+        return &ptThis->tLine;
+    } else if (__TEXT_LAYOUT_IS_KEPT(ptThis, wLine)) {
+        return &ptThis->tCFG.ptLines[wLine >> ptThis->tCFG.chStrideShift];
+    }
+
+    return NULL;
+}
+
+/* find a line that is not kept by rescanning from the nearest kept line */
+static uint32_t __text_layout_rescan(text_layout_t *ptThis, uint32_t wLine)
+{
+    uint_fast8_t chShift = ptThis->tCFG.chStrideShift;
+    const text_layout_line_t *ptKept = &ptThis->tCFG.ptLines[wLine >> chShift];
+    text_layout_line_t tDummy;
+
+    text_layout_t tScan = {
+        .tCFG = ptThis->tCFG,
+    };
+    tScan.tCFG.ptLines = &tDummy;
+    tScan.tCFG.hwMaxLines = 1;
+    tScan.tCFG.chStrideShift = 31;
+
+    __text_layout_reset(&tScan);
+    memcpy(tScan.chAdvance, ptThis->chAdvance, sizeof(tScan.chAdvance));
+
+    /* a line always starts with a clean state */
+    tScan.wCursor = ptKept->wOffset;
+    tScan.tLine.wOffset = ptKept->wOffset;
+    tScan.wLineLimit = (wLine & ((1ul << chShift) - 1)) + 1;
+
+    text_layout_build(&tScan, UINT32_MAX);
+
+    return tScan.tLine.wOffset;
+}
+
+int32_t text_layout_get_line_offset(text_layout_t *ptThis, uint32_t wLine)
+{
+    assert(NULL != ptThis);
+
+    if (wLine < ptThis->wLineCount) {
+        const text_layout_line_t *ptLine = text_layout_get_line(ptThis, wLine);
+        if (NULL != ptLine) {
+            return (int32_t)ptLine->wOffset;
+        }
+        return (int32_t)__text_layout_rescan(ptThis, wLine);
+    } else if (wLine == ptThis->wLineCount && text_layout_is_complete(ptThis)) {
+        /* the end of the indexed text */
+        return (int32_t)ptThis->wCursor;
+    }
+
+    return -1;
+}
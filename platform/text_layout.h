@@ -0,0 +1,208 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_TEXT_LAYOUT_H__
+#define __BADGER_RP2040_TEXT_LAYOUT_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+/* the advances of the printable ASCII characters are cached */
+#define TEXT_LAYOUT_ASCII_FIRST     0x20
+#define TEXT_LAYOUT_ASCII_LAST      0x7E
+
+/* the number of bytes fetched by text_layout_cfg_t::fnRead at a time */
+#ifndef TEXT_LAYOUT_CHUNK_SIZE
+#   define TEXT_LAYOUT_CHUNK_SIZE      32
+#endif
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief a line in the index (8 bytes)
+ */
+typedef struct text_layout_line_t {
+    uint32_t wOffset;                           //!< the byte offset of the line
+    int16_t iWidth;                             //!< the width without the trailing spaces
+    uint16_t hwGlyphs;                          //!< the number of glyphs, including the inner spaces
+} text_layout_line_t;
+
+/*!
+ * \brief measure the advance of a character
+ * \param[in] pTarget the user target, e.g. the font
+ * \param[in] pchChar the UTF-8 sequence of the character
+ * \param[in] chLength the length of the sequence
+ * \return int16_t the advance in pixels
+ */
+typedef int16_t text_layout_get_advance_t(  void *pTarget,
+                                            const char *pchChar,
+                                            uint_fast8_t chLength);
+
+/*!
+ * \brief read a part of the text, e.g. from a storage which is not memory-mapped
+ * \param[in] pSource the user source, e.g. a reader
+ * \param[in] wOffset the offset in the text
+ * \param[out] pchBuffer the buffer
+ * \param[in] hwSize the number of bytes to read
+ * \return uint16_t the number of bytes read
+ */
+typedef uint16_t text_layout_read_t(void *pSource,
+                                    uint32_t wOffset,
+                                    uint8_t *pchBuffer,
+                                    uint16_t hwSize);
+
+typedef struct text_layout_cfg_t {
+    const char *pchText;                        //!< the text in memory, NULL means reading it with fnRead
+    size_t tSize;                               //!< the size of the text, a '\0' ends the text earlier
+
+    text_layout_read_t *fnRead;
+    void *pSource;                              //!< passed to fnRead
+
+    text_layout_get_advance_t *fnGetAdvance;
+    void *pTarget;                              //!< the font, passed to fnGetAdvance
+
+    int16_t iBoxWidth;
+    int16_t iCharSpacing;
+
+    text_layout_line_t *ptLines;                //!< the buffer of the index
+    uint16_t hwMaxLines;
+
+    /* only every (1 << chStrideShift) lines are kept in the buffer, the
+     * lines in between are found by rescanning from the nearest kept line,
+     * i.e. a sparse index for documents much larger than the buffer. The
+     * stride is doubled whenever the buffer runs out of lines.
+     */
+    uint8_t chStrideShift;
+} text_layout_cfg_t;
+
+/*!
+ * \brief an index of the line breaks of a text, built incrementally with
+ *        greedy word wrapping
+ */
+typedef struct text_layout_t {
+    text_layout_cfg_t tCFG;
+
+    uint32_t wCursor;                           //!< the bytes consumed so far
+    uint32_t wLineCount;
+    uint32_t wLineLimit;                        //!< stop before this line, 0 means no limit
+    bool bComplete;                             //!< the whole text is indexed
+    bool bFull;                                 //!< the buffer runs out of lines and the stride cannot grow
+
+    text_layout_line_t tLine;                   //!< the line being built
+
+    /* the word being measured and the spaces in front of it */
+    uint32_t wWordOffset;
+    int16_t iWordWidth;
+    uint16_t hwWordGlyphs;
+    int16_t iSpaceWidth;
+    uint16_t hwSpaceGlyphs;
+
+    int8_t chAdvance[TEXT_LAYOUT_ASCII_LAST - TEXT_LAYOUT_ASCII_FIRST + 1];   //!< -1 means unknown
+
+    /* the bytes fetched by fnRead */
+    uint32_t wChunkOffset;
+    uint16_t hwChunkSize;
+    uint8_t chChunk[TEXT_LAYOUT_CHUNK_SIZE];
+} text_layout_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+/*!
+ * \brief initialize an empty index
+ * \param[in] ptThis the index
+ * \param[in] ptCFG the configuration, copied
+ */
+extern
+void text_layout_init(text_layout_t *ptThis, const text_layout_cfg_t *ptCFG);
+
+/*!
+ * \brief change the font or the width of the box, the index is only
+ *        invalidated when one of them changes
+ * \param[in] ptThis the index
+ * \param[in] pTarget the font, passed to fnGetAdvance
+ * \param[in] iBoxWidth the width of the box
+ * \retval true the index is invalidated
+ * \retval false nothing changes
+ */
+extern
+bool text_layout_set_box(text_layout_t *ptThis, void *pTarget, int16_t iBoxWidth);
+
+/*!
+ * \brief index more text
+ * \param[in] ptThis the index
+ * \param[in] wBudget the maximum number of bytes to consume
+ * \retval true the index is complete (or full)
+ * \retval false there is more text to index
+ */
+extern
+bool text_layout_build(text_layout_t *ptThis, uint32_t wBudget);
+
+/*!
+ * \brief get the number of lines indexed so far
+ * \param[in] ptThis the index
+ * \return uint32_t the number of lines
+ */
+extern
+uint32_t text_layout_get_line_count(text_layout_t *ptThis);
+
+/*!
+ * \brief check whether the whole text is indexed
+ * \param[in] ptThis the index
+ * \return bool the result
+ */
+extern
+bool text_layout_is_complete(text_layout_t *ptThis);
+
+/*!
+ * \brief get a line of the index in O(1)
+ * \note the last indexed line might still grow until the next line starts
+ * \param[in] ptThis the index
+ * \param[in] wLine the line number
+ * \return const text_layout_line_t* the line or NULL if it is not indexed yet
+ *         or it is not kept by a sparse index
+ */
+extern
+const text_layout_line_t *text_layout_get_line(text_layout_t *ptThis, uint32_t wLine);
+
+/*!
+ * \brief get the byte offset where a line starts, in O(1) for a dense index
+ *        and in O(1 << chStrideShift) lines for a sparse one
+ * \param[in] ptThis the index
+ * \param[in] wLine the line number, the line count means the end of the text
+ * \return int32_t the offset or -1 if the line is not indexed yet
+ */
+extern
+int32_t text_layout_get_line_offset(text_layout_t *ptThis, uint32_t wLine);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,314 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./timer_wheel.h"
+
+#include <string.h>
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+
+#define TIMER_WHEEL_SLOT_MASK       (TIMER_WHEEL_SLOTS - 1)
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#define __TIMER_WHEEL_SHIFT(__LEVEL)    ((__LEVEL) * TIMER_WHEEL_SLOT_BITS)
+
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+static timer_wheel_t s_tSystemTimerWheel;
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+void timer_wheel_init(timer_wheel_t *ptThis, uint32_t wNow)
+{
+    assert(NULL != ptThis);
+
+    memset(ptThis, 0, sizeof(timer_wheel_t));
+    ptThis->wNow = wNow;
+}
+
+static void __timer_wheel_insert(timer_wheel_t *ptThis, 
+                                 timer_wheel_timer_t *ptTimer)
+{
+    uint32_t wDelta = ptTimer->wExpire - ptThis->wNow;
+
+    /* a late periodic timer fires at the next tick */
+    if ((int32_t)wDelta < 0) {
+        ptTimer->wExpire = ptThis->wNow + 1;
+        wDelta = 1;
+    }
+
+    uint_fast8_t chLevel = 0;
+    while (     chLevel < TIMER_WHEEL_LEVELS 
+            &&  wDelta >= (1ul << __TIMER_WHEEL_SHIFT(chLevel + 1))) {
+        chLevel++;
+    }
+
+    uint32_t wIndex;
+    if (chLevel >= TIMER_WHEEL_LEVELS) {
+        /* park it in the farthest slot of the last level */
+        chLevel = TIMER_WHEEL_LEVELS - 1;
+        wIndex = (ptThis->wNow >> __TIMER_WHEEL_SHIFT(chLevel)) 
+               + TIMER_WHEEL_SLOTS - 1;
+    } else {
+        wIndex = ptTimer->wExpire >> __TIMER_WHEEL_SHIFT(chLevel);
+    }
+
+    uint_fast8_t chSlot = wIndex & TIMER_WHEEL_SLOT_MASK;
+    timer_wheel_timer_t **pptHead = &ptThis->ptSlots[chLevel][chSlot];
+
+    ptTimer->chLevel = chLevel;
+    ptTimer->chSlot = chSlot;
+    ptTimer->ptNext = *pptHead;
+    ptTimer->pptPrev = pptHead;
+    if (NULL != *pptHead) {
+        (*pptHead)->pptPrev = &ptTimer->ptNext;
+    }
+    *pptHead = ptTimer;
+
+    ptThis->dwOccupied[chLevel] |= (1ull << chSlot);
+}
+
+static void __timer_wheel_unlink(timer_wheel_t *ptThis, 
+                                 timer_wheel_timer_t *ptTimer)
+{
+    *ptTimer->pptPrev = ptTimer->ptNext;
+    if (NULL != ptTimer->ptNext) {
+        ptTimer->ptNext->pptPrev = ptTimer->pptPrev;
+    }
+
+    if (NULL == ptThis->ptSlots[ptTimer->chLevel][ptTimer->chSlot]) {
+        ptThis->dwOccupied[ptTimer->chLevel] &= ~(1ull << ptTimer->chSlot);
+    }
+
+    ptTimer->ptNext = NULL;
+    ptTimer->pptPrev = NULL;
+}
+
+void timer_wheel_start( timer_wheel_t *ptThis,
+                        timer_wheel_timer_t *ptTimer,
+                        uint32_t wDelay,
+                        uint32_t wPeriod,
+                        timer_wheel_handler_t *fnHandler,
+                        void *pTarget)
+{
+    assert(NULL != ptThis);
+    assert(NULL != ptTimer);
+    assert(NULL != fnHandler);
+
+    timer_wheel_stop(ptThis, ptTimer);
+
+    ptTimer->wExpire = ptThis->wNow + MAX(wDelay, 1);
+    ptTimer->wPeriod = wPeriod;
+    ptTimer->fnHandler = fnHandler;
+    ptTimer->pTarget = pTarget;
+
+    __timer_wheel_insert(ptThis, ptTimer);
+    ptThis->hwCount++;
+}
+
+void timer_wheel_stop(timer_wheel_t *ptThis, timer_wheel_timer_t *ptTimer)
+{
+    assert(NULL != ptThis);
+    assert(NULL != ptTimer);
+
+    if (NULL == ptTimer->pptPrev) {
+        return ;
+    }
+
+    __timer_wheel_unlink(ptThis, ptTimer);
+    ptThis->hwCount--;
+}
+
+bool timer_wheel_is_active(const timer_wheel_timer_t *ptTimer)
+{
+    assert(NULL != ptTimer);
+
+    return NULL != ptTimer->pptPrev;
+}
+
+static void __timer_wheel_cascade(  timer_wheel_t *ptThis, 
+                                    uint_fast8_t chLevel, 
+                                    uint_fast8_t chSlot)
+{
+    timer_wheel_timer_t *ptTimer = ptThis->ptSlots[chLevel][chSlot];
+
+    ptThis->ptSlots[chLevel][chSlot] = NULL;
+    ptThis->dwOccupied[chLevel] &= ~(1ull << chSlot);
+
+    while (NULL != ptTimer) {
+        timer_wheel_timer_t *ptNext = ptTimer->ptNext;
+        __timer_wheel_insert(ptThis, ptTimer);
+        ptTimer = ptNext;
+    }
+}
+
+static void __timer_wheel_tick(timer_wheel_t *ptThis)
+{
+    ptThis->wNow++;
+
+    /* cascade the levels whose lower level wraps around, from the top */
+    uint_fast8_t chLevel = 1;
+    while (     chLevel < TIMER_WHEEL_LEVELS 
+            &&  0 == (ptThis->wNow & ((1ul << __TIMER_WHEEL_SHIFT(chLevel)) - 1))) {
+        chLevel++;
+    }
+    while (--chLevel > 0) {
+        __timer_wheel_cascade(  ptThis, 
+                                chLevel, 
+                                (ptThis->wNow >> __TIMER_WHEEL_SHIFT(chLevel)) 
+                                    & TIMER_WHEEL_SLOT_MASK);
+    }
+
+    /* expire, the slot is read again each time as handlers may stop timers */
+    timer_wheel_timer_t **pptHead 
+        = &ptThis->ptSlots[0][ptThis->wNow & TIMER_WHEEL_SLOT_MASK];
+
+    while (NULL != *pptHead) {
+        timer_wheel_timer_t *ptTimer = *pptHead;
+
+        __timer_wheel_unlink(ptThis, ptTimer);
+
+        if (ptTimer->wPeriod) {
+            ptTimer->wExpire += ptTimer->wPeriod;
+            __timer_wheel_insert(ptThis, ptTimer);
+        } else {
+            ptThis->hwCount--;
+        }
+
+        ptTimer->fnHandler(ptTimer->pTarget, ptTimer);
+    }
+}
+
+uint32_t timer_wheel_get_time_to_next(const timer_wheel_t *ptThis)
+{
+    assert(NULL != ptThis);
+
+    if (0 == ptThis->hwCount) {
+        return TIMER_WHEEL_NO_TIMER;
+    }
+
+    uint32_t wResult = TIMER_WHEEL_NO_TIMER;
+
+    for (uint_fast8_t chLevel = 0; chLevel < TIMER_WHEEL_LEVELS; chLevel++) {
+        uint64_t dwOccupied = ptThis->dwOccupied[chLevel];
+        if (0 == dwOccupied) {
+            continue;
+        }
+
+        uint_fast8_t chShift = __TIMER_WHEEL_SHIFT(chLevel);
+
+        /* the first index the slots of this level are processed from */
+        uint32_t wFirst = (ptThis->wNow >> chShift) + 1;
+
+        for (uint_fast8_t chSlot = 0; chSlot < TIMER_WHEEL_SLOTS; chSlot++) {
+            if (!(dwOccupied & (1ull << chSlot))) {
+                continue;
+            }
+
+            uint32_t wIndex = wFirst + ((chSlot - wFirst) & TIMER_WHEEL_SLOT_MASK);
+            wResult = MIN(wResult, (wIndex << chShift) - ptThis->wNow);
+        }
+    }
+
+    return wResult;
+}
+
+void timer_wheel_advance(timer_wheel_t *ptThis, uint32_t wNow)
+{
+    assert(NULL != ptThis);
+
+    /* a handler (re)starting a timer must not advance the wheel under the 
+     * tick that is calling it
+     */
+    if (ptThis->bInTick) {
+        return ;
+    }
+    ptThis->bInTick = true;
+
+    while ((int32_t)(wNow - ptThis->wNow) > 0) {
+        uint32_t wNext = timer_wheel_get_time_to_next(ptThis);
+
+        if (    TIMER_WHEEL_NO_TIMER == wNext 
+            ||  wNext > (wNow - ptThis->wNow)) {
+            ptThis->wNow = wNow;
+            break;
+        }
+
+        /* skip the empty span */
+        ptThis->wNow += wNext - 1;
+        __timer_wheel_tick(ptThis);
+    }
+
+    ptThis->bInTick = false;
+}
+
+/*----------------------------------------------------------------------------*
+ * System Timers                                                              *
+ *----------------------------------------------------------------------------*/
+
+static uint32_t __system_timer_get_ms(void)
+{
+    return (uint32_t)perfc_convert_ticks_to_ms(get_system_ticks());
+}
+
+void system_timer_init(void)
+{
+    timer_wheel_init(&s_tSystemTimerWheel, __system_timer_get_ms());
+}
+
+void system_timer_start(timer_wheel_timer_t *ptTimer,
+                        uint32_t wDelay,
+                        uint32_t wPeriod,
+                        timer_wheel_handler_t *fnHandler,
+                        void *pTarget)
+{
+    /* keep the wheel close to now, so the delay starts from now. It is a no-op
+     * inside a handler, where the wheel time is the expiry being handled.
+     */
+    timer_wheel_advance(&s_tSystemTimerWheel, __system_timer_get_ms());
+
+    timer_wheel_start(  &s_tSystemTimerWheel, 
+                        ptTimer, 
+                        wDelay, 
+                        wPeriod, 
+                        fnHandler, 
+                        pTarget);
+}
+
+void system_timer_stop(timer_wheel_timer_t *ptTimer)
+{
+    timer_wheel_stop(&s_tSystemTimerWheel, ptTimer);
+}
+
+int64_t system_timer_task(void)
+{
+    timer_wheel_advance(&s_tSystemTimerWheel, __system_timer_get_ms());
+
+    uint32_t wNext = timer_wheel_get_time_to_next(&s_tSystemTimerWheel);
+    if (TIMER_WHEEL_NO_TIMER == wNext) {
+        return INT64_MAX;
+    }
+
+    return get_system_ticks() + perfc_convert_ms_to_ticks(wNext);
+}
@@ -0,0 +1,200 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_TIMER_WHEEL_H__
+#define __BADGER_RP2040_TIMER_WHEEL_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+
+/* the resolution of the wheels is 1ms, every level has 64 slots, i.e. the
+ * levels cover 64ms, 4.096s and 262.144s. Longer delays are parked in the
+ * last level and cascaded again.
+ */
+#define TIMER_WHEEL_SLOT_BITS       6
+#define TIMER_WHEEL_SLOTS           (1ul << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_LEVELS          3
+
+/* returned by timer_wheel_get_time_to_next() when no timer is active */
+#define TIMER_WHEEL_NO_TIMER        UINT32_MAX
+
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+
+typedef struct timer_wheel_timer_t timer_wheel_timer_t;
+
+/*!
+ * \brief the handler of an expired timer
+ * \note it is allowed to start or stop any timer inside the handler. The
+ *       handler runs inside timer_wheel_advance(), so the wheel time is the
+ *       expiry of the timer and the delay of a timer started (or restarted)
+ *       in the handler counts from there. Advancing the same wheel again
+ *       inside a handler is ignored.
+ * \param[in] pTarget the user target passed to timer_wheel_start()
+ * \param[in] ptTimer the expired timer
+ */
+typedef void timer_wheel_handler_t(void *pTarget, timer_wheel_timer_t *ptTimer);
+
+/*!
+ * \brief a timer, it is allocated by the user, e.g. as a member of a scene
+ */
+struct timer_wheel_timer_t {
+    timer_wheel_timer_t *ptNext;
+    timer_wheel_timer_t **pptPrev;              //!< NULL means the timer is inactive
+    uint32_t wExpire;                           //!< the deadline in ms
+    uint32_t wPeriod;                           //!< 0 means one-shot
+    timer_wheel_handler_t *fnHandler;
+    void *pTarget;
+    uint8_t chLevel;
+    uint8_t chSlot;
+};
+
+/*!
+ * \brief a hierarchical timer wheel driven by an external ms clock, so it can
+ *        run on a virtual clock as well
+ */
+typedef struct timer_wheel_t {
+    uint32_t wNow;                              //!< the time the wheel advanced to
+    uint16_t hwCount;                           //!< the number of active timers
+    bool bInTick;                               //!< the handlers are running
+    uint64_t dwOccupied[TIMER_WHEEL_LEVELS];    //!< a bit for each non-empty slot
+    timer_wheel_timer_t *ptSlots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+} timer_wheel_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+/*!
+ * \brief initialize a timer wheel
+ * \param[in] ptThis the target wheel
+ * \param[in] wNow the current time in ms
+ */
+extern
+void timer_wheel_init(timer_wheel_t *ptThis, uint32_t wNow);
+
+/*!
+ * \brief start (or restart) a timer, O(1)
+ * \param[in] ptThis the target wheel
+ * \param[in] ptTimer the timer
+ * \param[in] wDelay the delay in ms, 0 means the next advance
+ * \param[in] wPeriod the period in ms, 0 means one-shot
+ * \param[in] fnHandler the handler
+ * \param[in] pTarget the user target passed to the handler
+ */
+extern
+void timer_wheel_start( timer_wheel_t *ptThis,
+                        timer_wheel_timer_t *ptTimer,
+                        uint32_t wDelay,
+                        uint32_t wPeriod,
+                        timer_wheel_handler_t *fnHandler,
+                        void *pTarget);
+
+/*!
+ * \brief stop a timer, O(1). Stopping an inactive timer is allowed.
+ * \param[in] ptThis the target wheel
+ * \param[in] ptTimer the timer
+ */
+extern
+void timer_wheel_stop(timer_wheel_t *ptThis, timer_wheel_timer_t *ptTimer);
+
+/*!
+ * \brief check whether a timer is active
+ * \param[in] ptTimer the timer
+ * \return bool true means the timer is active
+ */
+extern
+bool timer_wheel_is_active(const timer_wheel_timer_t *ptTimer);
+
+/*!
+ * \brief advance the wheel to the given time and call the handlers of the
+ *        expired timers. The empty spans are skipped.
+ * \note it returns immediately when it is called by a handler of the same
+ *       wheel, the outer call finishes the advancing.
+ * \param[in] ptThis the target wheel
+ * \param[in] wNow the current time in ms
+ */
+extern
+void timer_wheel_advance(timer_wheel_t *ptThis, uint32_t wNow);
+
+/*!
+ * \brief get the time from the wheel time to the next expiry or cascade
+ * \note a cascade of an upper level happens no later than the expiry of its
+ *       timers, so the result is always safe to sleep for.
+ * \param[in] ptThis the target wheel
+ * \return uint32_t the time in ms, TIMER_WHEEL_NO_TIMER means no timer
+ */
+extern
+uint32_t timer_wheel_get_time_to_next(const timer_wheel_t *ptThis);
+
+/*----------------------------------------------------------------------------*
+ * System Timers                                                              *
+ *----------------------------------------------------------------------------*/
+
+/*!
+ * \brief initialize the system timer wheel, which runs on the system timestamp
+ */
+extern
+void system_timer_init(void);
+
+/*!
+ * \brief start a timer on the system timer wheel
+ * \note outside the handlers, the wheel is advanced to now first, so the delay
+ *       starts from now. Inside a handler, the delay starts from the expiry
+ *       of the timer being handled.
+ * \param[in] ptTimer the timer
+ * \param[in] wDelay the delay in ms
+ * \param[in] wPeriod the period in ms, 0 means one-shot
+ * \param[in] fnHandler the handler
+ * \param[in] pTarget the user target passed to the handler
+ */
+extern
+void system_timer_start(timer_wheel_timer_t *ptTimer,
+                        uint32_t wDelay,
+                        uint32_t wPeriod,
+                        timer_wheel_handler_t *fnHandler,
+                        void *pTarget);
+
+/*!
+ * \brief stop a timer on the system timer wheel
+ * \param[in] ptTimer the timer
+ */
+extern
+void system_timer_stop(timer_wheel_timer_t *ptTimer);
+
+/*!
+ * \brief advance the system timer wheel to now, it is called by the main loop
+ * \return int64_t the deadline of the next expiry in system ticks, INT64_MAX
+ *         means no timer is active
+ */
+extern
+int64_t system_timer_task(void);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,286 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*============================ INCLUDES ======================================*/
+#include "./platform.h"
+#include "./wall_clock.h"
+#include "./idle_sleep.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if __PLATFORM_CFG_USE_WALL_CLOCK__
+#include "hardware/rtc.h"
+#include "hardware/timer.h"
+#endif
+
+#include "arm_2d.h"
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+/*============================ TYPES =========================================*/
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+#if __PLATFORM_CFG_USE_WALL_CLOCK__
+static
+struct {
+    volatile bool bAlarmArmed;
+    uint8_t chGranularity;                      //!< the granularity of the armed alarm
+
+    /* the system ticks of the last second boundary seen by the alarm, which
+     * gives the sub-second phase the RTC does not provide. 0 means unknown.
+     */
+    volatile int64_t lEdge;
+} s_tWallClock;
+#endif
+
+/*============================ PROTOTYPES ====================================*/
+/*============================ IMPLEMENTATION ================================*/
+
+#if __PLATFORM_CFG_USE_WALL_CLOCK__
+
+static void __wall_clock_to_datetime(datetime_t *ptOut, const wall_clock_time_t *ptIn)
+{
+    *ptOut = (datetime_t) {
+        .year   = ptIn->iYear,
+        .month  = ptIn->chMonth,
+        .day    = ptIn->chDay,
+        .dotw   = ptIn->chDayOfWeek,
+        .hour   = ptIn->chHour,
+        .min    = ptIn->chMin,
+        .sec    = ptIn->chSec,
+    };
+}
+
+static uint_fast8_t __wall_clock_days_in_month(int_fast16_t iYear, int_fast8_t chMonth)
+{
+    static const uint8_t c_chDays[12] = {31,28,31,30,31,30,31,31,30,31,30,31};
+
+    if (    (2 == chMonth)
+        &&  ((0 == (iYear % 4) && 0 != (iYear % 100)) || 0 == (iYear % 400))) {
+        return 29;
+    }
+    return c_chDays[chMonth - 1];
+}
+
+/* 0 is Sunday, Sakamoto's method */
+static int_fast8_t __wall_clock_day_of_week(int_fast16_t iYear,
+                                            int_fast8_t chMonth,
+                                            int_fast8_t chDay)
+{
+    static const uint8_t c_chOffset[12] = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+
+    if (chMonth < 3) {
+        iYear -= 1;
+    }
+    return (iYear + iYear / 4 - iYear / 100 + iYear / 400
+            + c_chOffset[chMonth - 1] + chDay) % 7;
+}
+
+/* add no more than one minute to a time */
+static void __wall_clock_add_seconds(wall_clock_time_t *ptTime, uint_fast8_t chSeconds)
+{
+    int_fast16_t iSec = ptTime->chSec + chSeconds;
+    ptTime->chSec = iSec % 60;
+    if (iSec < 60) {
+        return ;
+    }
+
+    if (++ptTime->chMin < 60) {
+        return ;
+    }
+    ptTime->chMin = 0;
+
+    if (++ptTime->chHour < 24) {
+        return ;
+    }
+    ptTime->chHour = 0;
+    ptTime->chDayOfWeek = (ptTime->chDayOfWeek + 1) % 7;
+
+    if (++ptTime->chDay <= __wall_clock_days_in_month(ptTime->iYear, ptTime->chMonth)) {
+        return ;
+    }
+    ptTime->chDay = 1;
+
+    if (++ptTime->chMonth <= 12) {
+        return ;
+    }
+    ptTime->chMonth = 1;
+    ptTime->iYear++;
+}
+
+static void __wall_clock_on_alarm(void)
+{
+    s_tWallClock.lEdge = get_system_ticks();
+    s_tWallClock.bAlarmArmed = false;
+
+    idle_sleep_notify();
+}
+
+/* arm a one-shot alarm which fires chSeconds later, on a second boundary */
+static void __wall_clock_arm_alarm( const wall_clock_time_t *ptNow,
+                                    uint_fast8_t chSeconds,
+                                    wall_clock_granularity_t tGranularity)
+{
+    /* a one-shot alarm, i.e. all fields are specified. An alarm with
+     * wildcards keeps firing for the whole matching second.
+     */
+    wall_clock_time_t tTarget = *ptNow;
+    __wall_clock_add_seconds(&tTarget, chSeconds);
+
+    datetime_t tAlarm;
+    __wall_clock_to_datetime(&tAlarm, &tTarget);
+
+    s_tWallClock.chGranularity = tGranularity;
+    s_tWallClock.bAlarmArmed = true;
+    rtc_set_alarm(&tAlarm, &__wall_clock_on_alarm);
+}
+
+void wall_clock_init(void)
+{
+    /* __DATE__ is "Mmm dd yyyy" and __TIME__ is "hh:mm:ss" */
+    static const char c_chBuildDate[] = __DATE__;
+    static const char c_chBuildTime[] = __TIME__;
+    static const char c_chMonths[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    wall_clock_time_t tTime = {
+        .iYear = atoi(&c_chBuildDate[7]),
+        .chMonth = 1,
+        .chDay = atoi(&c_chBuildDate[4]),
+        .chHour = atoi(&c_chBuildTime[0]),
+        .chMin = atoi(&c_chBuildTime[3]),
+        .chSec = atoi(&c_chBuildTime[6]),
+    };
+
+    for (int_fast8_t n = 0; n < 12; n++) {
+        if (0 == strncmp(&c_chMonths[n * 3], c_chBuildDate, 3)) {
+            tTime.chMonth = n + 1;
+            break;
+        }
+    }
+
+    rtc_init();
+    wall_clock_set(&tTime);
+}
+
+void wall_clock_set(const wall_clock_time_t *ptTime)
+{
+    assert(NULL != ptTime);
+
+    datetime_t tDateTime;
+    __wall_clock_to_datetime(&tDateTime, ptTime);
+
+    /* the alarm only matches when the day of the week is consistent */
+    tDateTime.dotw = __wall_clock_day_of_week(  ptTime->iYear,
+                                                ptTime->chMonth,
+                                                ptTime->chDay);
+
+    rtc_disable_alarm();
+    s_tWallClock.bAlarmArmed = false;
+    s_tWallClock.lEdge = 0;
+
+    bool bResult = rtc_set_datetime(&tDateTime);
+    assert(bResult);
+    ARM_2D_UNUSED(bResult);
+
+    /* the new value is visible after 2 cycles of the RTC clock, i.e. ~64us */
+    busy_wait_us(64);
+
+    /* the next second boundary gives the sub-second phase again */
+    wall_clock_time_t tNow;
+    wall_clock_get(&tNow);
+    __wall_clock_arm_alarm(&tNow, 1, WALL_CLOCK_GRANULARITY_SECOND);
+}
+
+void wall_clock_get(wall_clock_time_t *ptTime)
+{
+    assert(NULL != ptTime);
+
+    datetime_t tDateTime;
+    rtc_get_datetime(&tDateTime);
+
+    *ptTime = (wall_clock_time_t) {
+        .iYear = tDateTime.year,
+        .chMonth = tDateTime.month,
+        .chDay = tDateTime.day,
+        .chDayOfWeek = tDateTime.dotw,
+        .chHour = tDateTime.hour,
+        .chMin = tDateTime.min,
+        .chSec = tDateTime.sec,
+    };
+}
+
+uint32_t wall_clock_notify_on_change(wall_clock_granularity_t tGranularity)
+{
+    wall_clock_time_t tNow;
+    wall_clock_get(&tNow);
+
+    int64_t lEdge = s_tWallClock.lEdge;
+    if (0 == lEdge) {
+        /* the phase is unknown, e.g. right after wall_clock_set(): keep the
+         * alarm of the next second boundary, which wakes up the main loop
+         */
+        tGranularity = WALL_CLOCK_GRANULARITY_SECOND;
+    }
+
+    uint_fast8_t chSeconds = (WALL_CLOCK_GRANULARITY_MINUTE == tGranularity)
+                           ? 60 - tNow.chSec
+                           : 1;
+
+    if (    !s_tWallClock.bAlarmArmed
+        ||  (s_tWallClock.chGranularity != tGranularity)) {
+        __wall_clock_arm_alarm(&tNow, chSeconds, tGranularity);
+    }
+
+    uint32_t wMS = chSeconds * 1000ul;
+
+    /* remove the elapsed part of the current second */
+    if (0 != lEdge) {
+        wMS -= (uint32_t)(perfc_convert_ticks_to_ms(get_system_ticks() - lEdge)
+                          % 1000ul);
+    }
+
+    return wMS;
+}
+
+#else
+
+/* derive the time of day from the uptime */
+void wall_clock_get(wall_clock_time_t *ptTime)
+{
+    assert(NULL != ptTime);
+
+    int64_t lSeconds = perfc_convert_ticks_to_ms(get_system_ticks()) / 1000ll;
+
+    *ptTime = (wall_clock_time_t) {
+        .chMonth = 1,
+        .chDay = ((lSeconds / 86400ll) % 31) + 1,
+        .chHour = (lSeconds / 3600ll) % 24,
+        .chMin = (lSeconds / 60ll) % 60,
+        .chSec = lSeconds % 60,
+    };
+}
+
+uint32_t wall_clock_notify_on_change(wall_clock_granularity_t tGranularity)
+{
+    uint32_t wPeriod = (uint32_t)tGranularity * 1000ul;
+    int64_t lTimeInMs = perfc_convert_ticks_to_ms(get_system_ticks());
+
+    return wPeriod - (uint32_t)(lTimeInMs % wPeriod);
+}
+
+#endif
@@ -0,0 +1,108 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+
+#ifndef __BADGER_RP2040_WALL_CLOCK_H__
+#define __BADGER_RP2040_WALL_CLOCK_H__
+
+/*============================ INCLUDES ======================================*/
+#include "./platform_cfg.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef   __cplusplus
+extern "C" {
+#endif
+
+/*============================ MACROS ========================================*/
+/*============================ MACROFIED FUNCTIONS ===========================*/
+
+#if !__PLATFORM_CFG_USE_WALL_CLOCK__
+#   define wall_clock_init()
+#   define wall_clock_set(__TIME_PTR)       ((void)(__TIME_PTR))
+#endif
+
+/*============================ TYPES =========================================*/
+
+/*!
+ * \brief the digits a scene shows, i.e. the wall clock only wakes the scene
+ *        up when they change
+ */
+typedef enum {
+    WALL_CLOCK_GRANULARITY_SECOND   = 1,
+    WALL_CLOCK_GRANULARITY_MINUTE   = 60,
+} wall_clock_granularity_t;
+
+/*!
+ * \brief the time of day, the same layout as datetime_t of pico-sdk
+ */
+typedef struct wall_clock_time_t {
+    int16_t iYear;                              //!< 0..4095
+    int8_t chMonth;                             //!< 1..12
+    int8_t chDay;                               //!< 1..31
+    int8_t chDayOfWeek;                         //!< 0..6, 0 is Sunday
+    int8_t chHour;                              //!< 0..23
+    int8_t chMin;                               //!< 0..59
+    int8_t chSec;                               //!< 0..59
+} wall_clock_time_t;
+
+/*============================ GLOBAL VARIABLES ==============================*/
+/*============================ LOCAL VARIABLES ===============================*/
+/*============================ PROTOTYPES ====================================*/
+
+#if __PLATFORM_CFG_USE_WALL_CLOCK__
+/*!
+ * \brief start the RTC and set it to the build time
+ */
+extern
+void wall_clock_init(void);
+
+/*!
+ * \brief set the wall clock, e.g. with the time received from a host
+ * \note the day of the week is derived from the date
+ * \param[in] ptTime the new time
+ */
+extern
+void wall_clock_set(const wall_clock_time_t *ptTime);
+#endif
+
+/*!
+ * \brief read the wall clock
+ * \note it is available even when __PLATFORM_CFG_USE_WALL_CLOCK__ is 0, in
+ *       which case the time is derived from the uptime.
+ * \param[out] ptTime the current time
+ */
+extern
+void wall_clock_get(wall_clock_time_t *ptTime);
+
+/*!
+ * \brief ask for a wakeup of the main loop when the digits of the given
+ *        granularity change, e.g. at the next minute
+ * \note it is usually called in the fnOnFrameStart of a scene and the
+ *       return value is passed to idle_sleep_next_frame_in_ms(). The RTC
+ *       alarm wakes up the main loop on time even when the estimation is late.
+ * \param[in] tGranularity the granularity of the digits
+ * \return uint32_t the estimated time to the change in ms
+ */
+extern
+uint32_t wall_clock_notify_on_change(wall_clock_granularity_t tGranularity);
+
+#ifdef   __cplusplus
+}
+#endif
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if defined(__clang__)
 #   pragma clang diagnostic push
@@ -636,6 +637,18 @@ static IMPL_PFB_BEFORE_FLUSHING(__before_flushing)
 
 #endif
 
+/*! the configuration ARM_2D_HELPER_PFB_INIT() passes to the PFB helper, it is
+ *  kept to initialise the helper again with another PFB size
+ */
+static arm_2d_helper_pfb_cfg_t s_tPFBHelperCFG;
+
+static arm_2d_err_t __disp_adapter0_pfb_init(   arm_2d_helper_pfb_t *ptHelper,
+                                                arm_2d_helper_pfb_cfg_t *ptCFG)
+{
+    s_tPFBHelperCFG = *ptCFG;
+    return arm_2d_helper_pfb_init(ptHelper, ptCFG);
+}
+
 static void __user_scene_player_init(void)
 {
     memset(&DISP0_ADAPTER, 0, sizeof(DISP0_ADAPTER));
@@ -645,7 +658,8 @@ static void __user_scene_player_init(void)
     static arm_2d_region_list_item_t s_tDirtyRegionList[__DISP0_CFG_DIRTY_REGION_POOL_SIZE__]; 
 #endif
 
-    //! initialise FPB helper
+    //! initialise FPB helper, and keep a copy of the configuration
+#define arm_2d_helper_pfb_init      __disp_adapter0_pfb_init
     if (ARM_2D_HELPER_PFB_INIT(
         &DISP0_ADAPTER.use_as__arm_2d_helper_pfb_t,                            //!< FPB Helper object
         __DISP0_CFG_SCEEN_WIDTH__,                                     //!< screen width
@@ -697,6 +711,7 @@ static void __user_scene_player_init(void)
         //! error detected
         assert(false);
     }
+#undef arm_2d_helper_pfb_init
 
 #if __DISP0_CFG_ENABLE_3FB_HELPER_SERVICE__
     do {
@@ -946,18 +961,459 @@ void disp_adapter0_init(void)
 #endif
 }
 
+uint32_t disp_adapter0_get_pfb_buffer_size(void)
+{
+    return s_tPFBHelperCFG.FrameBuffer.u24BufferSize;
+}
+
+bool disp_adapter0_set_pfb_size(arm_2d_size_t tSize)
+{
+    if (    tSize.iWidth <= 0 
+        ||  tSize.iHeight <= 0
+        ||  (uint32_t)tSize.iWidth * (uint32_t)tSize.iHeight * sizeof(COLOUR_INT)
+                >   disp_adapter0_get_pfb_buffer_size()) {
+        return false;
+    }
+
+    if (    tSize.iWidth == s_tPFBHelperCFG.FrameBuffer.tFrameSize.iWidth
+        &&  tSize.iHeight == s_tPFBHelperCFG.FrameBuffer.tFrameSize.iHeight) {
+        return true;
+    }
+
+    s_tPFBHelperCFG.FrameBuffer.tFrameSize = tSize;
+
+    /* the PFB pool and the dependencies given to ARM_2D_HELPER_PFB_INIT() are
+     * part of the configuration, the ones added later are not
+     */
+    if (arm_2d_helper_pfb_init( &DISP0_ADAPTER.use_as__arm_2d_helper_pfb_t,
+                                &s_tPFBHelperCFG) < 0) {
+        assert(false);
+        return false;
+    }
+
+    disp_adapter0_navigator_init();
+
+    return true;
+}
+
 arm_fsm_rt_t __disp_adapter0_task(void)
 {
     return arm_2d_scene_player_task(&DISP0_ADAPTER);
 }
 
 
+/*----------------------------------------------------------------------------*
+ * Static Layer Cache                                                         *
+ *----------------------------------------------------------------------------*/
+
+ARM_NONNULL(1,3)
+void disp_adapter0_layer_cache_init(disp_adapter0_layer_cache_t *ptCache,
+                                    uint8_t chScheme,
+                                    arm_2d_helper_draw_handler_t *fnDraw,
+                                    void *pTarget,
+                                    COLOUR_INT tBackground)
+{
+    assert(NULL != ptCache);
+    assert(NULL != fnDraw);
+
+    memset(ptCache, 0, sizeof(disp_adapter0_layer_cache_t));
+
+    ptCache->fnDraw = fnDraw;
+    ptCache->pTarget = pTarget;
+    ptCache->tBackground = tBackground;
+    ptCache->chScheme = (ARM_2D_COLOUR_1BIT == chScheme) 
+                      ? ARM_2D_COLOUR_1BIT 
+                      : __DISP0_COLOUR_FORMAT__;
+}
+
+ARM_NONNULL(1)
+void disp_adapter0_layer_cache_depose(disp_adapter0_layer_cache_t *ptCache)
+{
+    assert(NULL != ptCache);
+
+    if (NULL != ptCache->tTile.pchBuffer) {
+        __arm_2d_free_scratch_memory(   ARM_2D_MEM_TYPE_UNSPECIFIED, 
+                                        ptCache->tTile.pchBuffer);
+        ptCache->tTile.pchBuffer = NULL;
+    }
+
+    ptCache->bValid = false;
+    ptCache->bFailed = false;
+}
+
+ARM_NONNULL(1)
+void disp_adapter0_layer_cache_invalidate(disp_adapter0_layer_cache_t *ptCache)
+{
+    assert(NULL != ptCache);
+
+    ptCache->bValid = false;
+}
+
+#if __DISP0_CFG_USE_LAYER_CACHE__
+/*!
+ * \brief call the draw handler with a tile in the size of the cache which is 
+ *        backed by ptRender from row iY
+ * \retval false the draw handler reports an error
+ */
+static bool __disp_adapter0_layer_cache_render( 
+                                        disp_adapter0_layer_cache_t *ptCache,
+                                        const arm_2d_tile_t *ptRender,
+                                        int16_t iY)
+{
+    arm_2d_tile_t tTarget = {
+        .tRegion = {
+            .tLocation = {
+                .iY = -iY,
+            },
+            .tSize = ptCache->tTile.tRegion.tSize,
+        },
+        .ptParent = (arm_2d_tile_t *)ptRender,
+    };
+
+    arm_2d_fill_colour(ptRender, NULL, ptCache->tBackground);
+
+    arm_fsm_rt_t tResult;
+    do {
+        tResult = ptCache->fnDraw(ptCache->pTarget, &tTarget, true);
+    } while (   arm_fsm_rt_on_going == tResult 
+            ||  arm_fsm_rt_wait_for_obj == tResult);
+
+    ARM_2D_OP_WAIT_ASYNC();
+
+    return tResult >= 0;
+}
+
+static bool __disp_adapter0_layer_cache_update(
+                                        disp_adapter0_layer_cache_t *ptCache,
+                                        const arm_2d_size_t *ptSize)
+{
+    size_t tBufferSize;
+
+    /* the region has been resized, render it again */
+    if (    ptCache->tTile.tRegion.tSize.iWidth != ptSize->iWidth
+        ||  ptCache->tTile.tRegion.tSize.iHeight != ptSize->iHeight) {
+        disp_adapter0_layer_cache_depose(ptCache);
+    }
+
+    if (ARM_2D_COLOUR_1BIT == ptCache->chScheme) {
+        tBufferSize = ((ptSize->iWidth + 7) >> 3) * ptSize->iHeight;
+    } else {
+        tBufferSize = ptSize->iWidth * ptSize->iHeight * sizeof(COLOUR_INT);
+    }
+
+    if (NULL == ptCache->tTile.pchBuffer) {
+        ptCache->tTile = (arm_2d_tile_t) {
+            .tRegion = {
+                .tSize = *ptSize,
+            },
+            .tInfo = {
+                .bIsRoot = true,
+                .bHasEnforcedColour = true,
+                .tColourInfo = {
+                    .chScheme = ptCache->chScheme,
+                },
+            },
+            .pchBuffer = __arm_2d_allocate_scratch_memory(
+                                                tBufferSize,
+                                                4,
+                                                ARM_2D_MEM_TYPE_UNSPECIFIED),
+        };
+
+        if (NULL == ptCache->tTile.pchBuffer) {
+            return false;
+        }
+    }
+
+    if (ARM_2D_COLOUR_1BIT != ptCache->chScheme) {
+        /* render into the cache directly */
+        if (!__disp_adapter0_layer_cache_render(ptCache, &ptCache->tTile, 0)) {
+            disp_adapter0_layer_cache_depose(ptCache);
+            return false;
+        }
+        return true;
+    }
+
+    /* render 8 lines at a time and pack them into 1bit per pixel */
+    arm_2d_tile_t tStripe = {
+        .tRegion = {
+            .tSize = {
+                .iWidth = ptSize->iWidth,
+                .iHeight = 8,
+            },
+        },
+        .tInfo = {
+            .bIsRoot = true,
+            .bHasEnforcedColour = true,
+            .tColourInfo = {
+                .chScheme = __DISP0_COLOUR_FORMAT__,
+            },
+        },
+        .pchBuffer = __arm_2d_allocate_scratch_memory(
+                                        ptSize->iWidth * 8 * sizeof(COLOUR_INT),
+                                        4,
+                                        ARM_2D_MEM_TYPE_UNSPECIFIED),
+    };
+
+    if (NULL == tStripe.pchBuffer) {
+        disp_adapter0_layer_cache_depose(ptCache);
+        return false;
+    }
+
+    int16_t iStride = (ptSize->iWidth + 7) >> 3;
+    uint8_t *pchOutput = ptCache->tTile.pchBuffer;
+    memset(pchOutput, 0, tBufferSize);
+
+    bool bResult = true;
+    for (int16_t iY = 0; iY < ptSize->iHeight; iY += 8) {
+        if (!__disp_adapter0_layer_cache_render(ptCache, &tStripe, iY)) {
+            bResult = false;
+            break;
+        }
+
+        int16_t iLines = MIN(8, ptSize->iHeight - iY);
+        const COLOUR_INT *ptPixel = (const COLOUR_INT *)tStripe.pchBuffer;
+
+        for (int16_t j = 0; j < iLines; j++) {
+            for (int16_t i = 0; i < ptSize->iWidth; i++) {
+                /* the same threshold as the EPD driver */
+                if (*ptPixel++ >= 0x80) {
+                    pchOutput[i >> 3] |= 1 << (i & 0x07);
+                }
+            }
+            pchOutput += iStride;
+        }
+    }
+
+    __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, tStripe.pchBuffer);
+
+    if (!bResult) {
+        disp_adapter0_layer_cache_depose(ptCache);
+    }
+
+    return bResult;
+}
+#endif
+
+ARM_NONNULL(1,2,3)
+arm_fsm_rt_t disp_adapter0_layer_cache_draw(disp_adapter0_layer_cache_t *ptCache,
+                                            const arm_2d_tile_t *ptTile,
+                                            const arm_2d_region_t *ptRegion,
+                                            bool bIsNewFrame)
+{
+    assert(NULL != ptCache);
+    assert(NULL != ptTile);
+    assert(NULL != ptRegion);
+
+#if __DISP0_CFG_USE_LAYER_CACHE__
+    do {
+        if (ptCache->bFailed) {
+            break;
+        }
+
+        if (    !ptCache->bValid 
+            ||  ptCache->tTile.tRegion.tSize.iWidth != ptRegion->tSize.iWidth
+            ||  ptCache->tTile.tRegion.tSize.iHeight != ptRegion->tSize.iHeight) {
+
+            if (!__disp_adapter0_layer_cache_update(ptCache, &ptRegion->tSize)) {
+                /* no memory or the draw handler fails, do not try again 
+                 * until the cache is deposed 
+                 */
+                ptCache->bFailed = true;
+                break;
+            }
+            ptCache->bValid = true;
+        }
+
+        /* the blit is clipped by the PFB, i.e. a region outside the PFB or 
+         * the dirty regions costs nothing
+         */
+        if (ARM_2D_COLOUR_1BIT == ptCache->chScheme) {
+            arm_2d_draw_pattern(&ptCache->tTile,
+                                ptTile,
+                                ptRegion,
+                                ARM_2D_DRW_PATN_MODE_COPY 
+                                | ARM_2D_DRW_PATN_MODE_WITH_BG_COLOR,
+                                GLCD_COLOR_WHITE,
+                                GLCD_COLOR_BLACK);
+        } else {
+            arm_2d_tile_copy_only(&ptCache->tTile, ptTile, ptRegion);
+        }
+
+        ARM_2D_OP_WAIT_ASYNC();
+
+        return arm_fsm_rt_cpl;
+    } while(0);
+#endif
+
+    /* draw the content directly */
+    arm_2d_tile_t tChild;
+    if (NULL == arm_2d_tile_generate_child(ptTile, ptRegion, &tChild, false)) {
+        return arm_fsm_rt_cpl;
+    }
+
+    return ptCache->fnDraw(ptCache->pTarget, &tChild, bIsNewFrame);
+}
+
 /*----------------------------------------------------------------------------*
  * Virtual Resource Helper                                                    *
  *----------------------------------------------------------------------------*/
 
 #if __DISP0_CFG_VIRTUAL_RESOURCE_HELPER__
 
+#if __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_SIZE__ > 0
+typedef struct __disp_adapter0_vres_cache_item_t {
+    arm_2d_vres_t *ptVRES;
+    uintptr_t pAddress;                 //!< the asset address in the external memory
+    arm_2d_region_t tRegion;
+    uint32_t wOffset;                   //!< the offset in the pool
+    uint32_t wSize;
+    uint32_t wLastUsed;
+} __disp_adapter0_vres_cache_item_t;
+
+/* the items are sorted by their offsets in the pool */
+static
+struct {
+    uint32_t wTimestamp;
+    uint32_t wHit;
+    uint32_t wMiss;
+    uint_fast8_t chCount;
+
+    __disp_adapter0_vres_cache_item_t tItems[__DISP0_CFG_VIRTUAL_RESOURCE_CACHE_ITEMS__];
+    uint8_t chPool[__DISP0_CFG_VIRTUAL_RESOURCE_CACHE_SIZE__] __ALIGNED(4);
+} s_tVRESCache;
+
+static
+__disp_adapter0_vres_cache_item_t *__disp_adapter0_vres_cache_find(
+                                                    arm_2d_vres_t *ptVRES,
+                                                    uintptr_t pAddress,
+                                                    arm_2d_region_t *ptRegion,
+                                                    size_t tSize)
+{
+    for (uint_fast8_t n = 0; n < s_tVRESCache.chCount; n++) {
+        __disp_adapter0_vres_cache_item_t *ptItem = &s_tVRESCache.tItems[n];
+
+        if (    ptItem->ptVRES == ptVRES
+            &&  ptItem->pAddress == pAddress
+            &&  ptItem->wSize == tSize
+            &&  ptItem->tRegion.tLocation.iX == ptRegion->tLocation.iX
+            &&  ptItem->tRegion.tLocation.iY == ptRegion->tLocation.iY
+            &&  ptItem->tRegion.tSize.iWidth == ptRegion->tSize.iWidth
+            &&  ptItem->tRegion.tSize.iHeight == ptRegion->tSize.iHeight) {
+            return ptItem;
+        }
+    }
+
+    return NULL;
+}
+
+static void __disp_adapter0_vres_cache_remove(uint_fast8_t chIndex)
+{
+    s_tVRESCache.chCount--;
+    memmove(&s_tVRESCache.tItems[chIndex],
+            &s_tVRESCache.tItems[chIndex + 1],
+            (s_tVRESCache.chCount - chIndex) 
+                * sizeof(__disp_adapter0_vres_cache_item_t));
+}
+
+static void __disp_adapter0_vres_cache_store(   arm_2d_vres_t *ptVRES,
+                                                uintptr_t pAddress,
+                                                arm_2d_region_t *ptRegion,
+                                                const void *pBuffer,
+                                                size_t tSize)
+{
+    if (tSize > sizeof(s_tVRESCache.chPool)) {
+        return ;
+    }
+
+    uint32_t wAlignedSize = (tSize + 3) & ~0x03ul;
+    uint32_t wUsed = 0;
+
+    if (s_tVRESCache.chCount > 0) {
+        __disp_adapter0_vres_cache_item_t *ptLast 
+            = &s_tVRESCache.tItems[s_tVRESCache.chCount - 1];
+        wUsed = ptLast->wOffset + ((ptLast->wSize + 3) & ~0x03ul);
+    }
+
+    if (    s_tVRESCache.chCount >= dimof(s_tVRESCache.tItems)
+        ||  wUsed + wAlignedSize > sizeof(s_tVRESCache.chPool)) {
+
+        /* evict the least recently used items until the new one fits */
+        uint32_t wFree = sizeof(s_tVRESCache.chPool);
+        for (uint_fast8_t n = 0; n < s_tVRESCache.chCount; n++) {
+            wFree -= (s_tVRESCache.tItems[n].wSize + 3) & ~0x03ul;
+        }
+
+        while(  s_tVRESCache.chCount >= dimof(s_tVRESCache.tItems)
+            ||  wFree < wAlignedSize) {
+            uint_fast8_t chLRU = 0;
+            for (uint_fast8_t n = 1; n < s_tVRESCache.chCount; n++) {
+                if (    (int32_t)(s_tVRESCache.tItems[n].wLastUsed 
+                    -   s_tVRESCache.tItems[chLRU].wLastUsed) < 0) {
+                    chLRU = n;
+                }
+            }
+
+            wFree += (s_tVRESCache.tItems[chLRU].wSize + 3) & ~0x03ul;
+            __disp_adapter0_vres_cache_remove(chLRU);
+        }
+
+        /* compact the pool */
+        wUsed = 0;
+        for (uint_fast8_t n = 0; n < s_tVRESCache.chCount; n++) {
+            __disp_adapter0_vres_cache_item_t *ptItem = &s_tVRESCache.tItems[n];
+            if (ptItem->wOffset != wUsed) {
+                memmove(&s_tVRESCache.chPool[wUsed],
+                        &s_tVRESCache.chPool[ptItem->wOffset],
+                        ptItem->wSize);
+                ptItem->wOffset = wUsed;
+            }
+            wUsed += (ptItem->wSize + 3) & ~0x03ul;
+        }
+    }
+
+    s_tVRESCache.tItems[s_tVRESCache.chCount++] 
+        = (__disp_adapter0_vres_cache_item_t) {
+            .ptVRES = ptVRES,
+            .pAddress = pAddress,
+            .tRegion = *ptRegion,
+            .wOffset = wUsed,
+            .wSize = tSize,
+            .wLastUsed = s_tVRESCache.wTimestamp++,
+        };
+
+    memcpy(&s_tVRESCache.chPool[wUsed], pBuffer, tSize);
+}
+
+void disp_adapter0_vres_cache_invalidate(void)
+{
+    s_tVRESCache.chCount = 0;
+}
+
+void disp_adapter0_vres_cache_get_info(uint32_t *pwHit, uint32_t *pwMiss)
+{
+    if (NULL != pwHit) {
+        *pwHit = s_tVRESCache.wHit;
+    }
+    if (NULL != pwMiss) {
+        *pwMiss = s_tVRESCache.wMiss;
+    }
+}
+#else
+void disp_adapter0_vres_cache_invalidate(void)
+{
+}
+
+void disp_adapter0_vres_cache_get_info(uint32_t *pwHit, uint32_t *pwMiss)
+{
+    if (NULL != pwHit) {
+        *pwHit = 0;
+    }
+    if (NULL != pwMiss) {
+        *pwMiss = 0;
+    }
+}
+#endif
+
 __WEAK
 void * __disp_adapter0_aligned_malloc(size_t nSize, size_t nAlign)
 {
@@ -1082,6 +1538,28 @@ intptr_t __disp_adapter0_vres_asset_loader (uintptr_t pObj,
     }
     pBuffer = (COLOUR_INT *)((uintptr_t)ptPFB + sizeof(arm_2d_pfb_t));
 #endif
+
+#if __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_SIZE__ > 0
+    uintptr_t pAssetAddress = __disp_adapter0_vres_get_asset_address(pObj, ptVRES);
+    do {
+        __disp_adapter0_vres_cache_item_t *ptItem 
+            = __disp_adapter0_vres_cache_find(  ptVRES, 
+                                                pAssetAddress, 
+                                                ptRegion, 
+                                                tBufferSize);
+        if (NULL == ptItem) {
+            s_tVRESCache.wMiss++;
+            break;
+        }
+
+        s_tVRESCache.wHit++;
+        ptItem->wLastUsed = s_tVRESCache.wTimestamp++;
+        memcpy(pBuffer, &s_tVRESCache.chPool[ptItem->wOffset], tBufferSize);
+
+        return (intptr_t)pBuffer;
+    } while(0);
+#endif
+
     /* load content into the buffer */
     if (nBitsPerPixel < 8) {
         /* A1, A2 and A4 support */
@@ -1119,6 +1597,14 @@ intptr_t __disp_adapter0_vres_asset_loader (uintptr_t pObj,
                                             iSourceStride, 
                                             nPixelSize);
     } while(0);
+
+#if __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_SIZE__ > 0
+    __disp_adapter0_vres_cache_store(   ptVRES, 
+                                        pAssetAddress, 
+                                        ptRegion, 
+                                        pBuffer, 
+                                        tBufferSize);
+#endif
     
     return (intptr_t)pBuffer;
 }
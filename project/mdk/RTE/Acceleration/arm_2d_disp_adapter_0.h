@@ -254,6 +254,24 @@ extern "C" {
 #   define __DISP0_CFG_USE_HEAP_FOR_VIRTUAL_RESOURCE_HELPER__      0
 #endif
 
+// <o>Size of the virtual resource cache in bytes <0-65536>
+// <i> Keep the recently loaded regions of virtual resources in a LRU cache, so loading the same region again costs a memcpy instead of reading the external memory. Set 0 to disable the cache.
+#ifndef __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_SIZE__
+#   define __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_SIZE__               8192
+#endif
+
+// <o>Maximum number of regions in the virtual resource cache <1-255>
+#ifndef __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_ITEMS__
+#   define __DISP0_CFG_VIRTUAL_RESOURCE_CACHE_ITEMS__              16
+#endif
+
+// <q>Enable the static layer cache
+// <i> Let scenes pre-render static content (e.g. label rows and borders) into a cache tile once and blit it in the following frames. When disabled, the static content is drawn directly in every frame.
+// <i> This feature is enabled by default.
+#ifndef __DISP0_CFG_USE_LAYER_CACHE__
+#   define __DISP0_CFG_USE_LAYER_CACHE__                           1
+#endif
+
 // </h>
 
 // <<< end of configuration section >>>
@@ -323,6 +341,24 @@ extern "C" {
         ARM_2D_SAFE_NAME(ret);})
 
 /*============================ TYPES =========================================*/
+
+/*!
+ * \brief a cache tile holding the pre-rendered static content of a scene
+ * \note please initialise it with disp_adapter0_layer_cache_init() and 
+ *       release it with disp_adapter0_layer_cache_depose() in the depose
+ *       handler of the scene
+ */
+typedef struct disp_adapter0_layer_cache_t {
+    arm_2d_tile_t tTile;                            //!< the cache tile
+    arm_2d_helper_draw_handler_t *fnDraw;           //!< draws the static content
+    void *pTarget;                                  //!< the target of fnDraw
+    COLOUR_INT tBackground;                         //!< the colour under the content
+    uint8_t chScheme;                               //!< ARM_2D_COLOUR_1BIT or the screen format
+    uint8_t bValid      : 1;
+    uint8_t bFailed     : 1;                        //!< no memory or fnDraw fails, draw directly
+    uint8_t             : 6;
+} disp_adapter0_layer_cache_t;
+
 /*============================ GLOBAL VARIABLES ==============================*/
 ARM_NOINIT
 extern
@@ -336,6 +372,82 @@ void disp_adapter0_init(void);
 extern
 arm_fsm_rt_t __disp_adapter0_task(void);
 
+/*!
+ * \brief get the size of the buffer of each PFB block in the PFB pool
+ * \return uint32_t the size in bytes
+ */
+extern
+uint32_t disp_adapter0_get_pfb_buffer_size(void);
+
+/*!
+ * \brief change the size of the PFB, i.e. initialise the PFB helper again with
+ *        the configuration of disp_adapter0_init() and the new size
+ * \note please call it between two frames, i.e. when __disp_adapter0_task()
+ *       returns arm_fsm_rt_cpl, and never from the callbacks of the PFB 
+ *       helper. The dependencies installed by 
+ *       arm_2d_helper_pfb_update_dependency() and the refresh mode are reset,
+ *       please install them again. The navigation layer is restored.
+ * \param[in] tSize the new size of the PFB, which must fit into the buffer of
+ *            a PFB block, see disp_adapter0_get_pfb_buffer_size()
+ * \retval true the new size is in use
+ * \retval false the size is invalid, the helper is not changed
+ */
+extern
+bool disp_adapter0_set_pfb_size(arm_2d_size_t tSize);
+
+/*!
+ * \brief initialise a static layer cache
+ * \param[in] ptCache the target cache
+ * \param[in] chScheme the format of the cache: ARM_2D_COLOUR_1BIT keeps 1bit 
+ *            per pixel (thresholded at 50%), any other value keeps the 
+ *            colour format of the screen
+ * \param[in] fnDraw the function that draws the static content, it receives a
+ *            tile in the size of the cached region
+ * \param[in] pTarget the target object passed to fnDraw
+ * \param[in] tBackground the colour filled before calling fnDraw
+ */
+extern
+ARM_NONNULL(1,3)
+void disp_adapter0_layer_cache_init(disp_adapter0_layer_cache_t *ptCache,
+                                    uint8_t chScheme,
+                                    arm_2d_helper_draw_handler_t *fnDraw,
+                                    void *pTarget,
+                                    COLOUR_INT tBackground);
+
+/*!
+ * \brief draw the cached static content to the target region. The content is
+ *        rendered into the cache at the first call and blitted afterwards.
+ * \note if the cache cannot be allocated or fnDraw returns an error when
+ *       rendering the cache, fnDraw is called directly
+ * \param[in] ptCache the target cache
+ * \param[in] ptTile the target tile, i.e. the tile passed to the scene
+ * \param[in] ptRegion the target region in the target tile
+ * \param[in] bIsNewFrame whether this is a new frame
+ * \return arm_fsm_rt_t the drawing result
+ */
+extern
+ARM_NONNULL(1,2,3)
+arm_fsm_rt_t disp_adapter0_layer_cache_draw(disp_adapter0_layer_cache_t *ptCache,
+                                            const arm_2d_tile_t *ptTile,
+                                            const arm_2d_region_t *ptRegion,
+                                            bool bIsNewFrame);
+
+/*!
+ * \brief invalidate the cache, e.g. when the static content changes
+ * \param[in] ptCache the target cache
+ */
+extern
+ARM_NONNULL(1)
+void disp_adapter0_layer_cache_invalidate(disp_adapter0_layer_cache_t *ptCache);
+
+/*!
+ * \brief release the memory of the cache
+ * \param[in] ptCache the target cache
+ */
+extern
+ARM_NONNULL(1)
+void disp_adapter0_layer_cache_depose(disp_adapter0_layer_cache_t *ptCache);
+
 
 #if __DISP0_CFG_VIRTUAL_RESOURCE_HELPER__
 /*!
@@ -364,6 +476,22 @@ void __disp_adapter0_vres_buffer_deposer (  uintptr_t pTarget,
                                                 arm_2d_vres_t *ptVRES, 
                                                 intptr_t pBuffer );
 
+/*!
+ * \brief get the statistics of the virtual resource cache
+ * \param[out] pwHit the number of loads served by the cache, NULL to ignore
+ * \param[out] pwMiss the number of loads from the external memory, NULL to 
+ *             ignore
+ */
+extern
+void disp_adapter0_vres_cache_get_info(uint32_t *pwHit, uint32_t *pwMiss);
+
+/*!
+ * \brief drop all regions in the virtual resource cache, e.g. after the 
+ *        content of the external memory has been updated
+ */
+extern
+void disp_adapter0_vres_cache_invalidate(void);
+
 /*!
  * \brief A user implemented function to return the address for specific asset
  *        stored in external memory, e.g. SPI Flash
@@ -26,6 +26,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../../platform/wall_clock.h"
+#include "../../platform/idle_sleep.h"
+
 #if defined(__clang__)
 #   pragma clang diagnostic push
 #   pragma clang diagnostic ignored "-Wunknown-warning-option"
@@ -73,6 +76,16 @@
 #   error Unsupported colour depth!
 #endif
 
+/* the digits shown, i.e. the panel is only refreshed when they change */
+#define MONO_CLOCK_GRANULARITY                                                  \
+            ((wall_clock_granularity_t)__PLATFORM_CFG_WALL_CLOCK_GRANULARITY__)
+
+#if __PLATFORM_CFG_WALL_CLOCK_GRANULARITY__ == 1
+#   define MONO_CLOCK_STRING        "00:00:00"
+#else
+#   define MONO_CLOCK_STRING        "00:00"
+#endif
+
 /*============================ MACROFIED FUNCTIONS ===========================*/
 #undef this
 #define this (*ptThis)
@@ -82,7 +95,6 @@ enum {
     DIRTY_REGION_IDX_HOUR,
     DIRTY_REGION_IDX_MIN,
     DIRTY_REGION_IDX_SEC,
-    DIRTY_REGION_IDX_TENMS,
     DIRTY_REGION_IDX_ECG,
 };
 
@@ -101,6 +113,7 @@ struct {
 
 
 /*============================ PROTOTYPES ====================================*/
+
 /*============================ LOCAL VARIABLES ===============================*/
 
 /*! define dirty regions */
@@ -121,11 +134,6 @@ IMPL_ARM_2D_REGION_LIST(s_tDirtyRegions, static)
         0  /* initialize at runtime later */
     ),
 
-    /* a dirty region for TenMs */
-    ADD_REGION_TO_LIST(s_tDirtyRegions,
-        0  /* initialize at runtime later */
-    ),
-
     /* add the last region for ECG */
     ADD_LAST_REGION_TO_LIST(s_tDirtyRegions,
         0
@@ -184,57 +192,98 @@ static void __on_scene_mono_clock_background_complete(arm_2d_scene_t *ptScene)
 }
 
 
-static void __on_scene_mono_clock_frame_start(arm_2d_scene_t *ptScene)
+/*!
+ * \brief place the dirty regions of the digits, the same way the draw handler
+ *        lays them out
+ * \note it runs on the first frame rather than in the loader, because the
+ *       loader may run ahead of time, i.e. when the scene is preloaded, while
+ *       another scene is still using the text settings.
+ */
+static void __mono_clock_init_dirty_regions(user_scene_mono_clock_t *ptThis)
 {
-    user_scene_mono_clock_t *ptThis = (user_scene_mono_clock_t *)ptScene;
-    ARM_2D_UNUSED(ptThis);
+    s_tDirtyRegions[dimof(s_tDirtyRegions)-1].ptNext = NULL;
+
+    /* get the screen region */
+    arm_2d_region_t tScreen
+        = arm_2d_helper_pfb_get_display_area(
+            &this.use_as__arm_2d_scene_t.ptPlayer->use_as__arm_2d_helper_pfb_t);
+
+    /*--------------initialize static dirty region items: begin---------------*/
+
+    arm_2d_dock_vertical(tScreen, 16, 16) {
+
+        arm_lcd_text_set_scale(0.0f);
+        arm_2d_size_t tStringSize = arm_lcd_get_string_line_box(MONO_CLOCK_STRING, &CLOCK_FONT);
+        
+        arm_2d_size_t tTwoDigitsSizeBig = arm_lcd_get_string_line_box("00", &CLOCK_FONT);
+        arm_2d_size_t tCommaSizeBig = arm_lcd_get_string_line_box(":", &CLOCK_FONT);
+
+        arm_2d_dock_horizontal(__vertical_region, tStringSize.iWidth) {
+
+            arm_2d_layout(__horizontal_region) {
 
-    int64_t lTimeStampInMs = arm_2d_helper_convert_ticks_to_ms(
-                                arm_2d_helper_get_system_timestamp());
+                __item_line_dock_horizontal(tTwoDigitsSizeBig.iWidth) {
+                    
+                    s_tDirtyRegions[DIRTY_REGION_IDX_HOUR].tRegion = __item_region;
 
-    /* calculate the hours */
-    do {
-        uint_fast8_t chHour = lTimeStampInMs / (3600ul * 1000ul);
-        chHour %= 24;
+                }
 
-        arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_HOUR],
-                                            (chHour == this.chHour)); 
-        this.chHour = chHour;
+                __item_line_dock_horizontal(tCommaSizeBig.iWidth) {
 
-        lTimeStampInMs %= (3600ul * 1000ul);
-    } while(0);
+                }
 
-    /* calculate the Minutes */
-    do {
-        uint_fast8_t chMin = lTimeStampInMs / (60ul * 1000ul);
+                __item_line_dock_horizontal(tTwoDigitsSizeBig.iWidth) {
+                    s_tDirtyRegions[DIRTY_REGION_IDX_MIN].tRegion = __item_region;
+                }
 
-        arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_MIN],
-                                            (chMin == this.chMin)); 
-        this.chMin = chMin;
+            #if __PLATFORM_CFG_WALL_CLOCK_GRANULARITY__ == 1
+                __item_line_dock_horizontal(tCommaSizeBig.iWidth) {
+                    
+                }
 
-        lTimeStampInMs %= (60ul * 1000ul);
-    } while(0);
+                __item_line_dock_horizontal(tTwoDigitsSizeBig.iWidth) {
+                    s_tDirtyRegions[DIRTY_REGION_IDX_SEC].tRegion = __item_region;
+                }
+            #endif
+            }
+        }
+    }
 
-    /* calculate the Seconds */
-    do {
-        uint_fast8_t chSec = lTimeStampInMs / (1000ul);
+    /*--------------initialize static dirty region items: end  ---------------*/
+}
 
-        arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_SEC],
-                                            (chSec == this.chSec)); 
-        this.chSec = chSec;
+static void __on_scene_mono_clock_frame_start(arm_2d_scene_t *ptScene)
+{
+    user_scene_mono_clock_t *ptThis = (user_scene_mono_clock_t *)ptScene;
+    ARM_2D_UNUSED(ptThis);
+
+    if (!this.bDirtyRegionsReady) {
+        this.bDirtyRegionsReady = true;
+        __mono_clock_init_dirty_regions(ptThis);
+    }
 
-        lTimeStampInMs %= (1000ul);
-    } while(0);
+    wall_clock_time_t tTime;
+    wall_clock_get(&tTime);
 
-    /* calculate the Ten-Miliseconds */
-    do {
-        uint_fast8_t chTenMs = lTimeStampInMs / (10ul);
+    arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_HOUR],
+                                        (tTime.chHour == this.chHour)); 
+    this.chHour = tTime.chHour;
 
-        arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_TENMS],
-                                            (chTenMs == this.chTenMs)); 
-        this.chTenMs = chTenMs;
-    } while(0);
+    arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_MIN],
+                                        (tTime.chMin == this.chMin)); 
+    this.chMin = tTime.chMin;
 
+#if __PLATFORM_CFG_WALL_CLOCK_GRANULARITY__ == 1
+    arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_SEC],
+                                        (tTime.chSec == this.chSec)); 
+    this.chSec = tTime.chSec;
+#else
+    arm_2d_dirty_region_item_ignore_set(&s_tDirtyRegions[DIRTY_REGION_IDX_SEC],
+                                        true); 
+#endif
+
+    /* nothing changes before the next visible digit */
+    idle_sleep_next_frame_in_ms(wall_clock_notify_on_change(MONO_CLOCK_GRANULARITY));
 }
 
 static void __on_scene_mono_clock_frame_complete(arm_2d_scene_t *ptScene)
@@ -275,16 +324,10 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_clock_handler)
         arm_2d_dock_vertical(__top_canvas, 16, 16) {
 
             arm_lcd_text_set_scale(0.0f);
-            arm_2d_size_t tStringSize = arm_lcd_get_string_line_box("00:00:00", &CLOCK_FONT);
+            arm_2d_size_t tStringSize = arm_lcd_get_string_line_box(MONO_CLOCK_STRING, &CLOCK_FONT);
             
             arm_2d_size_t tTwoDigitsSizeBig = arm_lcd_get_string_line_box("00", &CLOCK_FONT);
             arm_2d_size_t tCommaSizeBig = arm_lcd_get_string_line_box(":", &CLOCK_FONT);
-
-            arm_lcd_text_set_scale(0.5f);
-            arm_2d_size_t tCommaSizeSmall = arm_lcd_get_string_line_box(":", &CLOCK_FONT);
-            arm_2d_size_t tTwoDigitsSizeSmall = arm_lcd_get_string_line_box("00", &CLOCK_FONT);
-            
-            tStringSize.iWidth += tTwoDigitsSizeSmall.iWidth + tCommaSizeSmall.iWidth;
             
             arm_lcd_text_set_target_framebuffer(ptTile);
             arm_lcd_text_set_font((arm_2d_font_t *)&CLOCK_FONT);
@@ -310,6 +353,7 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_clock_handler)
                         arm_lcd_printf("%02d", this.chMin);
                     }
 
+                #if __PLATFORM_CFG_WALL_CLOCK_GRANULARITY__ == 1
                     __item_line_dock_horizontal(tCommaSizeBig.iWidth) {
                         arm_lcd_text_set_draw_region(&__item_region);
                         arm_lcd_puts(":");
@@ -319,26 +363,7 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_clock_handler)
                         arm_lcd_text_set_draw_region(&__item_region);
                         arm_lcd_printf("%02d", this.chSec);
                     }
-
-                    __item_line_dock_horizontal(tCommaSizeSmall.iWidth) {
-                    }
-
-                    __item_line_dock_horizontal(tTwoDigitsSizeSmall.iWidth) {
-                        
-                        arm_lcd_text_set_scale(0.5f);
-                        arm_2d_align_centre(__item_region, tTwoDigitsSizeSmall) {
-                            arm_lcd_text_set_draw_region(&__centre_region);
-
-                            arm_lcd_text_reset_display_region_tracking();
-
-                            arm_lcd_text_force_char_use_same_width(true);
-                            arm_lcd_printf("%02d", this.chTenMs);
-                            arm_lcd_text_force_char_use_same_width(false);
-                            if (bIsNewFrame) {
-                                s_tDirtyRegions[DIRTY_REGION_IDX_TENMS].tRegion = *arm_lcd_text_get_last_display_region();
-                            }
-                        }
-                    }
+                #endif
                 }
             }
             arm_lcd_text_set_display_mode(ARM_2D_DRW_PATN_MODE_COPY);
@@ -359,78 +384,6 @@ user_scene_mono_clock_t *__arm_2d_scene_mono_clock_init(   arm_2d_scene_player_t
     bool bUserAllocated = false;
     assert(NULL != ptDispAdapter);
 
-    s_tDirtyRegions[dimof(s_tDirtyRegions)-1].ptNext = NULL;
-
-    /* get the screen region */
-    arm_2d_region_t tScreen
-        = arm_2d_helper_pfb_get_display_area(
-            &ptDispAdapter->use_as__arm_2d_helper_pfb_t);
-
-    /*--------------initialize static dirty region items: begin---------------*/
-
-
-    arm_2d_dock_vertical(tScreen, 16, 16) {
-
-        arm_lcd_text_set_scale(1.0f);
-        arm_2d_size_t tStringSize = arm_lcd_get_string_line_box("00:00:00", &CLOCK_FONT);
-        
-        arm_2d_size_t tTwoDigitsSizeBig = arm_lcd_get_string_line_box("00", &CLOCK_FONT);
-        arm_2d_size_t tCommaSizeBig = arm_lcd_get_string_line_box(":", &CLOCK_FONT);
-
-        arm_lcd_text_set_scale(0.5f);
-        arm_2d_size_t tCommaSizeSmall = arm_lcd_get_string_line_box(":", &CLOCK_FONT);
-        arm_2d_size_t tTwoDigitsSizeSmall = arm_lcd_get_string_line_box("00", &CLOCK_FONT);
-        
-        tStringSize.iWidth += tTwoDigitsSizeSmall.iWidth + tCommaSizeSmall.iWidth;
-        
-        arm_lcd_text_set_font((arm_2d_font_t *)&CLOCK_FONT);
-        arm_lcd_text_set_scale(1.0f);
-
-        arm_2d_dock_horizontal(__vertical_region, tStringSize.iWidth) {
-
-            arm_2d_layout(__horizontal_region) {
-
-                __item_line_dock_horizontal(tTwoDigitsSizeBig.iWidth) {
-                    
-                    s_tDirtyRegions[DIRTY_REGION_IDX_HOUR].tRegion = __item_region;
-
-                }
-
-                __item_line_dock_horizontal(tCommaSizeBig.iWidth) {
-
-                }
-
-                __item_line_dock_horizontal(tTwoDigitsSizeBig.iWidth) {
-                    s_tDirtyRegions[DIRTY_REGION_IDX_MIN].tRegion = __item_region;
-                }
-
-                __item_line_dock_horizontal(tCommaSizeBig.iWidth) {
-                    
-                }
-
-                __item_line_dock_horizontal(tTwoDigitsSizeBig.iWidth) {
-                    s_tDirtyRegions[DIRTY_REGION_IDX_SEC].tRegion = __item_region;
-                }
-
-                __item_line_dock_horizontal(tCommaSizeSmall.iWidth) {
-                }
-
-            #if 0
-                __item_line_dock_horizontal(tTwoDigitsSizeSmall.iWidth) {
-                    arm_2d_align_centre(__item_region, tTwoDigitsSizeSmall) {
-                        s_tDirtyRegions[DIRTY_REGION_IDX_TENMS].tRegion = __centre_region;
-                    }
-                }
-            #endif
-            }
-        }
-
-        arm_lcd_text_set_scale(1.0f);
-    }
-
-
-    /*--------------initialize static dirty region items: end  ---------------*/
-
     if (NULL == ptThis) {
         ptThis = (user_scene_mono_clock_t *)
                     __arm_2d_allocate_scratch_memory(   sizeof(user_scene_mono_clock_t),
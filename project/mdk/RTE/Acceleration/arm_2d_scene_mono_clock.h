@@ -86,11 +86,11 @@ ARM_PRIVATE(
     /* place your private member here, following two are examples */
     int64_t lTimestamp[2];
     bool bUserAllocated;
+    bool bDirtyRegionsReady;                    //!< set on the first frame
 
     uint8_t chHour;
     uint8_t chMin;
     uint8_t chSec;
-    uint8_t chTenMs;
 
 )
     /* place your public member here */
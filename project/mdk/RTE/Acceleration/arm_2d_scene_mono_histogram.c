@@ -128,6 +128,7 @@ static void __on_scene_mono_histogram_depose(arm_2d_scene_t *ptScene)
     ARM_2D_UNUSED(ptThis);
     
     histogram_depose(&this.tHistogram);
+    disp_adapter0_layer_cache_depose(&this.tLabelCache);
     
     arm_foreach(int64_t,this.lTimestamp, ptItem) {
         *ptItem = 0;
@@ -194,6 +195,33 @@ static void __before_scene_mono_histogram_switching_out(arm_2d_scene_t *ptScene)
 
 }
 
+static
+IMPL_PFB_ON_DRAW(__draw_mono_histogram_label)
+{
+    ARM_2D_PARAM(pTarget);
+    ARM_2D_PARAM(bIsNewFrame);
+
+    arm_2d_canvas(ptTile, __label_canvas) {
+        arm_2d_fill_colour(ptTile, &__label_canvas, GLCD_COLOR_WHITE);
+
+        /* print label */
+        arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
+        arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
+        arm_lcd_text_set_scale(0.0f);
+        arm_lcd_text_set_draw_region(&__label_canvas);
+        //arm_lcd_text_set_colour(GLCD_COLOR_WHITE, GLCD_COLOR_BLACK);
+        arm_lcd_text_set_display_mode(ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR);
+        
+        arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_LEFT, " histogram");
+        arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_RIGHT, "_x");
+
+        arm_lcd_text_set_display_mode(ARM_2D_DRW_PATN_MODE_COPY);
+    }
+    ARM_2D_OP_WAIT_ASYNC();
+
+    return arm_fsm_rt_cpl;
+}
+
 static
 IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_histogram_handler)
 {
@@ -213,21 +241,11 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_histogram_handler)
             arm_2d_layout(__centre_region) {
                 __item_line_dock_vertical(10) {
 
-                    
-                    arm_2d_fill_colour(ptTile, &__item_region, GLCD_COLOR_WHITE);
-
-                    /* print label */
-                    arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
-                    arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
-                    arm_lcd_text_set_draw_region(&__item_region);
-                    //arm_lcd_text_set_colour(GLCD_COLOR_WHITE, GLCD_COLOR_BLACK);
-                    arm_lcd_text_set_display_mode(ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR);
-                    
-                    arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_LEFT, " histogram");
-                    arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_RIGHT, "_x");
-
-                    arm_lcd_text_set_display_mode(ARM_2D_DRW_PATN_MODE_COPY);
-
+                    /* the label row is static */
+                    disp_adapter0_layer_cache_draw( &this.tLabelCache,
+                                                    ptTile,
+                                                    &__item_region,
+                                                    bIsNewFrame);
                 }
 
                 __item_line_vertical(histogram_get_size(&this.tHistogram))
@@ -364,6 +382,13 @@ user_scene_mono_histogram_t *__arm_2d_scene_mono_histogram_init(   arm_2d_scene_
         histogram_init(&this.tHistogram, &tCFG);
     } while(0);
 
+    /* black text on white background, hence 1bit per pixel is lossless */
+    disp_adapter0_layer_cache_init( &this.tLabelCache,
+                                    ARM_2D_COLOUR_1BIT,
+                                    &__draw_mono_histogram_label,
+                                    ptThis,
+                                    GLCD_COLOR_BLACK);
+
     /* ------------   initialize members of user_scene_mono_histogram_t end   ---------------*/
 
     arm_2d_scene_player_append_scenes(  ptDispAdapter, 
@@ -28,6 +28,7 @@
 #if defined(RTE_Acceleration_Arm_2D_Helper_PFB)
 
 #include "arm_2d_helper.h"
+#include "arm_2d_disp_adapters.h"
 #include "arm_2d_example_controls.h"
 
 #ifdef   __cplusplus
@@ -87,6 +88,8 @@ ARM_PRIVATE(
     int64_t lTimestamp[2];
     bool bUserAllocated;
 
+    disp_adapter0_layer_cache_t tLabelCache;
+
     histogram_t tHistogram;
     histogram_bin_item_t tBins[14];
 
@@ -184,6 +184,7 @@ static void __on_scene_mono_icon_menu_depose(arm_2d_scene_t *ptScene)
                                             this.tDirtyRegionItems,
                                             dimof(this.tDirtyRegionItems));
 
+    system_timer_stop(&this.tStepTimer);
     icon_list_depose(&this.tList);
     
     arm_foreach(int64_t,this.lTimestamp, ptItem) {
@@ -215,12 +216,23 @@ static void __on_scene_mono_icon_menu_background_complete(arm_2d_scene_t *ptScen
 }
 
 
+static void __on_scene_mono_icon_menu_step(void *pTarget, 
+                                           timer_wheel_timer_t *ptTimer)
+{
+    user_scene_mono_icon_menu_t *ptThis = (user_scene_mono_icon_menu_t *)pTarget;
+    ARM_2D_UNUSED(ptTimer);
+
+    /* the timers expire between PFB bands, apply the step in the next frame */
+    this.bMoveSelection = true;
+}
+
 static void __on_scene_mono_icon_menu_frame_start(arm_2d_scene_t *ptScene)
 {
     user_scene_mono_icon_menu_t *ptThis = (user_scene_mono_icon_menu_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
-    if (arm_2d_helper_is_time_out(1000, &this.lTimestamp[0])) {
+    if (this.bMoveSelection) {
+        this.bMoveSelection = false;
 
         /* move list */
         icon_list_move_selection(&this.tList, 1, 200);
@@ -278,6 +290,7 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_icon_menu_handler)
                         /* print label */
                         arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
                         arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
+                        arm_lcd_text_set_scale(0.0f);
                         arm_lcd_text_set_draw_region(&__item_region);
                         arm_lcd_text_set_display_mode(ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR);
                         
@@ -465,6 +478,13 @@ user_scene_mono_icon_menu_t *__arm_2d_scene_mono_icon_menu_init(   arm_2d_scene_
         icon_list_move_selection(&this.tList, 0, 0);
     } while(0);
 #endif
+
+    /* move the selection every second */
+    system_timer_start( &this.tStepTimer, 
+                        1000, 
+                        1000, 
+                        &__on_scene_mono_icon_menu_step, 
+                        ptThis);
     /* ------------   initialize members of user_scene_mono_icon_menu_t end   ---------------*/
 
     arm_2d_scene_player_append_scenes(  ptDispAdapter, 
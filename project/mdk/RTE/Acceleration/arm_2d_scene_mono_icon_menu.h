@@ -29,6 +29,7 @@
 
 #include "arm_2d_helper.h"
 #include "arm_2d_example_controls.h"
+#include "../../platform/timer_wheel.h"
 
 #ifdef   __cplusplus
 extern "C" {
@@ -87,6 +88,9 @@ ARM_PRIVATE(
     int64_t lTimestamp[1];
     uint8_t bUserAllocated  : 1;
     uint8_t bRedrawLabel    : 1;
+    uint8_t bMoveSelection  : 1;
+
+    timer_wheel_timer_t tStepTimer;
 
     icon_list_t tList;
     arm_2d_helper_dirty_region_item_t tDirtyRegionItems[1];
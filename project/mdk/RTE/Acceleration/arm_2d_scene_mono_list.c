@@ -113,7 +113,9 @@ static void __on_scene_mono_list_depose(arm_2d_scene_t *ptScene)
     user_scene_mono_list_t *ptThis = (user_scene_mono_list_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
     
+    system_timer_stop(&this.tStepTimer);
     text_list_depose(&this.tList);
+    disp_adapter0_layer_cache_depose(&this.tLabelCache);
     
     arm_foreach(int64_t,this.lTimestamp, ptItem) {
         *ptItem = 0;
@@ -144,12 +146,22 @@ static void __on_scene_mono_list_background_complete(arm_2d_scene_t *ptScene)
 }
 
 
+static void __on_scene_mono_list_step(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    user_scene_mono_list_t *ptThis = (user_scene_mono_list_t *)pTarget;
+    ARM_2D_UNUSED(ptTimer);
+
+    /* the timers expire between PFB bands, apply the step in the next frame */
+    this.bMoveSelection = true;
+}
+
 static void __on_scene_mono_list_frame_start(arm_2d_scene_t *ptScene)
 {
     user_scene_mono_list_t *ptThis = (user_scene_mono_list_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
-    if (arm_2d_helper_is_time_out(1000, &this.lTimestamp[1])) {
+    if (this.bMoveSelection) {
+        this.bMoveSelection = false;
 
         /* move list */
         text_list_move_selection(&this.tList, 1, 100);
@@ -178,6 +190,32 @@ static void __before_scene_mono_list_switching_out(arm_2d_scene_t *ptScene)
 
 }
 
+static
+IMPL_PFB_ON_DRAW(__draw_mono_list_label)
+{
+    ARM_2D_PARAM(pTarget);
+    ARM_2D_PARAM(bIsNewFrame);
+
+    arm_2d_canvas(ptTile, __label_canvas) {
+        arm_2d_fill_colour(ptTile, &__label_canvas, GLCD_COLOR_WHITE);
+
+        /* print label */
+        arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
+        arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
+        arm_lcd_text_set_scale(0.0f);
+        arm_lcd_text_set_draw_region(&__label_canvas);
+        arm_lcd_text_set_display_mode(ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR);
+        
+        arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_LEFT, " weekday");
+        arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_RIGHT, "_x");
+
+        arm_lcd_text_set_display_mode(ARM_2D_DRW_PATN_MODE_COPY);
+    }
+    ARM_2D_OP_WAIT_ASYNC();
+
+    return arm_fsm_rt_cpl;
+}
+
 static
 IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_list_handler)
 {
@@ -194,16 +232,15 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_list_handler)
 
             __item_line_dock_vertical(10) {
 
-                arm_2d_fill_colour(ptTile, &__item_region, GLCD_COLOR_WHITE);
+                /* the label row is static */
+                disp_adapter0_layer_cache_draw( &this.tLabelCache,
+                                                ptTile,
+                                                &__item_region,
+                                                bIsNewFrame);
 
-                /* print label */
+                /* the text list below draws into the PFB */
                 arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
                 arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
-                arm_lcd_text_set_draw_region(&__item_region);
-                arm_lcd_text_set_display_mode(ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR);
-                
-                arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_LEFT, " weekday");
-                arm_lcd_printf_label(ARM_2D_ALIGN_MIDDLE_RIGHT, "_x");
             }
 
             __item_line_dock_vertical(4,    /* left margin */
@@ -382,6 +419,20 @@ user_scene_mono_list_t *__arm_2d_scene_mono_list_init(   arm_2d_scene_player_t *
         text_list_move_selection(&this.tList, 0, 0);
     } while(0);
 
+    /* move the selection every second */
+    system_timer_start( &this.tStepTimer, 
+                        1000, 
+                        1000, 
+                        &__on_scene_mono_list_step, 
+                        ptThis);
+
+    /* black text on white background, hence 1bit per pixel is lossless */
+    disp_adapter0_layer_cache_init( &this.tLabelCache,
+                                    ARM_2D_COLOUR_1BIT,
+                                    &__draw_mono_list_label,
+                                    ptThis,
+                                    GLCD_COLOR_BLACK);
+
     /* ------------   initialize members of user_scene_mono_list_t end   ---------------*/
 
     arm_2d_scene_player_append_scenes(  ptDispAdapter, 
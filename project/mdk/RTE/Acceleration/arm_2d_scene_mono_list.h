@@ -28,7 +28,9 @@
 #if defined(RTE_Acceleration_Arm_2D_Helper_PFB)
 
 #include "arm_2d_helper.h"
+#include "arm_2d_disp_adapters.h"
 #include "arm_2d_example_controls.h"
+#include "../../platform/timer_wheel.h"
 
 #ifdef   __cplusplus
 extern "C" {
@@ -86,6 +88,11 @@ ARM_PRIVATE(
     /* place your private member here, following two are examples */
     int64_t lTimestamp[2];
     bool bUserAllocated;
+    bool bMoveSelection;
+
+    timer_wheel_timer_t tStepTimer;
+
+    disp_adapter0_layer_cache_t tLabelCache;
 
     text_list_t tList;
 )
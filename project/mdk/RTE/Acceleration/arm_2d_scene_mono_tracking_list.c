@@ -205,6 +205,7 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_mono_tracking_list_handler)
                 /* print label */
                 arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
                 arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
+                arm_lcd_text_set_scale(0.0f);
                 arm_lcd_text_set_draw_region(&__item_region);
                 arm_lcd_text_set_display_mode(ARM_2D_DRW_PATH_MODE_COMP_FG_COLOUR);
                 
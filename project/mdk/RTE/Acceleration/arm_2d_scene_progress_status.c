@@ -126,6 +126,14 @@ static void __on_scene_progress_status_load(arm_2d_scene_t *ptScene)
     
     progress_bar_round_on_load(&this.tProgressBarRound);
     progress_bar_round_on_load(&this.tProgressBarRound2);
+
+#if PROGRESS_STATUS_DEMO_SHOW_WIFI_ANIMATION
+    /* set to the last frame, the films are shared by all instances, so it is
+     * not done in the loader, which may run while the scene is preloaded
+     */
+    arm_2d_helper_film_set_frame(&s_tileWIFISignalFilm, -1);
+    arm_2d_helper_film_set_frame(&s_tileWIFISignalFilmMask, -1);
+#endif
 }
 
 
@@ -351,12 +359,6 @@ user_scene_progress_status_t *__arm_2d_scene_progress_status_init(   arm_2d_scen
         = arm_2d_helper_pfb_get_display_area(
             &ptDispAdapter->use_as__arm_2d_helper_pfb_t);
 
-#if PROGRESS_STATUS_DEMO_SHOW_WIFI_ANIMATION
-    /* set to the last frame */
-    arm_2d_helper_film_set_frame(&s_tileWIFISignalFilm, -1);
-    arm_2d_helper_film_set_frame(&s_tileWIFISignalFilmMask, -1);
-#endif
-
     *ptThis = (user_scene_progress_status_t){
         .use_as__arm_2d_scene_t = {
         
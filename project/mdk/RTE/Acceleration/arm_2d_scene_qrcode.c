@@ -26,6 +26,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../../platform/idle_sleep.h"
+
 #if defined(__clang__)
 #   pragma clang diagnostic push
 #   pragma clang diagnostic ignored "-Wunknown-warning-option"
@@ -86,7 +88,20 @@ extern const arm_2d_tile_t c_tileCMSISLogoA1Mask;
 extern const arm_2d_tile_t c_tileCMSISLogoA2Mask;
 extern const arm_2d_tile_t c_tileCMSISLogoA4Mask;
 /*============================ PROTOTYPES ====================================*/
+
 /*============================ LOCAL VARIABLES ===============================*/
+
+static const char c_chURL[] = {"https://github.com/ARM-software/Arm-2D"};
+
+/* the payload used by the scenes created afterwards */
+static struct {
+    const char *pchString;
+    uint16_t hwSize;
+} s_tPayload = {
+    .pchString = c_chURL,
+    .hwSize = sizeof(c_chURL),
+};
+
 /*============================ IMPLEMENTATION ================================*/
 
 static void __on_scene_qrcode_load(arm_2d_scene_t *ptScene)
@@ -149,6 +164,9 @@ static void __on_scene_qrcode_frame_start(arm_2d_scene_t *ptScene)
     user_scene_qrcode_t *ptThis = (user_scene_qrcode_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
+    /* the content is static */
+    idle_sleep_next_frame_in_ms(1000);
+
 }
 
 static void __on_scene_qrcode_frame_complete(arm_2d_scene_t *ptScene)
@@ -199,6 +217,8 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_qrcode_handler)
 
         arm_lcd_text_set_target_framebuffer((arm_2d_tile_t *)ptTile);
         arm_lcd_text_set_font(&ARM_2D_FONT_6x8.use_as__arm_2d_font_t);
+        arm_lcd_text_set_scale(0.0f);
+        arm_lcd_text_set_display_mode(ARM_2D_DRW_PATN_MODE_COPY);
         arm_lcd_text_set_draw_region(NULL);
         arm_lcd_text_set_colour(GLCD_COLOR_BLACK, GLCD_COLOR_WHITE);
         arm_lcd_text_location(0,0);
@@ -211,6 +231,17 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_qrcode_handler)
     return arm_fsm_rt_cpl;
 }
 
+void arm_2d_scene_qrcode_set_payload(const char *pchString, uint16_t hwSize)
+{
+    if (NULL == pchString || 0 == hwSize) {
+        s_tPayload.pchString = c_chURL;
+        s_tPayload.hwSize = sizeof(c_chURL);
+    } else {
+        s_tPayload.pchString = pchString;
+        s_tPayload.hwSize = hwSize;
+    }
+}
+
 ARM_NONNULL(1)
 user_scene_qrcode_t *__arm_2d_scene_qrcode_init(   arm_2d_scene_player_t *ptDispAdapter, 
                                         user_scene_qrcode_t *ptThis)
@@ -264,11 +295,10 @@ user_scene_qrcode_t *__arm_2d_scene_qrcode_init(   arm_2d_scene_player_t *ptDisp
 
     /* initialize QRcode box */
     do {
-        static const char c_chURL[] = {"https://github.com/ARM-software/Arm-2D"};
         qrcode_box_cfg_t tCFG = {
             .bIsString = true,
-            .pchString = c_chURL,
-            .hwInputSize = sizeof(c_chURL),
+            .pchString = s_tPayload.pchString,
+            .hwInputSize = s_tPayload.hwSize,
             .pchBuffer = (uint8_t *)this.QRCode.chBuffer,
             .hwQRCodeBufferSize = sizeof(this.QRCode.chBuffer),
             .chSquarePixelSize = 2,
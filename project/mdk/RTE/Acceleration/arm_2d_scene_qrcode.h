@@ -105,6 +105,16 @@ extern
 user_scene_qrcode_t *__arm_2d_scene_qrcode_init(   arm_2d_scene_player_t *ptDispAdapter, 
                                         user_scene_qrcode_t *ptScene);
 
+/*!
+ * \brief set the string encoded by the scenes created afterwards
+ * \note the string is referenced rather than copied, i.e. it should live in
+ *       ROM (or as long as the scenes)
+ * \param[in] pchString the string, NULL means using the default URL
+ * \param[in] hwSize the size of the string (including the '\0')
+ */
+extern
+void arm_2d_scene_qrcode_set_payload(const char *pchString, uint16_t hwSize);
+
 #if defined(__clang__)
 #   pragma clang diagnostic pop
 #elif __IS_COMPILER_GCC__
@@ -26,6 +26,13 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "perf_counter.h"
+
+#include "../../platform/asset_stream.h"
+#include "../../platform/platform.h"
 
 #if defined(__clang__)
 #   pragma clang diagnostic push
@@ -85,16 +92,167 @@ extern const arm_2d_tile_t c_tileCMSISLogo;
 extern const arm_2d_tile_t c_tileCMSISLogoMask;
 extern const arm_2d_tile_t c_tileCMSISLogoA2Mask;
 extern const arm_2d_tile_t c_tileCMSISLogoA4Mask;
+
 /*============================ PROTOTYPES ====================================*/
 /*============================ LOCAL VARIABLES ===============================*/
 /*============================ IMPLEMENTATION ================================*/
 
+static bool __rickrolling_is_mono_film(user_scene_rickrolling_t *ptThis)
+{
+#if __PLATFORM_CFG_USE_MONO_FILM__
+    return this.bMonoFilm;
+#else
+    ARM_2D_UNUSED(ptThis);
+    return false;
+#endif
+}
+
+static bool __rickrolling_is_frame_cached(user_scene_rickrolling_t *ptThis)
+{
+#if __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+    return NULL != this.tileFrameCache.pchBuffer;
+#else
+    ARM_2D_UNUSED(ptThis);
+    return false;
+#endif
+}
+
+static void __rickrolling_add_decode_time(  user_scene_rickrolling_t *ptThis,
+                                            int64_t lTicks)
+{
+    this.DecodeStat.lCurrent += lTicks;
+    this.DecodeStat.wPasses++;
+}
+
+static void __rickrolling_dump_decode_stat(user_scene_rickrolling_t *ptThis)
+{
+    if (0 == this.DecodeStat.wFrames) {
+        return ;
+    }
+
+    printf( "[rickrolling] %"PRIu32" frames decoded, %"PRIu32" loader passes"
+            " per frame, avg:%"PRId32"us  max:%"PRId32"us (frame cache: %s)\r\n",
+            this.DecodeStat.wFrames,
+            this.DecodeStat.wPasses / this.DecodeStat.wFrames,
+            (int32_t)perfc_convert_ticks_to_us(  this.DecodeStat.lTotal 
+                                              /  this.DecodeStat.wFrames),
+            (int32_t)perfc_convert_ticks_to_us(this.DecodeStat.lMax),
+            __rickrolling_is_frame_cached(ptThis) ? "on" : "off");
+}
+
+/* prepare the TJpgDec loader, i.e. the JPEG is played */
+static void __rickrolling_init_jpeg(user_scene_rickrolling_t *ptThis)
+{
+    /* initialize TJpgDec loader */
+    do {
+    #if ARM_2D_DEMO_TJPGD_USE_FILE
+        arm_tjpgd_io_file_loader_init(&this.LoaderIO.tFile, "Rickrolling75.jpg");
+    #else
+        extern const uint8_t c_chRickRolling75[104704];
+
+        arm_tjpgd_io_binary_loader_init(&this.LoaderIO.tBinary, c_chRickRolling75, sizeof(c_chRickRolling75));
+    #endif
+
+        arm_tjpgd_loader_cfg_t tCFG = {
+            .bUseHeapForVRES = true,
+            .ptScene = (arm_2d_scene_t *)ptThis,
+            .u2WorkMode = ARM_TJPGD_MODE_PARTIAL_DECODED,
+        
+        #if ARM_2D_DEMO_TJPGD_USE_FILE
+            .ImageIO = {
+                .ptIO = &ARM_TJPGD_IO_FILE_LOADER,
+                .pTarget = (uintptr_t)&this.LoaderIO.tFile,
+            },
+        #else
+            .ImageIO = {
+                .ptIO = &ARM_TJPGD_IO_BINARY_LOADER,
+                .pTarget = (uintptr_t)&this.LoaderIO.tBinary,
+            },
+        #endif
+
+        };
+
+    #if !ARM_2D_DEMO_TJPGD_USE_FILE && ARM_2D_DEMO_TJPGD_USE_ASSET_STREAM
+        /* fall back to the binary loader when no stream is available */
+        this.ptAssetStream = asset_stream_open( c_chRickRolling75, 
+                                                sizeof(c_chRickRolling75));
+        if (NULL != this.ptAssetStream) {
+            tCFG.ImageIO.ptIO = &ASSET_STREAM_TJPGD_IO;
+            tCFG.ImageIO.pTarget = (uintptr_t)this.ptAssetStream;
+        }
+    #endif
+
+        arm_tjpgd_loader_init(&this.tAnimation, &tCFG);
+    } while(0);
+
+    this.tFilm = (arm_2d_helper_film_t)impl_film(this.tAnimation, 100, 108, 1, 62, 16);
+
+#if __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+    /* fall back to decoding in each PFB band when there is no memory */
+    arm_2d_size_t tFrameSize = this.tFilm.use_as__arm_2d_tile_t.tRegion.tSize;
+    COLOUR_INT *ptFrame = __arm_2d_allocate_scratch_memory(
+                                tFrameSize.iWidth 
+                              * tFrameSize.iHeight 
+                              * sizeof(COLOUR_INT),
+                                __alignof__(COLOUR_INT),
+                                ARM_2D_MEM_TYPE_UNSPECIFIED);
+
+    if (NULL != ptFrame) {
+        this.tileFrameCache = (arm_2d_tile_t) {
+            .tRegion = {
+                .tSize = tFrameSize,
+            },
+            .tInfo = {
+                .bIsRoot = true,
+            },
+            .pchBuffer = (uint8_t *)ptFrame,
+        };
+    }
+#endif
+}
+
+#if __PLATFORM_CFG_USE_MONO_FILM__
+/*!
+ * \brief stop the film and play the JPEG instead
+ * \note a corrupted frame leaves a partially decoded (delta) frame in the
+ *       buffer, and the frames after it depend on that.
+ */
+static void __rickrolling_stop_mono_film(user_scene_rickrolling_t *ptThis)
+{
+    __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, 
+                                 this.tileMonoFrame.pchBuffer);
+    this.tileMonoFrame.pchBuffer = NULL;
+    this.bMonoFilm = false;
+
+    /* the JPEG is dithered by the EPD driver again */
+    epd_screen_set_dither_mode(this.bDitherEnabled);
+
+    printf("[rickrolling] corrupted film frame, fall back to the JPEG\r\n");
+
+    __rickrolling_init_jpeg(ptThis);
+    arm_tjpgd_loader_on_load(&this.tAnimation);
+
+    arm_2d_scene_player_update_scene_background(this.use_as__arm_2d_scene_t.ptPlayer);
+}
+#endif
+
 static void __on_scene_rickrolling_load(arm_2d_scene_t *ptScene)
 {
     user_scene_rickrolling_t *ptThis = (user_scene_rickrolling_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
-    arm_tjpgd_loader_on_load(&this.tAnimation);
+    if (!__rickrolling_is_mono_film(ptThis)) {
+        arm_tjpgd_loader_on_load(&this.tAnimation);
+    }
+#if __PLATFORM_CFG_USE_MONO_FILM__
+    else {
+        /* the film is dithered by tools/film_pack.py already. There is no
+         * need to restore the setting on switching out, the playlist sets
+         * the dither mode of every scene it switches to.
+         */
+        this.bDitherEnabled = epd_screen_set_dither_mode(false);
+    }
+#endif
 }
 
 static void __after_scene_rickrolling_switching(arm_2d_scene_t *ptScene)
@@ -108,8 +266,30 @@ static void __on_scene_rickrolling_depose(arm_2d_scene_t *ptScene)
 {
     user_scene_rickrolling_t *ptThis = (user_scene_rickrolling_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
-    
-    arm_tjpgd_loader_depose(&this.tAnimation);
+
+#if __PLATFORM_CFG_USE_MONO_FILM__
+    if (this.bMonoFilm) {
+        __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, 
+                                     this.tileMonoFrame.pchBuffer);
+        this.tileMonoFrame.pchBuffer = NULL;
+    } else
+#endif
+    {
+        __rickrolling_dump_decode_stat(ptThis);
+
+    #if __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+        __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, 
+                                     this.tileFrameCache.pchBuffer);
+        this.tileFrameCache.pchBuffer = NULL;
+    #endif
+
+        arm_tjpgd_loader_depose(&this.tAnimation);
+
+    #if !ARM_2D_DEMO_TJPGD_USE_FILE && ARM_2D_DEMO_TJPGD_USE_ASSET_STREAM
+        asset_stream_close(this.ptAssetStream);
+        this.ptAssetStream = NULL;
+    #endif
+    }
 
     arm_foreach(int64_t,this.lTimestamp, ptItem) {
         *ptItem = 0;
@@ -144,12 +324,52 @@ static void __on_scene_rickrolling_frame_start(arm_2d_scene_t *ptScene)
     user_scene_rickrolling_t *ptThis = (user_scene_rickrolling_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
+#if __PLATFORM_CFG_USE_MONO_FILM__
+    if (this.bMonoFilm) {
+        if (arm_2d_helper_is_time_out(  this.tMonoFilm.ptHeader->hwPeriod, 
+                                        &this.lTimestamp[0])) {
+            /* no JPEG decoding and no dithering, only the changed bytes */
+            if (!mono_film_decode_next_frame(&this.tMonoFilm, 
+                                             this.tileMonoFrame.pchBuffer)) {
+                __rickrolling_stop_mono_film(ptThis);
+            }
+        }
+
+        if (this.bMonoFilm) {
+            return ;
+        }
+    }
+#endif
+
+    bool bNextFrame = false;
     if (arm_2d_helper_is_time_out( this.tFilm.hwPeriodPerFrame , &this.lTimestamp[0])) {
 
         arm_2d_helper_film_next_frame(&this.tFilm);
+        bNextFrame = true;
     }
 
     arm_tjpgd_loader_on_frame_start(&this.tAnimation);
+
+#if __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+    if (    __rickrolling_is_frame_cached(ptThis)
+        &&  (bNextFrame || !this.bFrameCacheValid)) {
+        int64_t lStart = get_system_ticks();
+
+        /* the whole frame is requested in one pass, so the loader walks
+         * through each MCU of it only once, no matter how many PFB bands 
+         * intersect the frame later.
+         */
+        arm_2d_tile_copy_only(  (const arm_2d_tile_t *)&this.tFilm,
+                                &this.tileFrameCache,
+                                NULL);
+        ARM_2D_OP_WAIT_ASYNC();
+
+        __rickrolling_add_decode_time(ptThis, get_system_ticks() - lStart);
+        this.bFrameCacheValid = true;
+    }
+#else
+    ARM_2D_UNUSED(bNextFrame);
+#endif
 }
 
 static void __on_scene_rickrolling_frame_complete(arm_2d_scene_t *ptScene)
@@ -157,7 +377,17 @@ static void __on_scene_rickrolling_frame_complete(arm_2d_scene_t *ptScene)
     user_scene_rickrolling_t *ptThis = (user_scene_rickrolling_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
-    arm_tjpgd_loader_on_frame_complete(&this.tAnimation);
+    if (!__rickrolling_is_mono_film(ptThis)) {
+        arm_tjpgd_loader_on_frame_complete(&this.tAnimation);
+
+        if (this.DecodeStat.lCurrent > 0) {
+            this.DecodeStat.wFrames++;
+            this.DecodeStat.lTotal += this.DecodeStat.lCurrent;
+            this.DecodeStat.lMax = MAX( this.DecodeStat.lMax, 
+                                        this.DecodeStat.lCurrent);
+            this.DecodeStat.lCurrent = 0;
+        }
+    }
 }
 
 static void __before_scene_rickrolling_switching_out(arm_2d_scene_t *ptScene)
@@ -194,12 +424,48 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_rickrolling_handler)
                                     
         }
 
+    #if __PLATFORM_CFG_USE_MONO_FILM__
+        if (this.bMonoFilm) {
+            arm_2d_align_centre(__top_canvas, 
+                                this.tileMonoFrame.tRegion.tSize) {
+
+                arm_2d_draw_pattern(&this.tileMonoFrame,
+                                    ptTile,
+                                    &__centre_region,
+                                    ARM_2D_DRW_PATN_MODE_COPY,
+                                    GLCD_COLOR_BLACK,
+                                    GLCD_COLOR_WHITE);
+
+                arm_2d_helper_dirty_region_update_item( 
+                        &this.use_as__arm_2d_scene_t.tDirtyRegionHelper.tDefaultItem,
+                        (arm_2d_tile_t *)ptTile,
+                        &__top_canvas,
+                        &__centre_region);
+            }
+        } else
+    #endif
         arm_2d_align_centre(__top_canvas, 
                             this.tFilm.use_as__arm_2d_tile_t.tRegion.tSize ) {
             
-            arm_2d_tile_copy_only(  (const arm_2d_tile_t *)&this.tFilm,
-                                    ptTile,
-                                    &__centre_region);
+        #if __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+            if (__rickrolling_is_frame_cached(ptThis)) {
+                arm_2d_tile_copy_only(  &this.tileFrameCache,
+                                        ptTile,
+                                        &__centre_region);
+            } else
+        #endif
+            {
+                /* the loader decodes the frame from its start for each band */
+                int64_t lStart = get_system_ticks();
+                arm_fsm_rt_t tResult 
+                    = arm_2d_tile_copy_only((const arm_2d_tile_t *)&this.tFilm,
+                                            ptTile,
+                                            &__centre_region);
+                if ((arm_fsm_rt_t)ARM_2D_ERR_OUT_OF_REGION != tResult) {
+                    __rickrolling_add_decode_time(  ptThis, 
+                                                    get_system_ticks() - lStart);
+                }
+            }
             
             arm_2d_helper_dirty_region_update_item( 
                     &this.use_as__arm_2d_scene_t.tDirtyRegionHelper.tDefaultItem,
@@ -269,39 +535,45 @@ user_scene_rickrolling_t *__arm_2d_scene_rickrolling_init(   arm_2d_scene_player
     };
 
     /* ------------   initialize members of user_scene_rickrolling_t begin ---------------*/
-    /* initialize TJpgDec loader */
-    do {
-    #if ARM_2D_DEMO_TJPGD_USE_FILE
-        arm_tjpgd_io_file_loader_init(&this.LoaderIO.tFile, "Rickrolling75.jpg");
-    #else
-        extern const uint8_t c_chRickRolling75[104704];
-
-        arm_tjpgd_io_binary_loader_init(&this.LoaderIO.tBinary, c_chRickRolling75, sizeof(c_chRickRolling75));
-    #endif
-
-        arm_tjpgd_loader_cfg_t tCFG = {
-            .bUseHeapForVRES = true,
-            .ptScene = (arm_2d_scene_t *)ptThis,
-            .u2WorkMode = ARM_TJPGD_MODE_PARTIAL_DECODED,
-        
-        #if ARM_2D_DEMO_TJPGD_USE_FILE
-            .ImageIO = {
-                .ptIO = &ARM_TJPGD_IO_FILE_LOADER,
-                .pTarget = (uintptr_t)&this.LoaderIO.tFile,
-            },
-        #else
-            .ImageIO = {
-                .ptIO = &ARM_TJPGD_IO_BINARY_LOADER,
-                .pTarget = (uintptr_t)&this.LoaderIO.tBinary,
-            },
-        #endif
-
-        };
-
-        arm_tjpgd_loader_init(&this.tAnimation, &tCFG);
-    } while(0);
+#if __PLATFORM_CFG_USE_MONO_FILM__
+    /* play the pre-dithered film when it is in flash */
+    if (mono_film_open(&this.tMonoFilm)) {
+        uint8_t *pchFrame = __arm_2d_allocate_scratch_memory(
+                                    mono_film_get_frame_size(&this.tMonoFilm),
+                                    4,
+                                    ARM_2D_MEM_TYPE_UNSPECIFIED);
+
+        if (NULL != pchFrame) {
+            this.tileMonoFrame = (arm_2d_tile_t) {
+                .tRegion = {
+                    .tSize = {
+                        .iWidth = this.tMonoFilm.ptHeader->hwWidth,
+                        .iHeight = this.tMonoFilm.ptHeader->hwHeight,
+                    },
+                },
+                .tInfo = {
+                    .bIsRoot = true,
+                    .bHasEnforcedColour = true,
+                    .tColourInfo = {
+                        .chScheme = ARM_2D_COLOUR_1BIT,
+                    },
+                },
+                .pchBuffer = pchFrame,
+            };
+
+            /* the first frame is a key frame */
+            if (mono_film_decode_next_frame(&this.tMonoFilm, pchFrame)) {
+                this.bMonoFilm = true;
+            } else {
+                __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, pchFrame);
+                this.tileMonoFrame.pchBuffer = NULL;
+            }
+        }
+    }
 
-    this.tFilm = (arm_2d_helper_film_t)impl_film(this.tAnimation, 100, 108, 1, 62, 16);
+    if (!this.bMonoFilm)
+#endif
+    __rickrolling_init_jpeg(ptThis);
 
     /* ------------   initialize members of user_scene_rickrolling_t end   ---------------*/
 
@@ -31,6 +31,8 @@
 #include "arm_2d_helper.h"
 #include "arm_2d_example_loaders.h"
 
+#include "../../platform/mono_film.h"
+
 #ifdef   __cplusplus
 extern "C" {
 #endif
@@ -65,6 +67,11 @@ extern "C" {
 #   define ARM_2D_DEMO_TJPGD_USE_FILE  0
 #endif
 
+/* stream the JPEG through the read-ahead buffer of platform/asset_stream.c */
+#ifndef ARM_2D_DEMO_TJPGD_USE_ASSET_STREAM
+#   define ARM_2D_DEMO_TJPGD_USE_ASSET_STREAM  __PLATFORM_CFG_USE_ASSET_STREAM__
+#endif
+
 /*============================ MACROFIED FUNCTIONS ===========================*/
 
 /*!
@@ -99,9 +106,31 @@ ARM_PRIVATE(
         arm_tjpgd_io_file_loader_t tFile;
         arm_tjpgd_io_binary_loader_t tBinary;
     } LoaderIO;
+    void *ptAssetStream;
 
     arm_2d_helper_film_t tFilm;
 
+#if __PLATFORM_CFG_USE_JPEG_FRAME_CACHE__
+    arm_2d_tile_t tileFrameCache;               //!< the current frame, decoded once
+    bool bFrameCacheValid;
+#endif
+
+    /* the time spent in the TJpgDec loader */
+    struct {
+        int64_t lCurrent;                       //!< the current frame
+        int64_t lTotal;
+        int64_t lMax;
+        uint32_t wFrames;                       //!< the frames that decode
+        uint32_t wPasses;                       //!< the invocations of the loader
+    } DecodeStat;
+
+#if __PLATFORM_CFG_USE_MONO_FILM__
+    /* the pre-dithered film in flash replaces the JPEG when it is available */
+    bool bMonoFilm;
+    bool bDitherEnabled;                        //!< the dither mode of the JPEG
+    mono_film_t tMonoFilm;
+    arm_2d_tile_t tileMonoFrame;                //!< the decoded frame in 1bpp
+#endif
 )
     /* place your public member here */
     
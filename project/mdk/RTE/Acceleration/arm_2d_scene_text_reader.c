@@ -26,6 +26,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../../platform/platform.h"
+#include "../../platform/idle_sleep.h"
+
 #if defined(__clang__)
 #   pragma clang diagnostic push
 #   pragma clang diagnostic ignored "-Wunknown-warning-option"
@@ -127,14 +130,301 @@ const char c_chStory[] = {
     "Thus, in the annals of Lexiconia, the memory of that fateful night lived on as a beacon of intellectual triumph and the enduring magic of words, reminding all who encountered it that even the longest, most intricate expressions have the power to unite hearts and minds in the eternal quest for enlightenment."
 };
 
+/* the text used by the scenes created afterwards, NULL means the default */
+static struct {
+    const char *pchText;
+    size_t tSize;
+} s_tText;
+
 /*============================ IMPLEMENTATION ================================*/
 
+static int16_t __text_reader_get_advance(   void *pTarget,
+                                            const char *pchChar,
+                                            uint_fast8_t chLength)
+{
+    char chBuffer[5];
+
+    chLength = MIN(chLength, sizeof(chBuffer) - 1);
+    memcpy(chBuffer, pchChar, chLength);
+    chBuffer[chLength] = '\0';
+
+    return arm_lcd_get_string_line_box(chBuffer, (arm_2d_font_t *)pTarget).iWidth;
+}
+
+#if __PLATFORM_CFG_USE_FLASH_TEXT__
+/* the text box stream IO of flash_text_reader_t */
+static
+bool __text_reader_flash_io_seek(   uintptr_t pTarget,
+                                    int32_t nOffset,
+                                    text_box_seek_whence_t enWhence)
+{
+    flash_text_reader_t *ptReader = (flash_text_reader_t *)pTarget;
+
+    switch (enWhence) {
+        case TEXT_BOX_SEEK_SET:
+            return flash_text_reader_seek(ptReader, nOffset, FLASH_TEXT_SEEK_SET);
+        case TEXT_BOX_SEEK_CUR:
+            return flash_text_reader_seek(ptReader, nOffset, FLASH_TEXT_SEEK_CUR);
+        case TEXT_BOX_SEEK_END:
+            return flash_text_reader_seek(ptReader, nOffset, FLASH_TEXT_SEEK_END);
+        default:
+            return false;
+    }
+}
+
+static
+int32_t __text_reader_flash_io_read(uintptr_t pTarget,
+                                    uint8_t *pchBuffer,
+                                    uint_fast16_t hwSize)
+{
+    return flash_text_reader_read(  (flash_text_reader_t *)pTarget,
+                                    pchBuffer,
+                                    MIN(hwSize, UINT16_MAX));
+}
+
+static const text_box_io_handler_t c_tFlashTextIO = {
+    .fnSeek = &__text_reader_flash_io_seek,
+    .fnRead = &__text_reader_flash_io_read,
+};
+
+/* the line-break index reads the document through the reader, too */
+static uint16_t __text_reader_layout_read(  void *pSource,
+                                            uint32_t wOffset,
+                                            uint8_t *pchBuffer,
+                                            uint16_t hwSize)
+{
+    return flash_text_reader_read_at(   (flash_text_reader_t *)pSource,
+                                        wOffset,
+                                        pchBuffer,
+                                        hwSize);
+}
+#endif
+
+static void __text_reader_init_text_box(user_scene_text_reader_t *ptThis)
+{
+    text_box_cfg_t tCFG = {
+        .ptFont = this.ptFont,
+        .tStreamIO = {
+            .ptIO       = &TEXT_BOX_IO_C_STRING_READER,
+            .pTarget    = (uintptr_t)&this.tStringReader,
+        },
+        .u2LineAlign = TEXT_BOX_LINE_ALIGN_JUSTIFIED,
+        //.fScale = 0.7f,
+        //.chSpaceBetweenParagraph = 20,
+
+        .ptScene = (arm_2d_scene_t *)ptThis,
+        .bUseDirtyRegions = true,
+    };
+
+#if __PLATFORM_CFG_USE_FLASH_TEXT__
+    if (this.bFlashText) {
+        tCFG.tStreamIO.ptIO = &c_tFlashTextIO;
+        tCFG.tStreamIO.pTarget = (uintptr_t)&this.tFlashReader;
+    }
+#endif
+
+    text_box_init(&this.tTextPanel, &tCFG);
+}
+
+/*
+ * point the string reader to hwLines lines starting from wLine, so the text
+ * box never measures more than a window (or a page) no matter how far the
+ * text is scrolled.
+ */
+static bool __text_reader_set_window(   user_scene_text_reader_t *ptThis,
+                                        uint32_t wLine,
+                                        uint16_t hwLines)
+{
+    int32_t nStart = text_layout_get_line_offset(&this.tLayout, wLine);
+    if (nStart < 0) {
+        /* not indexed yet */
+        return false;
+    }
+
+    int32_t nEnd = text_layout_get_line_offset(&this.tLayout,
+                                               wLine + hwLines);
+    bool bAtEnd = false;
+    if (text_layout_is_complete(&this.tLayout)) {
+        if (nEnd < 0 || nEnd >= (int32_t)this.tLayout.wCursor) {
+            /* the last window also covers the text beyond a full index */
+            nEnd = this.tTextSize;
+            bAtEnd = true;
+        }
+    } else if (nEnd < 0) {
+        /* the last indexed line might still grow */
+        nEnd = text_layout_get_line_offset(&this.tLayout,
+                                           text_layout_get_line_count(&this.tLayout) - 1);
+        nEnd = MAX(nEnd, nStart);
+    }
+
+#if __PLATFORM_CFG_USE_FLASH_TEXT__
+    if (this.bFlashText) {
+        /* the cached blocks survive the move */
+        flash_text_reader_set_window(&this.tFlashReader, nStart, nEnd - nStart);
+    } else
+#endif
+    {
+        text_box_c_str_reader_init( &this.tStringReader,
+                                    this.pchText + nStart,
+                                    nEnd - nStart);
+    }
+
+    this.wWindowLine = wLine;
+    this.bWindowAtEnd = bAtEnd;
+
+    return true;
+}
+
+static bool __text_reader_move_window(  user_scene_text_reader_t *ptThis,
+                                        uint32_t wLine,
+                                        uint16_t hwLines)
+{
+    if (!__text_reader_set_window(ptThis, wLine, hwLines)) {
+        return false;
+    }
+
+    text_box_depose(&this.tTextPanel);
+    __text_reader_init_text_box(ptThis);
+    text_box_on_load(&this.tTextPanel);
+
+    return true;
+}
+
+#if TEXT_READER_USE_PAGE_FLIP
+enum {
+    TEXT_READER_PAGE_SHOWING,                   //!< the page is rendered to the panel
+    TEXT_READER_PAGE_RENDERING,                 //!< the next page is rendered offscreen
+    TEXT_READER_PAGE_READY,                     //!< the next page waits offscreen
+};
+
+/* get the page after the given one, i.e. 0 after the last page */
+static uint32_t __text_reader_get_next_page(user_scene_text_reader_t *ptThis,
+                                            uint32_t wPage)
+{
+    uint32_t wLine = (wPage + 1) * this.hwPageLines;
+
+    do {
+        uint32_t wCount = text_layout_get_line_count(&this.tLayout);
+        bool bComplete = text_layout_is_complete(&this.tLayout);
+
+        if (    (wLine < wCount)
+            &&  (bComplete || (wLine + this.hwPageLines < wCount))) {
+            return wPage + 1;
+        } else if (wLine >= wCount && bComplete) {
+            return 0;
+        }
+
+        /* the boundaries of the page are not known yet */
+        text_layout_build(&this.tLayout, TEXT_READER_INDEX_BUDGET);
+    } while(true);
+}
+
+static bool __text_reader_show_page(user_scene_text_reader_t *ptThis, uint32_t wPage)
+{
+    if (!__text_reader_move_window(ptThis,
+                                   wPage * this.hwPageLines,
+                                   this.hwPageLines)) {
+        return false;
+    }
+
+    text_box_set_scrolling_position(&this.tTextPanel, 0);
+    this.wPage = wPage;
+
+    return true;
+}
+
+/* start (or restart) rendering the page in the window offscreen */
+static void __text_reader_render_page_offscreen(user_scene_text_reader_t *ptThis)
+{
+    epd_offscreen_begin(this.pchPage);
+    this.chPageState = TEXT_READER_PAGE_RENDERING;
+
+    /* the page starts blank, hence every band must be drawn, not only the
+     * dirty regions of the text box
+     */
+    arm_2d_scene_player_update_scene_background(this.use_as__arm_2d_scene_t.ptPlayer);
+}
+
+/* render the next page offscreen while the panel shows the current one */
+static void __text_reader_prepare_next_page(user_scene_text_reader_t *ptThis)
+{
+    if (NULL == this.pchPage) {
+        return ;
+    }
+
+    if (__text_reader_show_page(ptThis,
+                                __text_reader_get_next_page(ptThis, this.wPage))) {
+        __text_reader_render_page_offscreen(ptThis);
+    }
+}
+
+static void __text_reader_stop_offscreen(user_scene_text_reader_t *ptThis)
+{
+    if (TEXT_READER_PAGE_SHOWING != this.chPageState) {
+        epd_offscreen_cancel();
+        this.chPageState = TEXT_READER_PAGE_SHOWING;
+    }
+}
+
+#if TEXT_READER_PAGE_FLIP_MS > 0
+static void __text_reader_on_flip_timer(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    ARM_2D_UNUSED(ptTimer);
+
+    arm_2d_scene_text_reader_flip_page((user_scene_text_reader_t *)pTarget);
+}
+#endif
+
+static void __text_reader_page_flip_on_frame_start(user_scene_text_reader_t *ptThis)
+{
+    if (this.bFlipRequested) {
+        if (TEXT_READER_PAGE_READY == this.chPageState) {
+            /* a single SPI burst plus one refresh */
+            if (epd_offscreen_present()) {
+                this.bFlipRequested = false;
+                this.chPageState = TEXT_READER_PAGE_SHOWING;
+
+                /* this frame renders the page after it */
+                __text_reader_prepare_next_page(ptThis);
+            }
+        } else if (NULL == this.pchPage) {
+            /* no offscreen page, render the next page to the panel */
+            if (__text_reader_show_page(ptThis,
+                                        __text_reader_get_next_page(ptThis, this.wPage))) {
+                this.bFlipRequested = false;
+            }
+        }
+    }
+
+    /* no frame is needed until the next flip, unless a page is being
+     * rendered offscreen. The flip timer wakes up the main loop.
+     */
+    if (TEXT_READER_PAGE_RENDERING == this.chPageState) {
+        return ;
+    } else if (this.bFlipRequested) {
+        /* e.g. the panel is busy, its release wakes up the main loop earlier */
+        idle_sleep_next_frame_in_ms(50);
+    } else {
+        idle_sleep_next_frame_in_ms(UINT32_MAX);
+    }
+}
+#endif
+
 static void __on_scene_text_reader_load(arm_2d_scene_t *ptScene)
 {
     user_scene_text_reader_t *ptThis = (user_scene_text_reader_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
     text_box_on_load(&this.tTextPanel);
+
+#if TEXT_READER_USE_PAGE_FLIP && TEXT_READER_PAGE_FLIP_MS > 0
+    /* the scene may be preloaded, so the pages start flipping on loading */
+    system_timer_start( &this.tFlipTimer,
+                        TEXT_READER_PAGE_FLIP_MS,
+                        TEXT_READER_PAGE_FLIP_MS,
+                        &__text_reader_on_flip_timer,
+                        ptThis);
+#endif
 }
 
 static void __after_scene_text_reader_switching(arm_2d_scene_t *ptScene)
@@ -151,6 +441,20 @@ static void __on_scene_text_reader_depose(arm_2d_scene_t *ptScene)
     
     text_box_depose(&this.tTextPanel);
 
+#if TEXT_READER_USE_PAGE_FLIP
+    system_timer_stop(&this.tFlipTimer);
+    __text_reader_stop_offscreen(ptThis);
+    if (NULL != this.pchPage) {
+        __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, this.pchPage);
+        this.pchPage = NULL;
+    }
+#endif
+
+    if (NULL != this.ptLines) {
+        __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, this.ptLines);
+        this.ptLines = NULL;
+    }
+
     arm_foreach(int64_t,this.lTimestamp, ptItem) {
         *ptItem = 0;
     }
@@ -192,21 +496,47 @@ static void __on_scene_text_reader_frame_start(arm_2d_scene_t *ptScene)
         }
         text_box_set_start_line(&this.tTextPanel, this.iLineNumber);
     }
+#elif TEXT_READER_USE_PAGE_FLIP
+    __text_reader_page_flip_on_frame_start(ptThis);
 #else
 
     int32_t iCurrentLine = text_box_get_start_line(&this.tTextPanel);
     if (this.bDownScrolling) {
-        if (iCurrentLine == 0) {
+        if (iCurrentLine == 0 && 0 == this.wWindowLine) {
             this.bDownScrolling = false;
         } else {
+            if ((this.iScrollPosition < 2) && (this.wWindowLine > 0)) {
+                /* move the window one line up */
+                if (__text_reader_move_window(ptThis,
+                                              this.wWindowLine - 1,
+                                              TEXT_READER_WINDOW_LINES)) {
+                    this.iScrollPosition += text_box_get_line_height(&this.tTextPanel);
+                    text_box_set_scrolling_position(&this.tTextPanel, 
+                                                    this.iScrollPosition);
+                }
+            }
             text_box_set_scrolling_position_offset(&this.tTextPanel, -2);
+            this.iScrollPosition -= 2;
         }
     } else {
-        if (    text_box_has_end_of_stream_been_reached(&this.tTextPanel) 
+        if (    this.bWindowAtEnd
+            &&  text_box_has_end_of_stream_been_reached(&this.tTextPanel) 
             &&  iCurrentLine == text_box_get_current_line_count(&this.tTextPanel)) {
             this.bDownScrolling = true;
         } else {
+            if (iCurrentLine > 0) {
+                /* the first line of the window has scrolled out */
+                if (__text_reader_move_window(ptThis,
+                                              this.wWindowLine + iCurrentLine,
+                                              TEXT_READER_WINDOW_LINES)) {
+                    this.iScrollPosition -= iCurrentLine 
+                                          * text_box_get_line_height(&this.tTextPanel);
+                    text_box_set_scrolling_position(&this.tTextPanel, 
+                                                    this.iScrollPosition);
+                }
+            }
             text_box_set_scrolling_position_offset(&this.tTextPanel, 2);
+            this.iScrollPosition += 2;
         }
     }
 
@@ -221,6 +551,25 @@ static void __on_scene_text_reader_frame_complete(arm_2d_scene_t *ptScene)
     ARM_2D_UNUSED(ptThis);
 
     text_box_on_frame_complete(&this.tTextPanel);
+
+    /* index the rest of the text in the background */
+    text_layout_build(&this.tLayout, TEXT_READER_INDEX_BUDGET);
+
+#if TEXT_READER_USE_PAGE_FLIP
+    if (TEXT_READER_PAGE_RENDERING == this.chPageState) {
+        if (epd_offscreen_is_complete()) {
+            /* the next page is complete in the offscreen buffer */
+            this.chPageState = TEXT_READER_PAGE_READY;
+        } else {
+            /* some bands were not drawn, e.g. the full redraw had not taken 
+             * effect yet, render the whole page again
+             */
+            __text_reader_render_page_offscreen(ptThis);
+        }
+    } else if (TEXT_READER_PAGE_SHOWING == this.chPageState) {
+        __text_reader_prepare_next_page(ptThis);
+    }
+#endif
 }
 
 static void __before_scene_text_reader_switching_out(arm_2d_scene_t *ptScene)
@@ -228,6 +577,13 @@ static void __before_scene_text_reader_switching_out(arm_2d_scene_t *ptScene)
     user_scene_text_reader_t *ptThis = (user_scene_text_reader_t *)ptScene;
     ARM_2D_UNUSED(ptThis);
 
+#if TEXT_READER_USE_PAGE_FLIP
+    system_timer_stop(&this.tFlipTimer);
+
+    /* the next scene renders to the panel */
+    __text_reader_stop_offscreen(ptThis);
+#endif
+
 }
 
 static
@@ -280,6 +636,17 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_text_reader_handler)
     return arm_fsm_rt_cpl;
 }
 
+void arm_2d_scene_text_reader_set_text(const char *pchText, size_t tSize)
+{
+    if (NULL == pchText || 0 == tSize) {
+        s_tText.pchText = NULL;
+        s_tText.tSize = 0;
+    } else {
+        s_tText.pchText = pchText;
+        s_tText.tSize = tSize;
+    }
+}
+
 ARM_NONNULL(1)
 user_scene_text_reader_t *__arm_2d_scene_text_reader_init(   arm_2d_scene_player_t *ptDispAdapter, 
                                         user_scene_text_reader_t *ptThis)
@@ -326,7 +693,7 @@ user_scene_text_reader_t *__arm_2d_scene_text_reader_init(   arm_2d_scene_player
             //.fnOnBGStart    = &__on_scene_text_reader_background_start,
             //.fnOnBGComplete = &__on_scene_text_reader_background_complete,
             .fnOnFrameStart = &__on_scene_text_reader_frame_start,
-            //.fnBeforeSwitchOut = &__before_scene_text_reader_switching_out,
+            .fnBeforeSwitchOut = &__before_scene_text_reader_switching_out,
             .fnOnFrameCPL   = &__on_scene_text_reader_frame_complete,
             .fnDepose       = &__on_scene_text_reader_depose,
 
@@ -337,31 +704,103 @@ user_scene_text_reader_t *__arm_2d_scene_text_reader_init(   arm_2d_scene_player
 
     /* ------------   initialize members of user_scene_text_reader_t begin ---------------*/
 
-    /* initialize textbox */
+    /* initialize the line-break index */
     do {
-        text_box_c_str_reader_init( &this.tStringReader,
-                                    c_chStory,
-                                    sizeof(c_chStory));
-
-        text_box_cfg_t tCFG = {
-            .ptFont = (arm_2d_font_t *)&ARM_2D_FONT_LiberationSansRegular14_A4,
-            .tStreamIO = {
-                .ptIO       = &TEXT_BOX_IO_C_STRING_READER,
-                .pTarget    = (uintptr_t)&this.tStringReader,
-            },
-            .u2LineAlign = TEXT_BOX_LINE_ALIGN_JUSTIFIED,
-            //.fScale = 0.7f,
-            //.chSpaceBetweenParagraph = 20,
-
-            .ptScene = (arm_2d_scene_t *)ptThis,
-            .bUseDirtyRegions = true,
+        this.pchText = s_tText.pchText;
+        this.tTextSize = s_tText.tSize;
+
+        if (NULL == this.pchText) {
+        #if __PLATFORM_CFG_USE_FLASH_TEXT__
+            this.bFlashText = flash_text_open(&this.pchText, &this.tTextSize);
+            if (this.bFlashText) {
+                flash_text_reader_init( &this.tFlashReader,
+                                        this.pchText,
+                                        this.tTextSize);
+            } else
+        #endif
+            {
+                this.pchText = c_chStory;
+                this.tTextSize = sizeof(c_chStory);
+            }
+        }
+
+        this.ptLines = (text_layout_line_t *)
+            __arm_2d_allocate_scratch_memory(   sizeof(text_layout_line_t) 
+                                            *   TEXT_READER_MAX_LINES,
+                                                __alignof__(text_layout_line_t),
+                                                ARM_2D_MEM_TYPE_UNSPECIFIED);
+        assert(NULL != this.ptLines);
+
+        text_layout_cfg_t tCFG = {
+            .pchText = this.pchText,
+            .tSize = this.tTextSize,
+
+            .fnGetAdvance = &__text_reader_get_advance,
+            .pTarget = (void *)&ARM_2D_FONT_LiberationSansRegular14_A4,
+
+            /* the text box is docked with a margin of 8 pixels */
+            .iBoxWidth = __top_canvas.tSize.iWidth - 16,
+            .iCharSpacing = 1,
+
+            .ptLines = this.ptLines,
+            .hwMaxLines = (NULL != this.ptLines) ? TEXT_READER_MAX_LINES : 0,
+
+            /* the stride grows when the document has more lines than the buffer */
+            .chStrideShift = 0,
         };
 
-        text_box_init(&this.tTextPanel, &tCFG);
+    #if __PLATFORM_CFG_USE_FLASH_TEXT__
+        if (this.bFlashText) {
+            tCFG.pchText = NULL;
+            tCFG.fnRead = &__text_reader_layout_read;
+            tCFG.pSource = &this.tFlashReader;
+        }
+    #endif
+
+        text_layout_init(&this.tLayout, &tCFG);
+
+        /* index enough lines for the first windows */
+        while (     !text_layout_build(&this.tLayout, TEXT_READER_INDEX_BUDGET)
+                &&  (   text_layout_get_line_count(&this.tLayout) 
+                    <=  TEXT_READER_WINDOW_LINES * 2));
+
+    } while(0);
+
+    /* initialize textbox */
+    do {
+        /* the glyphs are thresholded to 1bpp anyway */
+        this.ptFont = glyph_cache_font_init(
+                        &this.tCachedFont,
+                        (const arm_2d_font_t *)&ARM_2D_FONT_LiberationSansRegular14_A4);
+
+        __text_reader_set_window(ptThis, 0, TEXT_READER_WINDOW_LINES);
+        __text_reader_init_text_box(ptThis);
+
+    #if TEXT_READER_USE_PAGE_FLIP
+        /* a page is the lines fitting into the docked box */
+        this.hwPageLines = (__top_canvas.tSize.iHeight - 16)
+                         / MAX(1, text_box_get_line_height(&this.tTextPanel));
+        this.hwPageLines = MAX(1, this.hwPageLines);
+
+        __text_reader_set_window(ptThis, 0, this.hwPageLines);
+        text_box_depose(&this.tTextPanel);
+        __text_reader_init_text_box(ptThis);
+        text_box_set_scrolling_position(&this.tTextPanel, 0);
+
+        size_t tPageSize = epd_offscreen_get_page_size();
+        if (tPageSize > 0) {
+            /* NULL means flipping pages without rendering them offscreen */
+            this.pchPage = __arm_2d_allocate_scratch_memory(tPageSize,
+                                                            4,
+                                                            ARM_2D_MEM_TYPE_UNSPECIFIED);
+        }
+        this.chPageState = TEXT_READER_PAGE_SHOWING;
+    #else
 
         /* set initial location */
-        text_box_set_scrolling_position(&this.tTextPanel, -__top_canvas.tSize.iHeight);
-        
+        this.iScrollPosition = -__top_canvas.tSize.iHeight;
+        text_box_set_scrolling_position(&this.tTextPanel, this.iScrollPosition);
+    #endif
     } while(0);
 
     /* ------------   initialize members of user_scene_text_reader_t end   ---------------*/
@@ -373,6 +812,19 @@ user_scene_text_reader_t *__arm_2d_scene_text_reader_init(   arm_2d_scene_player
     return ptThis;
 }
 
+ARM_NONNULL(1)
+void arm_2d_scene_text_reader_flip_page(user_scene_text_reader_t *ptThis)
+{
+    assert(NULL != ptThis);
+    ARM_2D_UNUSED(ptThis);
+
+#if TEXT_READER_USE_PAGE_FLIP
+    /* safe to call in an ISR, e.g. of a button */
+    this.bFlipRequested = true;
+    idle_sleep_notify();
+#endif
+}
+
 
 #if defined(__clang__)
 #   pragma clang diagnostic pop
@@ -30,6 +30,11 @@
 #include "arm_2d_helper.h"
 #include "arm_2d_example_controls.h"
 
+#include "../../platform/text_layout.h"
+#include "../../platform/flash_text.h"
+#include "../../platform/glyph_cache.h"
+#include "../../platform/timer_wheel.h"
+
 #ifdef   __cplusplus
 extern "C" {
 #endif
@@ -59,6 +64,31 @@ extern "C" {
 #endif
 #include "arm_2d_utils.h"
 
+/* the maximum number of lines in the line-break index */
+#ifndef TEXT_READER_MAX_LINES
+#   define TEXT_READER_MAX_LINES        512
+#endif
+
+/* the number of lines the text box measures at a time */
+#ifndef TEXT_READER_WINDOW_LINES
+#   define TEXT_READER_WINDOW_LINES     12
+#endif
+
+/* the number of bytes indexed after each frame */
+#ifndef TEXT_READER_INDEX_BUDGET
+#   define TEXT_READER_INDEX_BUDGET     256
+#endif
+
+/* show the text page by page instead of scrolling it, which suits e-paper */
+#ifndef TEXT_READER_USE_PAGE_FLIP
+#   define TEXT_READER_USE_PAGE_FLIP    1
+#endif
+
+/* flip the page every N ms, 0 means only flipping on request */
+#ifndef TEXT_READER_PAGE_FLIP_MS
+#   define TEXT_READER_PAGE_FLIP_MS     5000
+#endif
+
 /*============================ MACROFIED FUNCTIONS ===========================*/
 
 /*!
@@ -88,10 +118,35 @@ ARM_PRIVATE(
 
     bool bUserAllocated;
     bool bDownScrolling;
+    bool bWindowAtEnd;                          //!< the window reaches the end of the text
     int16_t iLineNumber;
 
+    const char *pchText;
+    size_t tTextSize;
+
+    /* the text box only sees a window of lines starting from wWindowLine */
+    text_layout_t tLayout;
+    text_layout_line_t *ptLines;
+    uint32_t wWindowLine;
+    int32_t iScrollPosition;                    //!< the scrolling position inside the window
+
     text_box_c_str_reader_t tStringReader;
+#if __PLATFORM_CFG_USE_FLASH_TEXT__
+    bool bFlashText;                            //!< stream the document in flash
+    flash_text_reader_t tFlashReader;
+#endif
     text_box_t tTextPanel;
+    glyph_cache_font_t tCachedFont;             //!< the font drawn from the 1bpp glyph cache
+    arm_2d_font_t *ptFont;
+
+#if TEXT_READER_USE_PAGE_FLIP
+    uint8_t *pchPage;                           //!< the next page rendered offscreen
+    uint32_t wPage;                             //!< the page on the panel
+    uint16_t hwPageLines;
+    uint8_t chPageState;
+    volatile bool bFlipRequested;
+    timer_wheel_timer_t tFlipTimer;             //!< flips a page every TEXT_READER_PAGE_FLIP_MS
+#endif
 )
     /* place your public member here */
     
@@ -105,6 +160,26 @@ extern
 user_scene_text_reader_t *__arm_2d_scene_text_reader_init(   arm_2d_scene_player_t *ptDispAdapter, 
                                         user_scene_text_reader_t *ptScene);
 
+/*!
+ * \brief set the text shown by the scenes created afterwards
+ * \note the text is referenced rather than copied, i.e. it should live in
+ *       ROM (or as long as the scenes)
+ * \param[in] pchText the text, NULL means using the document in flash or the
+ *            default story when there is no document
+ * \param[in] tSize the size of the text (including the '\0')
+ */
+extern
+void arm_2d_scene_text_reader_set_text(const char *pchText, size_t tSize);
+
+/*!
+ * \brief flip to the next page as soon as it is ready, e.g. on a button
+ * \note it is safe to call it from interrupt handlers
+ * \param[in] ptThis the scene
+ */
+ARM_NONNULL(1)
+extern
+void arm_2d_scene_text_reader_flip_page(user_scene_text_reader_t *ptThis);
+
 #if defined(__clang__)
 #   pragma clang diagnostic pop
 #elif __IS_COMPILER_GCC__
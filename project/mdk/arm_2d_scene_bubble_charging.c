@@ -134,6 +134,7 @@ static void __on_scene_bubble_charging_depose(arm_2d_scene_t *ptScene)
 
     dynamic_nebula_depose(&this.tNebula);
 
+    arm_2d_scratch_memory_free(&this.tBlurOP.tScratchMemory);
     ARM_2D_OP_DEPOSE(this.tBlurOP);
 
     if (!this.bUserAllocated) {
@@ -192,8 +193,6 @@ static void __on_scene_bubble_charging_frame_complete(arm_2d_scene_t *ptScene)
 //        arm_2d_scene_player_switch_to_next_scene(ptScene->ptPlayer);
 //    }
 
-    arm_2d_scratch_memory_free(&this.tBlurOP.tScratchMemory);
-
 }
 
 static void __before_scene_bubble_charging_switching_out(arm_2d_scene_t *ptScene)
@@ -248,20 +247,6 @@ IMPL_PFB_ON_DRAW(__pfb_draw_scene_bubble_charging_handler)
                             255,
                             bIsNewFrame);
 
-        if (bIsNewFrame) {
-
-            if (NULL == arm_2d_scratch_memory_new(  
-                                        &this.tBlurOP.tScratchMemory,
-                                        sizeof(__arm_2d_iir_blur_acc_t),
-                                        (   __charging_canvas.tSize.iHeight 
-                                        +   __charging_canvas.tSize.iWidth),
-                                        __alignof__(__arm_2d_iir_blur_acc_t),
-                                        ARM_2D_MEM_TYPE_FAST)) {
-                assert(false);  /* insufficient memory */
-            }
-
-        }
-        
         arm_2dp_filter_iir_blur(&this.tBlurOP,
                                 ptTile,
                                 &__charging_canvas,
@@ -412,6 +397,16 @@ user_scene_bubble_charging_t *__arm_2d_scene_bubble_charging_init(   arm_2d_scen
 
     ARM_2D_OP_INIT(this.tBlurOP);
 
+    /* the blur accumulator is kept for the whole life of the scene */
+    if (NULL == arm_2d_scratch_memory_new(  &this.tBlurOP.tScratchMemory,
+                                            sizeof(__arm_2d_iir_blur_acc_t),
+                                            (   tScreen.tSize.iHeight 
+                                            +   tScreen.tSize.iWidth),
+                                            __alignof__(__arm_2d_iir_blur_acc_t),
+                                            ARM_2D_MEM_TYPE_FAST)) {
+        assert(false);  /* insufficient memory */
+    }
+
     /* ------------   initialize members of user_scene_bubble_charging_t end   ---------------*/
 
     arm_2d_scene_player_append_scenes(  ptDispAdapter, 
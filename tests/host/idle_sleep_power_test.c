@@ -0,0 +1,304 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*
+ * A host simulation of the main loop on a virtual clock. It measures the
+ * wakeups, the time in WFE and the estimated average current of
+ * platform/idle_sleep.c for two scene profiles:
+ *  - a clock that changes once a second, where the panel refresh overlaps
+ *    the sleep between frames
+ *  - an animation whose frames come faster than the panel refreshes, where
+ *    the main loop sleeps in idle_sleep_wait_for_busy()
+ *
+ * Every profile is run with the BUSY edge wired as the EPD driver does it
+ * (idle_sleep_notify_busy_released()) and wired as a generic event
+ * (idle_sleep_notify()) for comparison.
+ *
+ * The currents are assumptions for RP2040 at 125MHz with the flash in XIP,
+ * not measurements. Please replace them with the figures of the board.
+ *
+ * Build and run from the root of the repository:
+ *
+ *   gcc -std=gnu11 -Wall -Itests/host/shim -o /tmp/idle_sleep_power_test \
+ *       tests/host/idle_sleep_power_test.c platform/idle_sleep.c
+ *   /tmp/idle_sleep_power_test
+ */
+/*============================ INCLUDES ======================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include "perf_counter.h"
+#include "arm_2d.h"
+
+#include "../../platform/platform.h"
+#include "../../platform/idle_sleep.h"
+
+/*============================ MACROS ========================================*/
+
+#define HOST_ACTIVE_CURRENT_UA          24000   /* running from XIP */
+#define HOST_WFE_CURRENT_UA             8000    /* clocks on, core in WFE */
+
+#define HOST_SIMULATION_MS              60000
+
+#define HOST_CHECK(__EXPR)                                                      \
+    do {                                                                        \
+        if (!(__EXPR)) {                                                        \
+            printf("FAILED: %s (line %d)\r\n", #__EXPR, __LINE__);             \
+            s_nFailures++;                                                      \
+        }                                                                       \
+    } while(0)
+
+/*============================ TYPES =========================================*/
+
+typedef struct {
+    const char *pchName;
+    uint32_t wFramePeriodMS;                    //!< the deadline the scene declares
+    uint32_t wRenderUS;                         //!< drawing, packing and SPI
+    uint32_t wRefreshUS;                        //!< the panel is BUSY for
+} host_profile_t;
+
+typedef struct {
+    uint32_t wFrames;
+    uint32_t wWakeups;
+    int64_t lActiveUS;
+    int64_t lSleepUS;
+    int64_t lBusyWaitUS;                        //!< time spent in wait_for_busy
+} host_result_t;
+
+/*============================ LOCAL VARIABLES ===============================*/
+
+static int s_nFailures = 0;
+
+static struct {
+    int64_t lNow;
+
+    bool bAlarmArmed;
+    int64_t lAlarm;
+    hardware_alarm_callback_t fnAlarm;
+
+    int64_t lBusyUntil;
+    bool bBusyEdgePending;
+    bool bBusyAsGenericEvent;
+
+    uint32_t wWakeups;
+    int64_t lSleepUS;
+} s_tHost;
+
+/*============================ IMPLEMENTATION ================================*/
+
+int64_t get_system_ticks(void)
+{
+    return s_tHost.lNow;
+}
+
+absolute_time_t get_absolute_time(void)
+{
+    return (absolute_time_t)s_tHost.lNow;
+}
+
+void busy_wait_us(uint64_t dwDelayUS)
+{
+    s_tHost.lNow += (int64_t)dwDelayUS;
+}
+
+int hardware_alarm_claim_unused(bool bRequired)
+{
+    ARM_2D_UNUSED(bRequired);
+    return 0;
+}
+
+void hardware_alarm_set_callback(uint nAlarm, hardware_alarm_callback_t fnCallback)
+{
+    ARM_2D_UNUSED(nAlarm);
+    s_tHost.fnAlarm = fnCallback;
+}
+
+bool hardware_alarm_set_target(uint nAlarm, absolute_time_t tTarget)
+{
+    ARM_2D_UNUSED(nAlarm);
+    if ((int64_t)tTarget <= s_tHost.lNow) {
+        return true;
+    }
+    s_tHost.bAlarmArmed = true;
+    s_tHost.lAlarm = (int64_t)tTarget;
+    return false;
+}
+
+void hardware_alarm_cancel(uint nAlarm)
+{
+    ARM_2D_UNUSED(nAlarm);
+    s_tHost.bAlarmArmed = false;
+}
+
+bool epd_screen_is_busy(void)
+{
+    return s_tHost.lNow < s_tHost.lBusyUntil;
+}
+
+/* the core sleeps until the next interrupt: the alarm or the BUSY edge */
+void __wfe(void)
+{
+    int64_t lNext = INT64_MAX;
+    if (s_tHost.bAlarmArmed) {
+        lNext = s_tHost.lAlarm;
+    }
+    if (s_tHost.bBusyEdgePending) {
+        lNext = MIN(lNext, s_tHost.lBusyUntil);
+    }
+    assert(INT64_MAX != lNext);                 /* nothing would wake us up */
+
+    if (lNext > s_tHost.lNow) {
+        s_tHost.lSleepUS += lNext - s_tHost.lNow;
+        s_tHost.lNow = lNext;
+    }
+    s_tHost.wWakeups++;
+
+    if (s_tHost.bBusyEdgePending && s_tHost.lNow >= s_tHost.lBusyUntil) {
+        s_tHost.bBusyEdgePending = false;
+        if (s_tHost.bBusyAsGenericEvent) {
+            idle_sleep_notify();
+        } else {
+            idle_sleep_notify_busy_released();
+        }
+    }
+    if (s_tHost.bAlarmArmed && s_tHost.lNow >= s_tHost.lAlarm) {
+        s_tHost.bAlarmArmed = false;
+        s_tHost.fnAlarm(0);
+    }
+}
+
+static void __host_refresh_panel(uint32_t wRefreshUS)
+{
+    s_tHost.lBusyUntil = s_tHost.lNow + wRefreshUS;
+    s_tHost.bBusyEdgePending = true;
+}
+
+/* the main loop of main.c, one frame per iteration */
+static host_result_t __host_run(const host_profile_t *ptProfile, 
+                                bool bBusyAsGenericEvent)
+{
+    memset(&s_tHost, 0, sizeof(s_tHost));
+    s_tHost.bBusyAsGenericEvent = bBusyAsGenericEvent;
+
+    idle_sleep_init();
+
+    host_result_t tResult = {0};
+    int64_t lEnd = perfc_convert_ms_to_ticks(HOST_SIMULATION_MS);
+
+    while (s_tHost.lNow < lEnd) {
+        /* fnOnFrameStart of the scene */
+        idle_sleep_next_frame_in_ms(ptProfile->wFramePeriodMS);
+
+        /* __lcd_sync_handler() before the first band */
+        while (epd_screen_is_busy()) {
+            int64_t lStart = s_tHost.lNow;
+            idle_sleep_wait_for_busy();
+            tResult.lBusyWaitUS += s_tHost.lNow - lStart;
+        }
+
+        s_tHost.lNow += ptProfile->wRenderUS;
+
+        /* epd_flush_if_changed() */
+        __host_refresh_panel(ptProfile->wRefreshUS);
+        tResult.wFrames++;
+
+        idle_sleep_wait();
+
+        tResult.lActiveUS += ptProfile->wRenderUS;
+    }
+
+    tResult.wWakeups = s_tHost.wWakeups;
+    tResult.lSleepUS = s_tHost.lSleepUS;
+    return tResult;
+}
+
+static uint32_t __host_average_current(const host_result_t *ptResult)
+{
+    int64_t lTotal = ptResult->lActiveUS + ptResult->lSleepUS;
+    int64_t lAwake = lTotal - ptResult->lSleepUS;
+
+    return (uint32_t)((  lAwake * HOST_ACTIVE_CURRENT_UA 
+                      +  ptResult->lSleepUS * HOST_WFE_CURRENT_UA) / lTotal);
+}
+
+static host_result_t __host_report(const host_profile_t *ptProfile, 
+                                   bool bBusyAsGenericEvent)
+{
+    host_result_t tResult = __host_run(ptProfile, bBusyAsGenericEvent);
+    int64_t lTotal = tResult.lActiveUS + tResult.lSleepUS;
+
+    printf( "%-10s BUSY as %-14s %5"PRIu32" frames, %6"PRIu32" wakeups, "
+            "asleep %3d%%, %5"PRIu32"uA on average\r\n",
+            ptProfile->pchName,
+            bBusyAsGenericEvent ? "generic event" : "BUSY event",
+            tResult.wFrames,
+            tResult.wWakeups,
+            (int)(tResult.lSleepUS * 100 / lTotal),
+            __host_average_current(&tResult));
+
+    return tResult;
+}
+
+int main(void)
+{
+    /* the mono clock: a frame per second, the panel refreshes in 300ms */
+    const host_profile_t c_tClock = {
+        .pchName = "clock",
+        .wFramePeriodMS = 1000,
+        .wRenderUS = 40000,
+        .wRefreshUS = 300000,
+    };
+
+    /* an animation that asks for frames faster than the panel refreshes */
+    const host_profile_t c_tAnimation = {
+        .pchName = "animation",
+        .wFramePeriodMS = 100,
+        .wRenderUS = 20000,
+        .wRefreshUS = 180000,
+    };
+
+    host_result_t tClock = __host_report(&c_tClock, false);
+    host_result_t tClockGeneric = __host_report(&c_tClock, true);
+    host_result_t tAnimation = __host_report(&c_tAnimation, false);
+    __host_report(&c_tAnimation, true);
+
+    /* the BUSY edge must not cut the sleep between two frames short */
+    HOST_CHECK(tClock.wFrames <= HOST_SIMULATION_MS / c_tClock.wFramePeriodMS + 1);
+    HOST_CHECK(tClock.wWakeups <= tClock.wFrames * 2);  /* alarm + BUSY edge */
+    HOST_CHECK(tClockGeneric.wFrames > tClock.wFrames);
+    HOST_CHECK(__host_average_current(&tClock) 
+            <  __host_average_current(&tClockGeneric));
+
+    /* the busy wait ends with the edge, one frame per refresh */
+    uint32_t wRefreshes = (uint32_t)(perfc_convert_ms_to_ticks(HOST_SIMULATION_MS) 
+                        / (c_tAnimation.wRenderUS + c_tAnimation.wRefreshUS));
+    HOST_CHECK(tAnimation.wFrames >= wRefreshes);
+    HOST_CHECK(tAnimation.wFrames <= wRefreshes + 1);
+    HOST_CHECK(tAnimation.lBusyWaitUS > 0);
+
+    if (s_nFailures) {
+        printf("%d check(s) failed\r\n", s_nFailures);
+        return 1;
+    }
+
+    printf("all checks passed\r\n");
+    return 0;
+}
@@ -0,0 +1,389 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*
+ * A host stress test of the scratch memory (platform/scratch_memory.c) with
+ * the scene arenas, the slab pools and the workspaces behind it. It replays a
+ * scratch memory trace, by default traces/playlist.trace, many times and
+ * checks that
+ *  - every block is aligned, does not overlap any live block and keeps its
+ *    content until it is freed
+ *  - the slabs, the arenas and the heap are empty after each pass, except the
+ *    workspaces kept by design
+ *  - the passes after the first one reach the heap no more often than it
+ *
+ * It prints where the requests are served, the peaks and the slab failures,
+ * which are the figures to size the pools and the arenas with.
+ *
+ * Build and run from the root of the repository:
+ *
+ *   gcc -std=gnu11 -Wall -Itests/host/shim -o /tmp/scratch_memory_trace_test \
+ *       tests/host/scratch_memory_trace_test.c platform/scratch_memory.c \
+ *       platform/scene_arena.c platform/slab_pool.c platform/scratch_workspace.c
+ *   /tmp/scratch_memory_trace_test [trace] [passes]
+ */
+/*============================ INCLUDES ======================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "arm_2d.h"
+
+#include "../../platform/platform.h"
+#include "../../platform/scene_arena.h"
+#include "../../platform/slab_pool.h"
+#include "../../platform/scratch_workspace.h"
+#include "../../platform/mem_watermark.h"
+
+/*============================ MACROS ========================================*/
+
+#define HOST_DEFAULT_TRACE              "tests/host/traces/playlist.trace"
+#define HOST_DEFAULT_PASSES             1000
+
+#define HOST_MAX_OPS                    16384
+#define HOST_MAX_LIVE                   256
+
+#define HOST_CHECK(__EXPR)                                                      \
+    do {                                                                        \
+        if (!(__EXPR)) {                                                        \
+            printf("FAILED: %s (line %d)\r\n", #__EXPR, __LINE__);             \
+            s_nFailures++;                                                      \
+        }                                                                       \
+    } while(0)
+
+/*============================ TYPES =========================================*/
+
+typedef struct {
+    char chOp;                                  //!< O, C, S, A or F
+    uint8_t chAlign;
+    uint8_t chType;
+    uint32_t wSize;
+    uint64_t dwID;                              //!< the pointer in the capture
+} host_op_t;
+
+typedef struct {
+    uint64_t dwID;
+    uint8_t *pchBuffer;
+    uint32_t wSize;
+    uint8_t chPattern;
+} host_block_t;
+
+typedef enum {
+    HOST_SOURCE_WORKSPACE,
+    HOST_SOURCE_SLAB,
+    HOST_SOURCE_ARENA,
+    HOST_SOURCE_HEAP,
+    HOST_SOURCE_FAILED,
+    __HOST_SOURCE_COUNT,
+} host_source_t;
+
+/*============================ LOCAL VARIABLES ===============================*/
+
+static int s_nFailures = 0;
+
+static host_op_t s_tOps[HOST_MAX_OPS];
+static uint32_t s_wOpCount;
+
+static host_block_t s_tLive[HOST_MAX_LIVE];
+static uint32_t s_wLiveCount;
+
+static struct {
+    uint32_t wCurrent;
+    uint32_t wPeak;
+    uint32_t wRequests;
+} s_tHeap;
+
+static const char *c_pchSources[__HOST_SOURCE_COUNT] = {
+    "workspace", "slab", "arena", "heap", "failed",
+};
+
+/*============================ IMPLEMENTATION ================================*/
+
+/* the heap of mem_watermark.c, which needs the linker symbols of the target */
+typedef union {
+    uint32_t wSize;
+    uint64_t dwAlign;
+} __host_heap_header_t;
+
+void *mem_watermark_heap_alloc(size_t tSize)
+{
+    __host_heap_header_t *ptHeader = malloc(sizeof(__host_heap_header_t) + tSize);
+    if (NULL == ptHeader) {
+        return NULL;
+    }
+    ptHeader->wSize = tSize;
+
+    s_tHeap.wCurrent += tSize;
+    s_tHeap.wPeak = MAX(s_tHeap.wPeak, s_tHeap.wCurrent);
+    s_tHeap.wRequests++;
+
+    return ptHeader + 1;
+}
+
+void mem_watermark_heap_free(void *pBuffer)
+{
+    if (NULL == pBuffer) {
+        return ;
+    }
+
+    __host_heap_header_t *ptHeader = (__host_heap_header_t *)pBuffer - 1;
+    assert(s_tHeap.wCurrent >= ptHeader->wSize);
+    s_tHeap.wCurrent -= ptHeader->wSize;
+
+    free(ptHeader);
+}
+
+static bool __host_load_trace(const char *pchPath)
+{
+    FILE *ptFile = fopen(pchPath, "r");
+    if (NULL == ptFile) {
+        printf("cannot open %s\r\n", pchPath);
+        return false;
+    }
+
+    char chLine[256];
+    while (NULL != fgets(chLine, sizeof(chLine), ptFile)) {
+        char *pchLine = chLine;
+
+        /* a capture from the board keeps its prefix */
+        if (0 == strncmp(pchLine, "[scratch] ", 10)) {
+            pchLine += 10;
+        }
+
+        host_op_t tOp = {.chOp = pchLine[0]};
+        unsigned nAlign = 0, nType = 0;
+
+        switch (tOp.chOp) {
+            case 'O':
+            case 'C':
+            case 'S':
+                break;
+            case 'A':
+                if (    4 != sscanf(pchLine + 1, "%"SCNx64" %"SCNu32" %u %u", 
+                                        &tOp.dwID, &tOp.wSize, &nAlign, &nType)
+                    ||  0 == tOp.dwID) {
+                    /* a failed request prints a NULL pointer, skip it */
+                    continue;
+                }
+                tOp.chAlign = nAlign;
+                tOp.chType = nType;
+                break;
+            case 'F':
+                if (1 != sscanf(pchLine + 1, "%"SCNx64, &tOp.dwID)) {
+                    continue;
+                }
+                break;
+            default:
+                /* comments and the other output of the board */
+                continue;
+        }
+
+        if (s_wOpCount >= HOST_MAX_OPS) {
+            printf("the trace is longer than %d operations\r\n", HOST_MAX_OPS);
+            fclose(ptFile);
+            return false;
+        }
+        s_tOps[s_wOpCount++] = tOp;
+    }
+
+    fclose(ptFile);
+    return true;
+}
+
+static uint32_t __host_slab_blocks_in_use(void)
+{
+    uint32_t wBlocks = 0;
+    for (uint_fast8_t n = 0; n < SLAB_POOL_CLASS_COUNT; n++) {
+        slab_pool_class_info_t tInfo;
+        slab_pool_get_info(n, &tInfo);
+        wBlocks += tInfo.hwCurrent;
+    }
+    return wBlocks;
+}
+
+static uint32_t __host_arena_fallbacks(void)
+{
+    scene_arena_info_t tCurrent, tNext;
+    scene_arena_get_info(&tCurrent, SCENE_ARENA_CURRENT);
+    scene_arena_get_info(&tNext, SCENE_ARENA_NEXT);
+    return tCurrent.wFallbacks + tNext.wFallbacks;
+}
+
+static host_source_t __host_allocate(const host_op_t *ptOp)
+{
+    uint32_t wSlabBlocks = __host_slab_blocks_in_use();
+    uint32_t wHeapRequests = s_tHeap.wRequests;
+    uint32_t wFallbacks = __host_arena_fallbacks();
+
+    uint8_t *pchBuffer = __arm_2d_allocate_scratch_memory(  ptOp->wSize, 
+                                                            ptOp->chAlign, 
+                                                            ptOp->chType);
+    if (NULL == pchBuffer) {
+        return HOST_SOURCE_FAILED;
+    }
+
+    HOST_CHECK(0 == ((uintptr_t)pchBuffer & (MAX(ptOp->chAlign, 1) - 1)));
+
+    for (uint32_t n = 0; n < s_wLiveCount; n++) {
+        host_block_t *ptBlock = &s_tLive[n];
+        bool bOverlapped = pchBuffer < ptBlock->pchBuffer + ptBlock->wSize
+                        && ptBlock->pchBuffer < pchBuffer + ptOp->wSize;
+        HOST_CHECK(!bOverlapped);
+        HOST_CHECK(ptBlock->dwID != ptOp->dwID);
+    }
+
+    assert(s_wLiveCount < HOST_MAX_LIVE);
+    host_block_t *ptBlock = &s_tLive[s_wLiveCount++];
+    *ptBlock = (host_block_t) {
+        .dwID = ptOp->dwID,
+        .pchBuffer = pchBuffer,
+        .wSize = ptOp->wSize,
+        .chPattern = (uint8_t)(ptOp->dwID ^ (ptOp->dwID >> 8) ^ s_wLiveCount),
+    };
+    memset(pchBuffer, ptBlock->chPattern, ptOp->wSize);
+
+    if (__host_slab_blocks_in_use() != wSlabBlocks) {
+        return HOST_SOURCE_SLAB;
+    } else if (s_tHeap.wRequests != wHeapRequests) {
+        /* a new workspace comes from the heap as well */
+        return  (ARM_2D_MEM_TYPE_FAST == ptOp->chType 
+             &&  __host_arena_fallbacks() == wFallbacks)
+             ?  HOST_SOURCE_WORKSPACE
+             :  HOST_SOURCE_HEAP;
+    } else if (ARM_2D_MEM_TYPE_FAST == ptOp->chType) {
+        return HOST_SOURCE_WORKSPACE;
+    }
+    return HOST_SOURCE_ARENA;
+}
+
+static void __host_free(const host_op_t *ptOp)
+{
+    for (uint32_t n = 0; n < s_wLiveCount; n++) {
+        host_block_t *ptBlock = &s_tLive[n];
+        if (ptBlock->dwID != ptOp->dwID) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < ptBlock->wSize; i++) {
+            if (ptBlock->pchBuffer[i] != ptBlock->chPattern) {
+                printf("FAILED: block %"PRIx64" is overwritten\r\n", ptBlock->dwID);
+                s_nFailures++;
+                break;
+            }
+        }
+
+        __arm_2d_free_scratch_memory(ARM_2D_MEM_TYPE_UNSPECIFIED, ptBlock->pchBuffer);
+        *ptBlock = s_tLive[--s_wLiveCount];
+        return ;
+    }
+
+    /* e.g. a capture started after the allocation */
+    printf("warning: release of an unknown block %"PRIx64"\r\n", ptOp->dwID);
+}
+
+static void __host_replay(uint32_t wSources[__HOST_SOURCE_COUNT])
+{
+    for (uint32_t n = 0; n < s_wOpCount; n++) {
+        const host_op_t *ptOp = &s_tOps[n];
+
+        switch (ptOp->chOp) {
+            case 'O':
+                scene_arena_open_next();
+                break;
+            case 'C':
+                scene_arena_close_next();
+                break;
+            case 'S':
+                scene_arena_switch_to_next();
+                break;
+            case 'A':
+                wSources[__host_allocate(ptOp)]++;
+                break;
+            case 'F':
+                __host_free(ptOp);
+                break;
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pchPath = (argc > 1) ? argv[1] : HOST_DEFAULT_TRACE;
+    uint32_t wPasses = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) 
+                                  : HOST_DEFAULT_PASSES;
+
+    if (!__host_load_trace(pchPath) || 0 == wPasses) {
+        return 1;
+    }
+
+    slab_pool_init();
+
+    uint32_t wFirstPass[__HOST_SOURCE_COUNT] = {0};
+    uint32_t wSteady[__HOST_SOURCE_COUNT] = {0};
+    uint32_t wWorkspaceHeap = 0;
+    uint32_t wArenaPeak = 0;
+
+    for (uint32_t wPass = 0; wPass < wPasses; wPass++) {
+        uint32_t wSources[__HOST_SOURCE_COUNT] = {0};
+
+        __host_replay(wSources);
+
+        if (0 == wPass) {
+            memcpy(wFirstPass, wSources, sizeof(wSources));
+            wWorkspaceHeap = s_tHeap.wCurrent;
+        } else {
+            for (uint_fast8_t n = 0; n < __HOST_SOURCE_COUNT; n++) {
+                wSteady[n] = MAX(wSteady[n], wSources[n]);
+            }
+        }
+
+        scene_arena_info_t tCurrent, tNext;
+        scene_arena_get_info(&tCurrent, SCENE_ARENA_CURRENT);
+        scene_arena_get_info(&tNext, SCENE_ARENA_NEXT);
+        wArenaPeak = MAX(wArenaPeak, MAX(tCurrent.wPeak, tNext.wPeak));
+
+        /* a pass ends with the last scene deposed */
+        if (0 == s_wLiveCount) {
+            HOST_CHECK(0 == __host_slab_blocks_in_use());
+            HOST_CHECK(s_tHeap.wCurrent == wWorkspaceHeap);
+        }
+    }
+
+    printf("%s, %"PRIu32" passes of %"PRIu32" operations\r\n", 
+            pchPath, wPasses, s_wOpCount);
+    printf("%-10s %10s %10s\r\n", "served by", "1st pass", "later");
+    for (uint_fast8_t n = 0; n < __HOST_SOURCE_COUNT; n++) {
+        printf( "%-10s %10"PRIu32" %10"PRIu32"\r\n", 
+                c_pchSources[n], wFirstPass[n], wSteady[n]);
+    }
+    printf( "arena peak %"PRIu32"/%d bytes, heap peak %"PRIu32" bytes\r\n",
+            wArenaPeak, __PLATFORM_CFG_SCENE_ARENA_SIZE__, s_tHeap.wPeak);
+    slab_pool_dump_info();
+
+    HOST_CHECK(0 == wFirstPass[HOST_SOURCE_FAILED]);
+    HOST_CHECK(wSteady[HOST_SOURCE_HEAP] <= wFirstPass[HOST_SOURCE_HEAP]);
+    HOST_CHECK(0 == wSteady[HOST_SOURCE_WORKSPACE] 
+            || wSteady[HOST_SOURCE_WORKSPACE] <= wFirstPass[HOST_SOURCE_WORKSPACE]);
+
+    if (s_nFailures) {
+        printf("%d check(s) failed\r\n", s_nFailures);
+        return 1;
+    }
+
+    printf("all checks passed\r\n");
+    return 0;
+}
@@ -0,0 +1,74 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/* the subset of arm_2d.h used by the platform code, for host tests */
+#ifndef __HOST_SHIM_ARM_2D_H__
+#define __HOST_SHIM_ARM_2D_H__
+
+/*============================ INCLUDES ======================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*============================ MACROS ========================================*/
+
+#define ARM_2D_UNUSED(__VAR)            (void)(__VAR)
+
+#ifndef MIN
+#   define MIN(__A, __B)                ((__A) < (__B) ? (__A) : (__B))
+#endif
+#ifndef MAX
+#   define MAX(__A, __B)                ((__A) > (__B) ? (__A) : (__B))
+#endif
+
+#ifndef __ALIGNED
+#   define __ALIGNED(__N)               __attribute__((aligned(__N)))
+#endif
+
+#ifndef dimof
+#   define dimof(__ARRAY)               (sizeof(__ARRAY) / sizeof(__ARRAY[0]))
+#endif
+
+#define ARM_NONNULL(...)                __attribute__((nonnull(__VA_ARGS__)))
+
+/* the host tests are single threaded */
+#define __IRQ_SAFE                      for (int __nOnce = 1; __nOnce; __nOnce = 0)
+
+#define arm_foreach(__TYPE, __ARRAY, __PTR)                                     \
+            for (__TYPE *__PTR = (__ARRAY);                                     \
+                 __PTR < (__ARRAY) + dimof(__ARRAY);                            \
+                 __PTR++)
+
+/*============================ TYPES =========================================*/
+
+typedef enum {
+    ARM_2D_MEM_TYPE_UNSPECIFIED,
+    ARM_2D_MEM_TYPE_SLOW,
+    ARM_2D_MEM_TYPE_FAST,
+} arm_2d_mem_type_t;
+
+/*============================ PROTOTYPES ====================================*/
+
+extern
+void * __arm_2d_allocate_scratch_memory(uint32_t wSize,
+                                        uint_fast8_t nAlign,
+                                        arm_2d_mem_type_t tType);
+
+extern
+void __arm_2d_free_scratch_memory(  arm_2d_mem_type_t tType,
+                                    void *pBuff);
+
+#endif
@@ -0,0 +1,61 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/* the events and spinlocks of RP2040, for host tests */
+#ifndef __HOST_SHIM_HARDWARE_SYNC_H__
+#define __HOST_SHIM_HARDWARE_SYNC_H__
+
+/*============================ INCLUDES ======================================*/
+#include "pico/stdlib.h"
+
+/*============================ TYPES =========================================*/
+
+typedef volatile uint32_t spin_lock_t;
+
+/*============================ PROTOTYPES ====================================*/
+
+/* __wfe() is provided by the test, it is where the virtual clock moves on */
+extern void __wfe(void);
+
+static inline void __sev(void) {}
+
+static inline int spin_lock_claim_unused(bool bRequired)
+{
+    (void)bRequired;
+    return 0;
+}
+
+static inline spin_lock_t *spin_lock_init(uint nLock)
+{
+    static spin_lock_t s_tLocks[32];
+    return &s_tLocks[nLock];
+}
+
+static inline uint32_t spin_lock_blocking(spin_lock_t *ptLock)
+{
+    assert(0 == *ptLock);
+    *ptLock = 1;
+    return 0;
+}
+
+static inline void spin_unlock(spin_lock_t *ptLock, uint32_t wSave)
+{
+    (void)wSave;
+    assert(1 == *ptLock);
+    *ptLock = 0;
+}
+
+#endif
@@ -0,0 +1,37 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/* the hardware alarms of RP2040, for host tests */
+#ifndef __HOST_SHIM_HARDWARE_TIMER_H__
+#define __HOST_SHIM_HARDWARE_TIMER_H__
+
+/*============================ INCLUDES ======================================*/
+#include "pico/stdlib.h"
+
+/*============================ TYPES =========================================*/
+
+typedef void (*hardware_alarm_callback_t)(uint nAlarm);
+
+/*============================ PROTOTYPES ====================================*/
+
+/* provided by the test */
+extern int hardware_alarm_claim_unused(bool bRequired);
+extern void hardware_alarm_set_callback(uint nAlarm, 
+                                        hardware_alarm_callback_t fnCallback);
+extern bool hardware_alarm_set_target(uint nAlarm, absolute_time_t tTarget);
+extern void hardware_alarm_cancel(uint nAlarm);
+
+#endif
@@ -0,0 +1,46 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/* the subset of perf_counter used by the platform code, for host tests.
+ * One tick is one microsecond.
+ */
+#ifndef __HOST_SHIM_PERF_COUNTER_H__
+#define __HOST_SHIM_PERF_COUNTER_H__
+
+/*============================ INCLUDES ======================================*/
+#include <stdint.h>
+
+/*============================ PROTOTYPES ====================================*/
+
+/* provided by the test, usually a virtual clock */
+extern int64_t get_system_ticks(void);
+
+static inline int64_t perfc_convert_ms_to_ticks(uint32_t wMS)
+{
+    return (int64_t)wMS * 1000;
+}
+
+static inline int64_t perfc_convert_ticks_to_ms(int64_t lTicks)
+{
+    return lTicks / 1000;
+}
+
+static inline int64_t perfc_convert_ticks_to_us(int64_t lTicks)
+{
+    return lTicks;
+}
+
+#endif
@@ -0,0 +1,52 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/* the subset of pico/stdlib.h used by the platform code, for host tests */
+#ifndef __HOST_SHIM_PICO_STDLIB_H__
+#define __HOST_SHIM_PICO_STDLIB_H__
+
+/*============================ INCLUDES ======================================*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+/*============================ MACROS ========================================*/
+
+#define __time_critical_func(__FUNC)    __FUNC
+
+/*============================ TYPES =========================================*/
+
+typedef unsigned int uint;
+
+/* in us, like the timer of RP2040 */
+typedef uint64_t absolute_time_t;
+
+/*============================ PROTOTYPES ====================================*/
+
+/* provided by the test, usually on top of a virtual clock */
+extern absolute_time_t get_absolute_time(void);
+extern void busy_wait_us(uint64_t dwDelayUS);
+
+static inline absolute_time_t delayed_by_us(absolute_time_t tTime, 
+                                            uint64_t dwDelayUS)
+{
+    return tTime + dwDelayUS;
+}
+
+#endif
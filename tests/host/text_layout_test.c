@@ -0,0 +1,362 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*
+ * A host test of platform/text_layout.c on the document packed by
+ * tools/text_pack.py. The text reader hands the text box windows that start
+ * and end at the lines of the index, so both must break the text at the same
+ * places. The text box lives in the Arm-2D pack and does not run on the host,
+ * hence the lines are compared with a reference that follows the rule of the
+ * text box instead:
+ *  - characters are added until the next one overflows the box, then the
+ *    line goes back to the last space; the spaces at the break are dropped
+ *  - a line without a space is broken at the character that overflows
+ *  - a '\n' ends the line, a '\r' is skipped
+ * The JUSTIFIED alignment only spreads the spare pixels of a finished line
+ * over its spaces, so it never moves a break.
+ *
+ * It checks the offsets and the widths of all lines, for the box of the
+ * text reader and for narrower ones, with the text in memory and read
+ * through fnRead, and with a sparse index.
+ *
+ * Build and run from the root of the repository:
+ *
+ *   python3 tools/text_pack.py tests/host/texts/story.txt -o /tmp/story.bin
+ *   gcc -std=gnu11 -Wall -Itests/host/shim -o /tmp/text_layout_test \
+ *       tests/host/text_layout_test.c platform/text_layout.c
+ *   /tmp/text_layout_test /tmp/story.bin
+ */
+/*============================ INCLUDES ======================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "perf_counter.h"
+#include "arm_2d.h"
+
+#include "../../platform/platform.h"
+#include "../../platform/text_layout.h"
+
+/*============================ MACROS ========================================*/
+
+/* keep in sync with BLOB_MAGIC in tools/text_pack.py */
+#define HOST_TEXT_MAGIC             0x31585442
+
+#define HOST_MAX_LINES              4096
+
+/* the text reader: a 296 pixel wide screen and a margin of 8 pixels */
+#define HOST_READER_BOX_WIDTH       (296 - 16)
+#define HOST_READER_CHAR_SPACING    1
+
+#define HOST_CHECK(__EXPR)                                                      \
+    do {                                                                        \
+        if (!(__EXPR)) {                                                        \
+            printf("FAILED: %s (line %d)\r\n", #__EXPR, __LINE__);             \
+            s_nFailures++;                                                      \
+        }                                                                       \
+    } while(0)
+
+/*============================ TYPES =========================================*/
+/*============================ LOCAL VARIABLES ===============================*/
+
+static int s_nFailures = 0;
+
+/* the advances of LiberationSansRegular14 in pixels, from ' ' to '~', i.e.
+ * the metrics of the font in 2048 units scaled to 14 pixels. The bitmap font
+ * might differ by a pixel here and there, which does not matter as both
+ * sides use the same table.
+ */
+static const int8_t c_chAdvances[] = {
+/*       !  "  #  $  %   &  '  (  )  *  +  ,  -  .  /  */
+    4,  4, 5, 8, 8, 12, 9, 3, 5, 5, 5, 8, 4, 5, 4, 4,
+/*  0  1  2  3  4  5  6  7  8  9  :  ;  <  =  >  ?  */
+    8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 4, 4, 8, 8, 8, 8,
+/*  @   A  B   C   D   E  F  G   H   I  J  K  L  M   N   O   */
+    14, 9, 9, 10, 10, 9, 9, 11, 10, 4, 7, 9, 8, 12, 10, 11,
+/*  P  Q   R   S  T  U   V  W   X  Y  Z  [  \  ]  ^  _  */
+    9, 11, 10, 9, 9, 10, 9, 13, 9, 9, 9, 4, 4, 4, 7, 8,
+/*  `  a  b  c  d  e  f  g  h  i  j  k  l  m   n  o  */
+    5, 8, 8, 7, 8, 8, 4, 8, 8, 3, 3, 7, 3, 12, 8, 8,
+/*  p  q  r  s  t  u  v  w   x  y  z  {  |  }  ~  */
+    8, 8, 5, 7, 4, 8, 7, 10, 7, 7, 7, 5, 4, 5, 8,
+};
+
+static const char *s_pchText = NULL;
+static size_t s_tTextSize = 0;
+static uint32_t s_wReads = 0;
+
+static text_layout_line_t s_tLines[HOST_MAX_LINES];
+
+/*============================ IMPLEMENTATION ================================*/
+
+int64_t get_system_ticks(void)
+{
+    return 0;
+}
+
+static int16_t __host_get_advance(  void *pTarget,
+                                    const char *pchChar,
+                                    uint_fast8_t chLength)
+{
+    ARM_2D_UNUSED(pTarget);
+    uint8_t chCode = (uint8_t)*pchChar;
+
+    if (    (1 == chLength)
+        &&  (chCode >= TEXT_LAYOUT_ASCII_FIRST)
+        &&  (chCode <= TEXT_LAYOUT_ASCII_LAST)) {
+        return c_chAdvances[chCode - TEXT_LAYOUT_ASCII_FIRST];
+    }
+
+    /* a CJK glyph is as wide as the font is high */
+    return 14;
+}
+
+static uint16_t __host_read(void *pSource,
+                            uint32_t wOffset,
+                            uint8_t *pchBuffer,
+                            uint16_t hwSize)
+{
+    ARM_2D_UNUSED(pSource);
+
+    s_wReads++;
+    hwSize = (uint16_t)MIN(hwSize, s_tTextSize - wOffset);
+    memcpy(pchBuffer, s_pchText + wOffset, hwSize);
+
+    return hwSize;
+}
+
+static uint_fast8_t __host_utf8_length(uint8_t chLead)
+{
+    if ((chLead & 0xE0) == 0xC0) {
+        return 2;
+    } else if ((chLead & 0xF0) == 0xE0) {
+        return 3;
+    } else if ((chLead & 0xF8) == 0xF0) {
+        return 4;
+    }
+    return 1;
+}
+
+/*
+ * the reference: measure the line starting at tStart the way the text box
+ * does, return where the next line starts
+ */
+static size_t __host_ref_line(  size_t tStart,
+                                int16_t iBoxWidth,
+                                int16_t iCharSpacing,
+                                int16_t *piWidth)
+{
+    int16_t iX = 0;
+    int16_t iLineWidth = 0;                     //!< the width without the trailing spaces
+    size_t tBreak = 0;                          //!< where the line continues after the last space
+    int16_t iBreakWidth = 0;
+    size_t tOffset = tStart;
+
+    while (tOffset < s_tTextSize && '\0' != s_pchText[tOffset]) {
+        char chChar = s_pchText[tOffset];
+
+        if ('\n' == chChar) {
+            *piWidth = iLineWidth;
+            return tOffset + 1;
+        } else if ('\r' == chChar) {
+            tOffset++;
+            continue;
+        } else if (' ' == chChar || '\t' == chChar) {
+            iX += __host_get_advance(NULL, " ", 1) + iCharSpacing;
+            tOffset++;
+            if (iLineWidth > 0) {
+                tBreak = tOffset;
+                iBreakWidth = iLineWidth;
+            }
+            continue;
+        }
+
+        uint_fast8_t chLength = __host_utf8_length((uint8_t)chChar);
+        chLength = MIN(chLength, s_tTextSize - tOffset);
+        int16_t iAdvance = __host_get_advance(  NULL,
+                                                &s_pchText[tOffset],
+                                                chLength)
+                         + iCharSpacing;
+
+        if (iLineWidth > 0 && iX + iAdvance > iBoxWidth) {
+            if (tBreak > 0) {
+                /* back to the last space */
+                *piWidth = iBreakWidth;
+                return tBreak;
+            }
+            /* a word wider than the box */
+            *piWidth = iLineWidth;
+            return tOffset;
+        }
+
+        iX += iAdvance;
+        iLineWidth = iX;
+        tOffset += chLength;
+    }
+
+    *piWidth = iLineWidth;
+    return tOffset;
+}
+
+static void __host_compare(int16_t iBoxWidth, bool bUseRead, uint16_t hwMaxLines)
+{
+    static text_layout_t s_tLayout;
+
+    text_layout_cfg_t tCFG = {
+        .pchText = bUseRead ? NULL : s_pchText,
+        .tSize = s_tTextSize,
+        .fnRead = bUseRead ? &__host_read : NULL,
+
+        .fnGetAdvance = &__host_get_advance,
+        .iBoxWidth = iBoxWidth,
+        .iCharSpacing = HOST_READER_CHAR_SPACING,
+
+        .ptLines = s_tLines,
+        .hwMaxLines = hwMaxLines,
+    };
+
+    text_layout_init(&s_tLayout, &tCFG);
+
+    /* in small steps, as the text reader does after each frame */
+    while (!text_layout_build(&s_tLayout, 64));
+    HOST_CHECK(s_tLayout.bComplete);
+
+    uint32_t wLineCount = text_layout_get_line_count(&s_tLayout);
+    uint32_t wMismatches = 0;
+    size_t tOffset = 0;
+    uint32_t wLine = 0;
+
+    do {
+        int16_t iWidth = 0;
+        size_t tNext = __host_ref_line(tOffset,
+                                       iBoxWidth,
+                                       HOST_READER_CHAR_SPACING,
+                                       &iWidth);
+
+        if (wLine >= wLineCount) {
+            wMismatches++;
+            break;
+        }
+
+        if ((int32_t)tOffset != text_layout_get_line_offset(&s_tLayout, wLine)) {
+            if (0 == wMismatches) {
+                printf( "box %d: line %"PRIu32" starts at %d instead of %zu\r\n",
+                        iBoxWidth,
+                        wLine,
+                        (int)text_layout_get_line_offset(&s_tLayout, wLine),
+                        tOffset);
+            }
+            wMismatches++;
+        }
+
+        /* the widths are only kept by a dense index */
+        const text_layout_line_t *ptLine = text_layout_get_line(&s_tLayout, wLine);
+        if (NULL != ptLine && ptLine->iWidth != iWidth) {
+            if (0 == wMismatches) {
+                printf( "box %d: line %"PRIu32" is %d pixels instead of %d\r\n",
+                        iBoxWidth, wLine, ptLine->iWidth, iWidth);
+            }
+            wMismatches++;
+        }
+        HOST_CHECK(iWidth <= iBoxWidth || NULL == ptLine || 1 == ptLine->hwGlyphs);
+
+        tOffset = tNext;
+        wLine++;
+    } while (tOffset < s_tTextSize && '\0' != s_pchText[tOffset]);
+
+    HOST_CHECK(0 == wMismatches);
+    HOST_CHECK(wLine == wLineCount);
+
+    /* the end of the last window */
+    HOST_CHECK((int32_t)tOffset == text_layout_get_line_offset(&s_tLayout, wLineCount));
+
+    printf( "box %3d pixels, %-6s %4"PRIu32" lines, stride %d\r\n",
+            iBoxWidth,
+            bUseRead ? "read," : "memory,",
+            wLineCount,
+            1 << s_tLayout.tCFG.chStrideShift);
+}
+
+static bool __host_load(const char *pchPath)
+{
+    FILE *ptFile = fopen(pchPath, "rb");
+    if (NULL == ptFile) {
+        printf("cannot open %s\r\n", pchPath);
+        return false;
+    }
+
+    uint32_t wHeader[2] = {0};
+    bool bResult = false;
+
+    do {
+        if (    (1 != fread(wHeader, sizeof(wHeader), 1, ptFile))
+            ||  (HOST_TEXT_MAGIC != wHeader[0])) {
+            printf("%s is not a document packed by tools/text_pack.py\r\n", pchPath);
+            break;
+        }
+
+        char *pchText = malloc(wHeader[1]);
+        if (    (NULL == pchText)
+            ||  (wHeader[1] != fread(pchText, 1, wHeader[1], ptFile))) {
+            printf("%s is truncated\r\n", pchPath);
+            free(pchText);
+            break;
+        }
+
+        s_pchText = pchText;
+        s_tTextSize = wHeader[1];
+        bResult = true;
+    } while(0);
+
+    fclose(ptFile);
+    return bResult;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        printf("usage: %s <document packed by tools/text_pack.py>\r\n", argv[0]);
+        return 1;
+    }
+    if (!__host_load(argv[1])) {
+        return 1;
+    }
+
+    /* the box of the text reader, and narrower ones until nearly every long
+     * word is broken at the characters
+     */
+    static const int16_t c_iBoxWidths[] = {
+        HOST_READER_BOX_WIDTH, 200, 120, 64, 24,
+    };
+
+    for (uint_fast8_t n = 0; n < dimof(c_iBoxWidths); n++) {
+        __host_compare(c_iBoxWidths[n], false, HOST_MAX_LINES);
+        __host_compare(c_iBoxWidths[n], true, HOST_MAX_LINES);
+
+        /* a sparse index finds the lines in between by rescanning */
+        __host_compare(c_iBoxWidths[n], false, 16);
+    }
+    HOST_CHECK(s_wReads > 0);
+
+    if (s_nFailures) {
+        printf("%d check(s) failed\r\n", s_nFailures);
+        return 1;
+    }
+
+    printf("all checks passed\r\n");
+    return 0;
+}
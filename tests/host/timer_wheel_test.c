@@ -0,0 +1,254 @@
+/****************************************************************************
+*  Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)       *
+*                                                                           *
+*  Licensed under the Apache License, Version 2.0 (the "License");          *
+*  you may not use this file except in compliance with the License.         *
+*  You may obtain a copy of the License at                                  *
+*                                                                           *
+*     http://www.apache.org/licenses/LICENSE-2.0                            *
+*                                                                           *
+*  Unless required by applicable law or agreed to in writing, software      *
+*  distributed under the License is distributed on an "AS IS" BASIS,        *
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+*  See the License for the specific language governing permissions and      *
+*  limitations under the License.                                           *
+*                                                                           *
+****************************************************************************/
+/*
+ * A host test of platform/timer_wheel.c on a virtual ms clock. It checks
+ *  - the 1ms resolution: every timer fires at exactly the ms it expires,
+ *    whether the wheel is advanced ms by ms or in large jumps
+ *  - the cascades: delays around the slot boundaries of every level, and
+ *    timers beyond the range of the wheel, which are parked and re-inserted
+ *  - the restart from a handler: a handler that restarts its own timer
+ *    through system_timer_start(), i.e. with an advance inside the tick, sees
+ *    every expiry in order and the restarted delay counts from its expiry
+ *
+ * Build and run from the root of the repository:
+ *
+ *   gcc -std=gnu11 -Wall -Itests/host/shim -o /tmp/timer_wheel_test \
+ *       tests/host/timer_wheel_test.c platform/timer_wheel.c
+ *   /tmp/timer_wheel_test
+ */
+/*============================ INCLUDES ======================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "perf_counter.h"
+#include "arm_2d.h"
+
+#include "../../platform/platform.h"
+#include "../../platform/timer_wheel.h"
+
+/*============================ MACROS ========================================*/
+
+#define HOST_TIMER_COUNT                64
+
+#define HOST_CHECK(__EXPR)                                                      \
+    do {                                                                        \
+        if (!(__EXPR)) {                                                        \
+            printf("FAILED: %s (line %d)\r\n", #__EXPR, __LINE__);             \
+            s_nFailures++;                                                      \
+        }                                                                       \
+    } while(0)
+
+/*============================ TYPES =========================================*/
+
+typedef struct {
+    timer_wheel_timer_t tTimer;
+    timer_wheel_t *ptWheel;
+    uint32_t wExpected;                         //!< the next expiry in ms
+    uint32_t wPeriod;
+    uint32_t wFired;
+    uint32_t wLate;                             //!< the expiries on a wrong ms
+} host_timer_t;
+
+/*============================ LOCAL VARIABLES ===============================*/
+
+static int s_nFailures = 0;
+
+static int64_t s_lNowUS = 0;
+
+/* the delays around the slot boundaries of every level, in ms */
+static const uint32_t c_wDelays[] = {
+    1, 2, 63, 64, 65, 127, 128, 129,
+    4095, 4096, 4097, 4159, 4160, 8191, 8192, 8193,
+    262143, 262144, 262145,             /* beyond the wheel, parked */
+    300000,
+};
+
+/*============================ IMPLEMENTATION ================================*/
+
+int64_t get_system_ticks(void)
+{
+    return s_lNowUS;
+}
+
+static void __host_on_timer(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    host_timer_t *ptThis = (host_timer_t *)pTarget;
+    ARM_2D_UNUSED(ptTimer);
+
+    if (ptThis->ptWheel->wNow != ptThis->wExpected) {
+        ptThis->wLate++;
+    }
+    ptThis->wFired++;
+    ptThis->wExpected += ptThis->wPeriod;
+}
+
+/* wStep == 0 means jumping from one expiry to the next with
+ * timer_wheel_get_time_to_next(), as the main loop sleeps
+ */
+static void __host_run(uint32_t wStart, uint32_t wPeriod, uint32_t wStep)
+{
+    static host_timer_t s_tTimers[dimof(c_wDelays)];
+    timer_wheel_t tWheel;
+    uint32_t wEnd = wStart + 330000;
+
+    timer_wheel_init(&tWheel, wStart);
+    memset(s_tTimers, 0, sizeof(s_tTimers));
+
+    for (uint_fast8_t n = 0; n < dimof(c_wDelays); n++) {
+        host_timer_t *ptTimer = &s_tTimers[n];
+        ptTimer->ptWheel = &tWheel;
+        ptTimer->wExpected = wStart + c_wDelays[n];
+        ptTimer->wPeriod = wPeriod ? c_wDelays[n] : 0;
+        timer_wheel_start(  &tWheel, &ptTimer->tTimer, c_wDelays[n], 
+                            ptTimer->wPeriod, &__host_on_timer, ptTimer);
+    }
+
+    uint32_t wNow = wStart;
+    while ((int32_t)(wEnd - wNow) > 0) {
+        if (wStep) {
+            wNow += wStep;
+        } else {
+            uint32_t wNext = timer_wheel_get_time_to_next(&tWheel);
+            if (TIMER_WHEEL_NO_TIMER == wNext) {
+                break;
+            }
+            wNow += wNext;
+        }
+        timer_wheel_advance(&tWheel, wNow);
+    }
+    timer_wheel_advance(&tWheel, wEnd);
+
+    for (uint_fast8_t n = 0; n < dimof(c_wDelays); n++) {
+        host_timer_t *ptTimer = &s_tTimers[n];
+        uint32_t wExpected = wPeriod 
+                           ? (wEnd - wStart) / c_wDelays[n] 
+                           : (c_wDelays[n] <= (wEnd - wStart));
+
+        if (ptTimer->wLate || ptTimer->wFired != wExpected) {
+            printf( "start %08"PRIx32" step %4"PRIu32" delay %7"PRIu32": "
+                    "%"PRIu32" fired, %"PRIu32" expected, %"PRIu32" late\r\n",
+                    wStart, wStep, c_wDelays[n], 
+                    ptTimer->wFired, wExpected, ptTimer->wLate);
+            s_nFailures++;
+        }
+    }
+
+    HOST_CHECK(tWheel.hwCount == (wPeriod ? dimof(c_wDelays) : 0));
+}
+
+/*----------------------------------------------------------------------------*
+ * Restart from a handler                                                     *
+ *----------------------------------------------------------------------------*/
+
+static timer_wheel_timer_t s_tChainTimer;
+static timer_wheel_timer_t s_tMarkTimer;
+static uint32_t s_wLog[HOST_TIMER_COUNT];
+static uint_fast8_t s_chLogCount;
+
+static void __host_log(uint32_t wID)
+{
+    if (s_chLogCount < dimof(s_wLog)) {
+        s_wLog[s_chLogCount] = wID;
+    }
+    s_chLogCount++;
+}
+
+static void __host_on_chain(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    uint32_t *pwCount = (uint32_t *)pTarget;
+
+    __host_log(1);
+
+    /* restart a one-shot timer, the system timer advances the wheel first */
+    if (++(*pwCount) < 10) {
+        system_timer_start(ptTimer, 10, 0, &__host_on_chain, pTarget);
+    }
+}
+
+static void __host_on_mark(void *pTarget, timer_wheel_timer_t *ptTimer)
+{
+    ARM_2D_UNUSED(pTarget);
+    ARM_2D_UNUSED(ptTimer);
+
+    __host_log(2);
+}
+
+static void __host_test_restart_in_handler(void)
+{
+    uint32_t wCount = 0;
+
+    s_lNowUS = perfc_convert_ms_to_ticks(5000);
+    system_timer_init();
+
+    /* the chain fires at 10, 20, ... 100ms and the mark at 55ms */
+    system_timer_start(&s_tChainTimer, 10, 0, &__host_on_chain, &wCount);
+    system_timer_start(&s_tMarkTimer, 55, 0, &__host_on_mark, NULL);
+
+    /* the main loop oversleeps, all expiries are handled in one advance */
+    s_lNowUS += perfc_convert_ms_to_ticks(200);
+    int64_t lNext = system_timer_task();
+
+    static const uint32_t c_wExpected[] = {1, 1, 1, 1, 1, 2, 1, 1, 1, 1, 1};
+
+    HOST_CHECK(wCount == 10);
+    HOST_CHECK(s_chLogCount == dimof(c_wExpected));
+    HOST_CHECK(0 == memcmp(s_wLog, c_wExpected, sizeof(c_wExpected)));
+    HOST_CHECK(!timer_wheel_is_active(&s_tChainTimer));
+    HOST_CHECK(INT64_MAX == lNext);
+
+    /* outside the handlers, the delay counts from now */
+    system_timer_start(&s_tMarkTimer, 10, 0, &__host_on_mark, NULL);
+    s_lNowUS += perfc_convert_ms_to_ticks(9);
+    system_timer_task();
+    HOST_CHECK(timer_wheel_is_active(&s_tMarkTimer));
+    s_lNowUS += perfc_convert_ms_to_ticks(1);
+    system_timer_task();
+    HOST_CHECK(!timer_wheel_is_active(&s_tMarkTimer));
+}
+
+int main(void)
+{
+    /* a start close to the wrap-around of the ms clock as well */
+    static const uint32_t c_wStarts[] = {0, 12345, UINT32_MAX - 200000};
+    static const uint32_t c_wSteps[] = {1, 7, 64, 1000, 0};
+
+    for (uint_fast8_t s = 0; s < dimof(c_wStarts); s++) {
+        for (uint_fast8_t n = 0; n < dimof(c_wSteps); n++) {
+            __host_run(c_wStarts[s], 0, c_wSteps[n]);
+        }
+    }
+
+    /* periodic timers, only where the loop gets to every expiry, i.e. the
+     * step is no longer than the shortest period
+     */
+    for (uint_fast8_t s = 0; s < dimof(c_wStarts); s++) {
+        __host_run(c_wStarts[s], 1, 1);
+        __host_run(c_wStarts[s], 1, 0);
+    }
+
+    __host_test_restart_in_handler();
+
+    if (s_nFailures) {
+        printf("%d check(s) failed\r\n", s_nFailures);
+        return 1;
+    }
+
+    printf("all checks passed\r\n");
+    return 0;
+}
@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Convert a sprite sheet, e.g. the JPEG of the rickrolling scene, into the
+1bpp film played by platform/mono_film.c. The frames are dithered on the
+host with the table of the EPD driver, and stored as key frames or XOR
+deltas of the previous frame, both run-length encoded.
+
+    python film_pack.py Rickrolling75.jpg --frame-size 100x108 --frames 62 \\
+        --period 16 --uf2 film.uf2
+
+Pillow is required to read the sprite sheet.
+"""
+
+import argparse
+import struct
+import sys
+
+from playlist_pack import to_uf2
+
+# keep in sync with platform/mono_film.h
+BLOB_MAGIC = 0x314D4C46                 # "FLM1"
+FRAME_KEY = 0
+FRAME_DELTA = 1
+
+# the screen of the badger in landscape, the scene centres the film on it
+DEFAULT_SCREEN_SIZE = "296x128"
+
+# keep in sync with __PLATFORM_CFG_MONO_FILM_xxxx__ in platform_cfg.h
+DEFAULT_ADDRESS = 0x10150000
+DEFAULT_REGION_SIZE = 0x20000
+
+# the ordered dithering table of platform/epd_driver.c, 1 is white
+DITHER_TABLE = [
+    [[0, 0, 0, 0], [0, 0, 0, 0], [0, 0, 0, 0], [0, 0, 0, 0]],
+    [[0, 0, 0, 0], [0, 1, 0, 0], [0, 0, 0, 0], [0, 0, 0, 0]],
+    [[0, 0, 0, 0], [0, 1, 0, 0], [0, 0, 0, 0], [0, 0, 0, 1]],
+    [[0, 0, 0, 0], [0, 1, 0, 1], [0, 0, 0, 0], [0, 0, 0, 1]],
+    [[0, 0, 0, 0], [0, 1, 0, 1], [0, 0, 0, 0], [0, 1, 0, 1]],
+    [[0, 0, 0, 0], [0, 1, 0, 1], [0, 0, 1, 0], [0, 1, 0, 1]],
+    [[1, 0, 0, 0], [0, 1, 0, 1], [0, 0, 1, 0], [0, 1, 0, 1]],
+    [[1, 0, 1, 0], [0, 1, 0, 1], [0, 0, 1, 0], [0, 1, 0, 1]],
+    [[1, 0, 1, 0], [0, 1, 0, 1], [1, 0, 1, 0], [0, 1, 0, 1]],
+    [[1, 1, 1, 0], [0, 1, 0, 1], [1, 0, 1, 0], [0, 1, 0, 1]],
+    [[1, 1, 1, 0], [0, 1, 0, 1], [1, 0, 1, 1], [0, 1, 0, 1]],
+    [[1, 1, 1, 1], [0, 1, 0, 1], [1, 0, 1, 1], [0, 1, 0, 1]],
+    [[1, 1, 1, 1], [0, 1, 0, 1], [1, 1, 1, 1], [0, 1, 0, 1]],
+    [[1, 1, 1, 1], [1, 1, 0, 1], [1, 1, 1, 1], [0, 1, 0, 1]],
+    [[1, 1, 1, 1], [1, 1, 0, 1], [1, 1, 1, 1], [0, 1, 1, 1]],
+    [[1, 1, 1, 1], [1, 1, 1, 1], [1, 1, 1, 1], [1, 1, 1, 1]],
+]
+
+
+def pack_frame(pixels, width, height, dither, origin=(0, 0)):
+    """pack GRAY8 pixels (row-major) into the 1bpp format of arm-2d, i.e.
+    byte aligned rows with the leftmost pixel in the least significant bit,
+    a set bit is black. This is the tile format drawn by the scene, not the
+    byte order of the panel.
+
+    The dithering table is indexed the way the EPD driver indexes it, so the
+    pattern matches the dithered JPEG. The driver looks up
+    table[gray >> 4][i & 3][j & 3] for the pixel (x, y) of a PFB, where
+    i = PFB width - 1 - x and j = y. The PFBs start at multiples of 8 in x
+    and have a width of a multiple of 8, and their heights are multiples of
+    4, so only the position of the pixel on the screen matters. origin is
+    the position of the frame on the screen."""
+    stride = (width + 7) // 8
+    out = bytearray(stride * height)
+    origin_x, origin_y = origin
+    for y in range(height):
+        for x in range(width):
+            gray = pixels[y * width + x]
+            if dither:
+                i = (-1 - (origin_x + x)) & 3
+                j = (origin_y + y) & 3
+                white = DITHER_TABLE[gray >> 4][i][j]
+            else:
+                white = gray >= 0x80
+            if not white:
+                out[y * stride + (x >> 3)] |= 1 << (x & 7)
+    return bytes(out)
+
+
+def rle_encode(data):
+    """N < 0x80: N + 1 literal bytes follow, N >= 0x80: the next byte is
+    repeated N - 0x7F times"""
+    out = bytearray()
+    literal = bytearray()
+
+    def flush_literal():
+        for n in range(0, len(literal), 128):
+            chunk = literal[n:n + 128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        literal.clear()
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        # a run of 2 only pays off next to another run
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(0x7F + run)
+            out.append(data[i])
+        else:
+            literal.extend(data[i:i + run])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def rle_decode(data, previous, delta):
+    """the reference decoder, the same as platform/mono_film.c"""
+    out = bytearray(previous) if delta else bytearray()
+    pos = 0
+    i = 0
+    while i < len(data):
+        control = data[i]
+        i += 1
+        if control < 0x80:
+            chunk = data[i:i + control + 1]
+            i += control + 1
+        else:
+            chunk = bytes([data[i]]) * (control - 0x7F)
+            i += 1
+        if delta:
+            for n, value in enumerate(chunk):
+                out[pos + n] ^= value
+        else:
+            out.extend(chunk)
+        pos += len(chunk)
+    return bytes(out)
+
+
+def pack_film(frames, width, height, period, key_interval):
+    """frames are packed 1bpp frames of the same size"""
+    body = bytearray()
+    previous = None
+    key_count = 0
+    for index, frame in enumerate(frames):
+        key = rle_encode(frame)
+        chosen, kind = key, FRAME_KEY
+        if previous is not None and not (key_interval and index % key_interval == 0):
+            delta = rle_encode(bytes(a ^ b for a, b in zip(frame, previous)))
+            if len(delta) < len(key):
+                chosen, kind = delta, FRAME_DELTA
+        if kind == FRAME_KEY:
+            key_count += 1
+
+        assert rle_decode(chosen, previous, kind == FRAME_DELTA) == frame
+        if len(chosen) > 0xFFFF:
+            raise ValueError("frame %d is too large to encode" % index)
+
+        body += struct.pack("<HBB", len(chosen), kind, 0)
+        body += chosen
+        body += b"\0" * (-len(chosen) % 4)
+        previous = frame
+
+    header = struct.pack("<IIHHHH", BLOB_MAGIC, len(body),
+                         width, height, len(frames), period)
+    return header + bytes(body), key_count
+
+
+def load_sprite_sheet(path, width, height, columns, count):
+    """cut the sprite sheet into GRAY8 frames, row by row"""
+    try:
+        from PIL import Image
+    except ImportError:
+        raise RuntimeError("Pillow is required, e.g. pip install pillow")
+
+    image = Image.open(path).convert("L")
+    if count is None:
+        count = columns * (image.height // height)
+
+    frames = []
+    for index in range(count):
+        x = (index % columns) * width
+        y = (index // columns) * height
+        if x + width > image.width or y + height > image.height:
+            raise ValueError("frame %d is outside the sprite sheet" % index)
+        frames.append(list(image.crop((x, y, x + width, y + height)).getdata()))
+    return frames
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="the sprite sheet")
+    parser.add_argument("--frame-size", required=True,
+                        help="the size of a frame, e.g. 100x108")
+    parser.add_argument("--columns", type=int, default=1,
+                        help="the number of frames in a row of the sprite sheet")
+    parser.add_argument("--frames", type=int,
+                        help="the number of frames (default: all)")
+    parser.add_argument("--period", type=int, default=16,
+                        help="the period of a frame in ms (default 16)")
+    parser.add_argument("--threshold", action="store_true",
+                        help="threshold the frames instead of dithering them")
+    parser.add_argument("--screen-size", default=DEFAULT_SCREEN_SIZE,
+                        help="the size of the screen, the film is centred on it "
+                             "(default %s)" % DEFAULT_SCREEN_SIZE)
+    parser.add_argument("--origin",
+                        help="the position of the film on the screen, e.g. "
+                             "98,10 (default: centred)")
+    parser.add_argument("--key-interval", type=int, default=0,
+                        help="force a key frame every N frames (default: "
+                             "only when it is smaller than the delta)")
+    parser.add_argument("-o", "--output", help="write the raw blob")
+    parser.add_argument("--uf2", help="write the blob as a UF2 file")
+    parser.add_argument("--address", type=lambda x: int(x, 0),
+                        default=DEFAULT_ADDRESS,
+                        help="the flash address of the blob (default 0x%08X)"
+                             % DEFAULT_ADDRESS)
+    parser.add_argument("--region-size", type=lambda x: int(x, 0),
+                        default=DEFAULT_REGION_SIZE,
+                        help="the size of the reserved flash region (default 0x%X)"
+                             % DEFAULT_REGION_SIZE)
+    args = parser.parse_args()
+
+    if not args.output and not args.uf2:
+        parser.error("please specify --output and/or --uf2")
+
+    try:
+        width, height = (int(v) for v in args.frame_size.lower().split("x"))
+    except ValueError:
+        parser.error("invalid frame size: %s" % args.frame_size)
+
+    try:
+        if args.origin:
+            origin = tuple(int(v) for v in args.origin.split(","))
+        else:
+            screen_width, screen_height = (int(v) for v in
+                                           args.screen_size.lower().split("x"))
+            origin = ((screen_width - width) // 2, (screen_height - height) // 2)
+        if len(origin) != 2:
+            raise ValueError
+    except ValueError:
+        parser.error("invalid origin or screen size")
+
+    try:
+        frames = load_sprite_sheet(args.input, width, height,
+                                   args.columns, args.frames)
+        packed = [pack_frame(f, width, height, not args.threshold, origin)
+                  for f in frames]
+        blob, key_count = pack_film(packed, width, height,
+                                    args.period, args.key_interval)
+    except (RuntimeError, ValueError, OSError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    if len(blob) > args.region_size:
+        print("error: the film (%d bytes) does not fit into the region (%d bytes)"
+              % (len(blob), args.region_size), file=sys.stderr)
+        return 1
+
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(blob)
+    if args.uf2:
+        with open(args.uf2, "wb") as f:
+            f.write(to_uf2(blob, args.address))
+
+    print("%d frames (%d key frames), %d bytes at 0x%08X"
+          % (len(frames), key_count, len(blob), args.address))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Pack a scene playlist described in JSON into the blob parsed by
+platform/playlist.c at boot.
+
+    {
+        "scenes": [
+            {"scene": "mono_loading", "duration": 15000, "invert": true},
+            {"scene": "qrcode", "duration": 5000, "payload": "https://..."},
+            {"scene": "text_reader", "duration": 30000, "text_file": "a.txt"},
+            {"scene": "rickrolling", "duration": 20000, "dither": true}
+        ]
+    }
+
+A duration of 0 (or no duration) keeps the scene forever. The blob can be
+written as a raw binary or as a UF2 file which is placed at the flash region
+reserved for the playlist, i.e. it can be dragged onto the RP2040 bootloader
+drive without touching the firmware.
+
+    python playlist_pack.py playlist.json -o playlist.bin
+    python playlist_pack.py playlist.json --uf2 playlist.uf2
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+import zlib
+
+# keep in sync with platform/playlist.h
+BLOB_MAGIC = 0x314C5042                 # "BPL1"
+BLOB_VERSION = 1
+
+FLAG_INVERT_COLOUR = 1 << 0
+FLAG_DITHER = 1 << 1
+
+# keep in sync with playlist_scene_id_t in platform/playlist.h
+SCENES = {
+    "mono_loading":         0,
+    "qrcode":               1,
+    "mono_clock":           2,
+    "mono_histogram":       3,
+    "progress_status":      4,
+    "mono_list":            5,
+    "mono_tracking_list":   6,
+    "mono_icon_menu":       7,
+    "text_reader":          8,
+    "rickrolling":          9,
+}
+
+# keep in sync with __PLATFORM_CFG_FLASH_PLAYLIST_xxxx__ in platform_cfg.h
+DEFAULT_ADDRESS = 0x101F0000
+DEFAULT_REGION_SIZE = 0x10000
+DEFAULT_MAX_ENTRIES = 32                # __PLATFORM_CFG_PLAYLIST_MAX_ENTRIES__
+
+UF2_MAGIC_START0 = 0x0A324655
+UF2_MAGIC_START1 = 0x9E5D5157
+UF2_MAGIC_END = 0x0AB16F30
+UF2_FLAG_FAMILY_ID_PRESENT = 0x00002000
+UF2_FAMILY_RP2040 = 0xE48BFF56
+UF2_PAYLOAD_SIZE = 256
+
+
+def read_param(item, base_dir):
+    """return the parameter of an entry as bytes (NUL terminated strings)"""
+    text = None
+    if "payload" in item:
+        text = item["payload"]
+    elif "text" in item:
+        text = item["text"]
+    elif "text_file" in item:
+        path = os.path.join(base_dir, item["text_file"])
+        with open(path, "r", encoding="utf-8") as f:
+            text = f.read()
+
+    if text is None:
+        return b""
+
+    return text.encode("utf-8") + b"\0"
+
+
+def pack_entry(index, item, base_dir):
+    name = item.get("scene")
+    if name not in SCENES:
+        raise ValueError("entry %d: unknown scene %r, expected one of %s"
+                         % (index, name, ", ".join(SCENES)))
+
+    duration = int(item.get("duration", 0))
+    if not 0 <= duration <= 0x7FFFFFFF:
+        raise ValueError("entry %d: invalid duration %d" % (index, duration))
+
+    flags = 0
+    if item.get("invert", False):
+        flags |= FLAG_INVERT_COLOUR
+    if item.get("dither", False):
+        flags |= FLAG_DITHER
+
+    param = read_param(item, base_dir)
+    if len(param) > 0xFFFF:
+        raise ValueError("entry %d: the parameter is too big (%d bytes)"
+                         % (index, len(param)))
+
+    entry = struct.pack("<BBHI", SCENES[name], flags, len(param), duration)
+    entry += param
+    entry += b"\0" * (-len(entry) % 4)
+    return entry
+
+
+def pack_playlist(config, base_dir):
+    scenes = config.get("scenes", [])
+    if not scenes:
+        raise ValueError("the playlist is empty")
+
+    body = b"".join(pack_entry(n, item, base_dir)
+                    for n, item in enumerate(scenes))
+    header = struct.pack("<IHHII",
+                         BLOB_MAGIC,
+                         BLOB_VERSION,
+                         len(scenes),
+                         16 + len(body),
+                         zlib.crc32(body) & 0xFFFFFFFF)
+    return header + body
+
+
+def to_uf2(blob, address):
+    """wrap the blob into UF2 blocks targeting the given flash address"""
+    blocks = [blob[n:n + UF2_PAYLOAD_SIZE]
+              for n in range(0, len(blob), UF2_PAYLOAD_SIZE)]
+    out = bytearray()
+    for n, data in enumerate(blocks):
+        data = data + b"\0" * (476 - len(data))
+        out += struct.pack("<IIIIIIII",
+                           UF2_MAGIC_START0,
+                           UF2_MAGIC_START1,
+                           UF2_FLAG_FAMILY_ID_PRESENT,
+                           address + n * UF2_PAYLOAD_SIZE,
+                           UF2_PAYLOAD_SIZE,
+                           n,
+                           len(blocks),
+                           UF2_FAMILY_RP2040)
+        out += data
+        out += struct.pack("<I", UF2_MAGIC_END)
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="the playlist in JSON")
+    parser.add_argument("-o", "--output", help="write the raw blob")
+    parser.add_argument("--uf2", help="write the blob as a UF2 file")
+    parser.add_argument("--address", type=lambda x: int(x, 0),
+                        default=DEFAULT_ADDRESS,
+                        help="the flash address of the blob (default 0x%08X)"
+                             % DEFAULT_ADDRESS)
+    parser.add_argument("--region-size", type=lambda x: int(x, 0),
+                        default=DEFAULT_REGION_SIZE,
+                        help="the size of the reserved flash region (default 0x%X)"
+                             % DEFAULT_REGION_SIZE)
+    parser.add_argument("--max-entries", type=int,
+                        default=DEFAULT_MAX_ENTRIES,
+                        help="the number of entries the firmware accepts (default %d)"
+                             % DEFAULT_MAX_ENTRIES)
+    args = parser.parse_args()
+
+    if not args.output and not args.uf2:
+        parser.error("please specify --output and/or --uf2")
+
+    with open(args.input, "r", encoding="utf-8") as f:
+        config = json.load(f)
+
+    try:
+        blob = pack_playlist(config, os.path.dirname(os.path.abspath(args.input)))
+    except (ValueError, OSError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    if len(blob) > args.region_size:
+        print("error: the blob (%d bytes) does not fit into the region (%d bytes)"
+              % (len(blob), args.region_size), file=sys.stderr)
+        return 1
+
+    # the firmware rejects the whole blob and falls back to the built-in list
+    entry_count = len(config.get("scenes", []))
+    if entry_count > args.max_entries:
+        print("error: the playlist has %d entries, the firmware accepts %d"
+              % (entry_count, args.max_entries), file=sys.stderr)
+        return 1
+
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(blob)
+    if args.uf2:
+        with open(args.uf2, "wb") as f:
+            f.write(to_uf2(blob, args.address))
+
+    print("%d entries, %d bytes at 0x%08X"
+          % (len(config["scenes"]), len(blob), args.address))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Compare the frame probe reports of several builds, e.g. AC6-flash with and
+without __PLATFORM_CFG_USE_TIME_CRITICAL_SECTION__ and AC6-DebugInSRAM, and
+print a markdown table of the average frame time of each scene.
+
+The inputs are captured stdio logs with __PLATFORM_CFG_USE_FRAME_PROBE__
+enabled. When a scene is reported several times in one log, the reports are
+averaged by frames. With --contested, the table shows the contested SRAM
+accesses per frame instead, which are reported when
+__PLATFORM_CFG_FRAME_PROBE_BUS_CONTENTION__ is enabled.
+
+    python probe2table.py flash.log flash_sram.log sram.log
+    python probe2table.py --label xip=flash.log --label sram=sram.log
+    python probe2table.py --contested striped.log banked.log
+"""
+
+import argparse
+import re
+import sys
+
+RE_SCENE = re.compile(
+    r"\[frame probe\] scene (\d+): (\d+) frames, (-?\d+)us per frame"
+    r"(?: \(code: ([^)]+)\))?")
+RE_CONTESTED = re.compile(
+    r"contested sram0:(\d+) sram1:(\d+) sram2:(\d+) sram3:(\d+) per frame")
+
+
+def parse_log(path, contested=False):
+    """return ({scene: (frames, total)}, placement)"""
+    scenes = {}
+    placement = None
+    scene = frames = None
+
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            m = RE_SCENE.search(line)
+            if m is not None:
+                scene, frames, per_frame = (int(x) for x in m.group(1, 2, 3))
+                placement = m.group(4) or placement
+                if contested:
+                    continue
+            elif contested and scene is not None:
+                m = RE_CONTESTED.search(line)
+                if m is None:
+                    continue
+                per_frame = sum(int(x) for x in m.groups())
+            else:
+                continue
+
+            total_frames, total = scenes.get(scene, (0, 0))
+            scenes[scene] = (total_frames + frames,
+                             total + frames * per_frame)
+
+    return scenes, placement
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    parser.add_argument("logs", nargs="*", help="captured stdio logs")
+    parser.add_argument("--label", action="append", default=[],
+                        metavar="NAME=LOG", help="a log with a column name")
+    parser.add_argument("--contested", action="store_true",
+                        help="compare the contested SRAM accesses per frame")
+    args = parser.parse_args()
+
+    columns = [(None, path) for path in args.logs]
+    for item in args.label:
+        name, _, path = item.partition("=")
+        if not path:
+            parser.error("--label expects NAME=LOG")
+        columns.append((name, path))
+
+    if not columns:
+        parser.error("no input log")
+
+    results = []
+    for name, path in columns:
+        scenes, placement = parse_log(path, args.contested)
+        results.append((name or placement or path, scenes))
+
+    all_scenes = sorted(set().union(*(scenes for _, scenes in results)))
+    if not all_scenes:
+        sys.exit("no frame probe report found")
+
+    print("| scene | " + " | ".join(name for name, _ in results) + " |")
+    print("|------:|" + "|".join("-" * (len(name) + 2) for name, _ in results) + "|")
+
+    for scene in all_scenes:
+        cells = []
+        for _, scenes in results:
+            frames, total = scenes.get(scene, (0, 0))
+            if not frames:
+                cells.append("-")
+            elif args.contested:
+                cells.append("%d" % (total // frames))
+            else:
+                cells.append("%dus" % (total // frames))
+        print("| %d | " % scene + " | ".join(cells) + " |")
+
+
+if __name__ == "__main__":
+    main()
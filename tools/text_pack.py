@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Pack a UTF-8 text file into the document read by platform/flash_text.c,
+i.e. the text shown by the text reader when the playlist gives it no text.
+
+    python text_pack.py book.txt -o book.bin
+    python text_pack.py book.txt --uf2 book.uf2
+"""
+
+import argparse
+import struct
+import sys
+
+from playlist_pack import to_uf2
+
+# keep in sync with platform/flash_text.h
+BLOB_MAGIC = 0x31585442                 # "BTX1"
+
+# keep in sync with __PLATFORM_CFG_FLASH_TEXT_xxxx__ in platform_cfg.h
+DEFAULT_ADDRESS = 0x10170000
+DEFAULT_REGION_SIZE = 0x80000
+
+
+def pack_text(text):
+    # the firmware skips '\r', a '\0' would end the text early
+    body = text.replace("\0", "").encode("utf-8") + b"\0"
+    return struct.pack("<II", BLOB_MAGIC, len(body)) + body
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="the text file in UTF-8")
+    parser.add_argument("-o", "--output", help="write the raw blob")
+    parser.add_argument("--uf2", help="write the blob as a UF2 file")
+    parser.add_argument("--address", type=lambda x: int(x, 0),
+                        default=DEFAULT_ADDRESS,
+                        help="the flash address of the blob (default 0x%08X)"
+                             % DEFAULT_ADDRESS)
+    parser.add_argument("--region-size", type=lambda x: int(x, 0),
+                        default=DEFAULT_REGION_SIZE,
+                        help="the size of the reserved flash region (default 0x%X)"
+                             % DEFAULT_REGION_SIZE)
+    args = parser.parse_args()
+
+    if not args.output and not args.uf2:
+        parser.error("please specify --output and/or --uf2")
+
+    try:
+        with open(args.input, "r", encoding="utf-8") as f:
+            blob = pack_text(f.read())
+    except (UnicodeDecodeError, OSError) as e:
+        print("error: %s" % e, file=sys.stderr)
+        return 1
+
+    if len(blob) > args.region_size:
+        print("error: the document (%d bytes) does not fit into the region (%d bytes)"
+              % (len(blob), args.region_size), file=sys.stderr)
+        return 1
+
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(blob)
+    if args.uf2:
+        with open(args.uf2, "wb") as f:
+            f.write(to_uf2(blob, args.address))
+
+    print("%d bytes at 0x%08X" % (len(blob), args.address))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright 2025 Gorgon Meducer (Email:embedded_zhuoran@hotmail.com)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#    http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Convert the frame trace dumped by platform/frame_trace.c into the Chrome
+trace event format, which can be opened in chrome://tracing or Perfetto.
+
+The input is a captured stdio log (UART or USB CDC). Any text outside the
+#TRACE-BEGIN/#TRACE-END markers is ignored, so the log can be captured as it
+is. Each dump becomes a separate process in the timeline.
+
+    python trace2chrome.py capture.log -o trace.json
+"""
+
+import argparse
+import json
+import re
+import sys
+
+# keep in sync with frame_trace_event_id_t in platform/frame_trace.h
+EVENTS = {
+    0: ("fnOnFrameStart",   "scene"),
+    1: ("fnScene",          "scene"),
+    2: ("fnOnFrameCPL",     "scene"),
+    3: ("PFB band",         "flush"),
+    4: ("SPI burst",        "spi"),
+    5: ("BUSY",             "panel"),
+    6: ("scene switch",     "scene"),
+}
+
+LANES = {
+    "scene":    1,
+    "flush":    2,
+    "spi":      3,
+    "panel":    4,
+}
+
+RE_BEGIN = re.compile(r"#TRACE-BEGIN\s+freq=(\d+)\s+count=(\d+)")
+RE_RECORD = re.compile(r"^([0-9a-fA-F]{16})$")
+
+
+def parse_dumps(lines):
+    """yield (frequency, [(timestamp, event, phase, arg), ...]) per dump"""
+    freq = None
+    records = None
+
+    for line in lines:
+        line = line.strip()
+
+        match = RE_BEGIN.search(line)
+        if match:
+            freq = int(match.group(1))
+            records = []
+            continue
+
+        if records is None:
+            continue
+
+        if line.startswith("#TRACE-END"):
+            yield freq, records
+            records = None
+            continue
+
+        match = RE_RECORD.match(line)
+        if not match:
+            # a corrupted line or interleaved printf output
+            continue
+
+        raw = match.group(1)
+        records.append((int(raw[0:8], 16),
+                        int(raw[8:10], 16),
+                        chr(int(raw[10:12], 16)),
+                        int(raw[12:16], 16)))
+
+
+def convert(dumps):
+    trace = []
+
+    for pid, (freq, records) in enumerate(dumps):
+        trace.append({"name": "process_name", "ph": "M", "pid": pid,
+                      "args": {"name": "dump %d" % pid}})
+        for lane, tid in LANES.items():
+            trace.append({"name": "thread_name", "ph": "M", "pid": pid,
+                          "tid": tid, "args": {"name": lane}})
+
+        if not records:
+            continue
+
+        # unwrap the 32bit cycle counter
+        base = records[0][0]
+        wraps = 0
+        last = base
+        for timestamp, event, phase, arg in records:
+            if timestamp < last:
+                wraps += 1
+            last = timestamp
+            ticks = (wraps << 32) + timestamp - base
+
+            name, lane = EVENTS.get(event, ("event %d" % event, "scene"))
+            item = {
+                "name": name,
+                "cat": lane,
+                "ph": phase,
+                "ts": ticks * 1000000.0 / freq,
+                "pid": pid,
+                "tid": LANES[lane],
+                "args": {"arg": arg},
+            }
+            if phase == "i":
+                item["s"] = "p"
+            trace.append(item)
+
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="convert a frame trace dump into Chrome trace JSON")
+    parser.add_argument("input", help="captured stdio log, '-' for stdin")
+    parser.add_argument("-o", "--output", default="-",
+                        help="output json file, '-' for stdout")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        dumps = list(parse_dumps(sys.stdin))
+    else:
+        with open(args.input, "r", errors="replace") as f:
+            dumps = list(parse_dumps(f))
+
+    if not dumps:
+        sys.stderr.write("no trace dump found\n")
+        return 1
+
+    result = convert(dumps)
+
+    if args.output == "-":
+        json.dump(result, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(result, f)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())